@@ -0,0 +1,128 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+
+#include "workload.hpp"
+
+using namespace std;
+using namespace bhxx;
+
+namespace bohrium {
+namespace bench {
+
+namespace {
+
+/* Black-Scholes pricing of European call options with random stock prices, strike prices, and maturities. Every
+ * step prices all options and reduces the prices to their mean, like the classic Bohrium benchmark.
+ */
+class BlackScholes : public Workload {
+    const uint64_t n;
+    BhArray<double> stock, strike, years, mean;
+    static constexpr double rate = 0.08;
+    static constexpr double volatility = 0.3;
+
+    // Write the cumulative normal distribution of `x` into `out` (Abramowitz and Stegun, 26.2.17)
+    void cnd(BhArray<double> &out, const BhArray<double> &x) {
+        const double a1 = 0.31938153, a2 = -0.356563782, a3 = 1.781477937, a4 = -1.821255978, a5 = 1.330274429;
+        BhArray<double> l({n}), k({n}), poly({n}), w({n});
+        absolute(l, x);
+        multiply(k, l, 0.2316419);
+        add(k, k, 1.0);
+        divide(k, 1.0, k);
+        // Horner's method
+        multiply(poly, k, a5);
+        add(poly, poly, a4);
+        multiply(poly, poly, k);
+        add(poly, poly, a3);
+        multiply(poly, poly, k);
+        add(poly, poly, a2);
+        multiply(poly, poly, k);
+        add(poly, poly, a1);
+        multiply(poly, poly, k);
+        // w = 1 - exp(-l^2 / 2) / sqrt(2 pi) * poly
+        multiply(w, l, l);
+        multiply(w, w, -0.5);
+        exp(w, w);
+        multiply(w, w, poly);
+        multiply(w, w, -1.0 / std::sqrt(2 * M_PI));
+        add(w, w, 1.0);
+        // out = x < 0 ? 1 - w : w
+        BhArray<bool> negative({n});
+        bhxx::less(negative, x, 0.0);
+        BhArray<double> mask({n});
+        identity(mask, negative);
+        multiply(out, w, -2.0);
+        add(out, out, 1.0);
+        multiply(out, out, mask);
+        add(out, out, w);
+    }
+
+public:
+    explicit BlackScholes(uint64_t n) : n(n), stock({n}), strike({n}), years({n}), mean({1}) {
+        uniform(stock, 1, 58, 62);
+        uniform(strike, 2, 60, 70);
+        uniform(years, 3, 0.25, 2);
+    }
+
+    uint64_t elementsPerStep() const override {
+        return n;
+    }
+
+    void step() override {
+        // d1 = (log(S / X) + (r + v^2 / 2) * T) / (v * sqrt(T)) and d2 = d1 - v * sqrt(T)
+        BhArray<double> vsqrt_t({n}), d1({n}), d2({n}), tmp({n});
+        sqrt(vsqrt_t, years);
+        multiply(vsqrt_t, vsqrt_t, volatility);
+        divide(d1, stock, strike);
+        log(d1, d1);
+        multiply(tmp, years, rate + volatility * volatility / 2);
+        add(d1, d1, tmp);
+        divide(d1, d1, vsqrt_t);
+        subtract(d2, d1, vsqrt_t);
+
+        // call = S * cnd(d1) - X * exp(-r * T) * cnd(d2)
+        BhArray<double> cnd1({n}), cnd2({n}), call({n});
+        cnd(cnd1, d1);
+        cnd(cnd2, d2);
+        multiply(call, stock, cnd1);
+        multiply(tmp, years, -rate);
+        exp(tmp, tmp);
+        multiply(tmp, tmp, strike);
+        multiply(tmp, tmp, cnd2);
+        subtract(call, call, tmp);
+
+        add_reduce(mean, call, 0);
+        multiply(mean, mean, 1.0 / n);
+        Runtime::instance().flush();
+    }
+
+    double checksum() override {
+        return sum(mean);
+    }
+};
+}
+
+unique_ptr<Workload> black_scholes(double scale) {
+    return unique_ptr<Workload>(new BlackScholes(scaled(1000000, scale)));
+}
+
+}
+} // namespace bohrium::bench
@@ -0,0 +1,79 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "workload.hpp"
+
+using namespace std;
+using namespace bhxx;
+
+namespace bohrium {
+namespace bench {
+
+namespace {
+
+/* Power iteration of a random sparse matrix in the ELLPACK format (a fixed number of non-zeros per row), thus every
+ * step gathers `nnz` elements of the vector per row. The vector is normalized to a mean of one on the device, thus
+ * the checksum is the sum of the product before the normalization (`n` times the eigenvalue estimate).
+ */
+class Gather : public Workload {
+    const uint64_t n;
+    static constexpr uint64_t nnz = 8;
+    BhArray<uint64_t> cols;
+    BhArray<double> vals, x, y;
+public:
+    explicit Gather(uint64_t n) : n(n), cols({n, nnz}), vals({n, nnz}), x({n}), y({n}) {
+        BhArray<uint64_t> flat(cols.base, {n * nnz});
+        random(flat, 1, 0);
+        mod(flat, flat, n);
+        uniform(vals, 2, 0, 2.0 / nnz);
+        identity(x, 1.0);
+        identity(y, 0.0);
+    }
+
+    uint64_t elementsPerStep() const override {
+        return n * nnz;
+    }
+
+    void step() override {
+        BhArray<double> gathered({n, nnz});
+        bhxx::gather(gathered, x, cols);
+        multiply(gathered, gathered, vals);
+        add_reduce(y, gathered, 1);
+
+        // x = y / mean(y), where the mean is broadcasted from a one-element array
+        BhArray<double> mean({1});
+        add_reduce(mean, y, 0);
+        multiply(mean, mean, 1.0 / n);
+        divide(x, y, BhArray<double>(mean.base, {n}, {0}));
+        Runtime::instance().flush();
+    }
+
+    double checksum() override {
+        return sum(y);
+    }
+};
+}
+
+unique_ptr<Workload> gather(double scale) {
+    return unique_ptr<Workload>(new Gather(scaled(1000000, scale)));
+}
+
+}
+} // namespace bohrium::bench
@@ -0,0 +1,356 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include "workload.hpp"
+
+using namespace std;
+using namespace bohrium::bench;
+namespace fs = boost::filesystem;
+
+// End-to-end benchmarks of application workloads through the C++ bridge and whatever stack BH_STACK selects. Each
+// workload runs in its own process, which measures the cold start (the runtime, the setup, and the first step, which
+// includes the JIT compilation of all kernels), the steady-state time per step, and the peak memory usage.
+
+namespace {
+
+typedef unique_ptr<Workload> (*Factory)(double scale);
+
+// The workloads in the order of the report
+const vector<pair<string, Factory> > workloads = {
+        {"jacobi",           jacobi},
+        {"heat",             heat},
+        {"flush_and_repeat", flush_and_repeat},
+        {"black_scholes",    black_scholes},
+        {"nbody",            nbody},
+        {"shallow_water",    shallow_water},
+        {"gather",           gather}
+};
+
+// The engines that have a kernel cache (see `cache_dir` in the config file)
+const vector<string> engines = {"openmp", "opencl", "cuda"};
+
+struct Options {
+    vector<string> names; // The workloads to run (all when empty)
+    uint64_t steps = 10;
+    double scale = 1;
+    bool warm_cache = false;
+    string out;           // The JSON report (none when empty)
+};
+
+struct Result {
+    string name;
+    string error;               // Empty on success
+    uint64_t elements_per_step = 0;
+    double init = 0;            // Seconds to initiate the runtime, i.e. load the stack
+    double cold_start = 0;      // Seconds of the setup and the first step
+    vector<double> steps;       // Seconds per steady-state step
+    double flushes_per_step = 0;
+    double checksum = 0;
+    uint64_t peak_rss = 0;      // Bytes
+};
+
+void usage(const char *prog) {
+    cout << "Usage: " << prog << " [options] [workload...]\n"
+         << "  --steps n     number of steady-state steps (default: 10)\n"
+         << "  --scale x     scale the length of each dimension of the workloads (default: 1)\n"
+         << "  --warm-cache  use the configured kernel cache, which excludes the JIT compilation from the cold start\n"
+         << "  --out file    write the report as JSON to `file`\n"
+         << "  --list        list the workloads\n"
+         << "The default is all workloads." << endl;
+}
+
+double since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Run the workload in this process and write the result to `fd` as a line of space separated fields
+void run_child(const Options &opt, Factory factory, int fd) {
+    stringstream ss;
+    ss << setprecision(17);
+    try {
+        auto start = chrono::steady_clock::now();
+        bhxx::Runtime &runtime = bhxx::Runtime::instance();
+        const double init = since(start);
+
+        start = chrono::steady_clock::now();
+        unique_ptr<Workload> workload = factory(opt.scale);
+        runtime.flush();
+        workload->step();
+        const double cold_start = since(start);
+
+        const uint64_t flushes = runtime.getFlushCount();
+        vector<double> steps;
+        for (uint64_t i = 0; i < opt.steps; ++i) {
+            start = chrono::steady_clock::now();
+            workload->step();
+            steps.push_back(since(start));
+        }
+        const double flushes_per_step = (runtime.getFlushCount() - flushes) / static_cast<double>(opt.steps);
+        ss << "ok " << workload->elementsPerStep() << " " << init << " " << cold_start << " " << flushes_per_step
+           << " " << workload->checksum();
+        for (double t: steps) {
+            ss << " " << t;
+        }
+    } catch (const exception &e) {
+        ss.str("");
+        ss << "error " << e.what();
+    }
+    const string msg = ss.str() + "\n";
+    if (write(fd, msg.data(), msg.size()) != static_cast<ssize_t>(msg.size())) {
+        cerr << "bh_benchmark_bhxx: cannot write the result" << endl;
+    }
+}
+
+// Run the workload in a new process and return its result
+Result run(const Options &opt, const string &name, Factory factory) {
+    Result ret;
+    ret.name = name;
+
+    // An empty kernel cache makes the first step compile all kernels
+    fs::path cache_dir;
+    if (not opt.warm_cache) {
+        cache_dir = fs::temp_directory_path() / fs::unique_path("bh_benchmark_%%%%-%%%%-%%%%");
+        fs::create_directories(cache_dir);
+        for (const string &engine: engines) {
+            setenv(("BH_" + boost::to_upper_copy(engine) + "_CACHE_DIR").c_str(), cache_dir.string().c_str(), 1);
+        }
+    }
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw runtime_error("bh_benchmark_bhxx: pipe() failed");
+    }
+    cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        throw runtime_error("bh_benchmark_bhxx: fork() failed");
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        run_child(opt, factory, fds[1]);
+        close(fds[1]);
+        exit(0); // Runs the destructor of the runtime
+    }
+    close(fds[1]);
+    string line;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0) {
+        line.append(buf, static_cast<size_t>(n));
+    }
+    close(fds[0]);
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    ret.peak_rss = static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+    if (not cache_dir.empty()) {
+        fs::remove_all(cache_dir);
+    }
+
+    stringstream ss(line);
+    string kind;
+    ss >> kind;
+    if (kind == "ok") {
+        ss >> ret.elements_per_step >> ret.init >> ret.cold_start >> ret.flushes_per_step >> ret.checksum;
+        double t;
+        while (ss >> t) {
+            ret.steps.push_back(t);
+        }
+    } else if (kind == "error") {
+        getline(ss >> ws, ret.error);
+    } else if (WIFSIGNALED(status)) {
+        ret.error = string("killed by signal ") + strsignal(WTERMSIG(status));
+    } else {
+        ret.error = "exited without a result";
+    }
+    return ret;
+}
+
+// Returns the median of `values`
+double median(vector<double> values) {
+    if (values.empty()) {
+        return 0;
+    }
+    sort(values.begin(), values.end());
+    const size_t n = values.size();
+    return n % 2 == 1 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// Returns `str` as a quoted JSON string
+string json_string(const string &str) {
+    stringstream ss;
+    ss << '"';
+    for (char c: str) {
+        if (c == '"' or c == '\\') {
+            ss << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            ss << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c) << dec << setfill(' ');
+        } else {
+            ss << c;
+        }
+    }
+    ss << '"';
+    return ss.str();
+}
+
+// Write the report as JSON, which has the layout of the Google Benchmark reports of the micro-benchmarks
+void write_json(ostream &out, const Options &opt, const vector<Result> &results) {
+    char date[64], host[256] = "";
+    const time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+    gethostname(host, sizeof(host) - 1);
+    const char *stack = getenv("BH_STACK");
+
+    out << setprecision(10);
+    out << "{\n"
+        << "  \"context\": {\n"
+        << "    \"date\": " << json_string(date) << ",\n"
+        << "    \"host_name\": " << json_string(host) << ",\n"
+        << "    \"stack\": " << json_string(stack == nullptr ? "default" : stack) << ",\n"
+        << "    \"steps\": " << opt.steps << ",\n"
+        << "    \"scale\": " << opt.scale << ",\n"
+        << "    \"warm_cache\": " << (opt.warm_cache ? "true" : "false") << "\n"
+        << "  },\n"
+        << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\n"
+            << "      \"name\": " << json_string(r.name) << ",\n";
+        if (not r.error.empty()) {
+            out << "      \"error_occurred\": true,\n"
+                << "      \"error_message\": " << json_string(r.error) << "\n"
+                << "    }";
+            continue;
+        }
+        const double step = median(r.steps);
+        out << "      \"elements_per_step\": " << r.elements_per_step << ",\n"
+            << "      \"init_seconds\": " << r.init << ",\n"
+            << "      \"cold_start_seconds\": " << r.cold_start << ",\n"
+            << "      \"step_seconds_median\": " << step << ",\n"
+            << "      \"step_seconds_min\": " << *min_element(r.steps.begin(), r.steps.end()) << ",\n"
+            << "      \"step_seconds_max\": " << *max_element(r.steps.begin(), r.steps.end()) << ",\n"
+            << "      \"elements_per_second\": " << r.elements_per_step / step << ",\n"
+            << "      \"flushes_per_step\": " << r.flushes_per_step << ",\n"
+            << "      \"peak_rss_bytes\": " << r.peak_rss << ",\n"
+            << "      \"checksum\": " << r.checksum << "\n"
+            << "    }";
+    }
+    out << "\n  ]\n}\n";
+}
+}
+
+int main(int argc, char *argv[]) {
+    Options opt;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const string arg = argv[i];
+            if (arg == "-h" or arg == "--help") {
+                usage(argv[0]);
+                return 0;
+            } else if (arg == "--list") {
+                for (const auto &w: workloads) {
+                    cout << w.first << "\n";
+                }
+                return 0;
+            } else if (arg == "--warm-cache") {
+                opt.warm_cache = true;
+            } else if (boost::starts_with(arg, "--")) {
+                if (i + 1 >= argc) {
+                    throw invalid_argument("missing value of " + arg);
+                }
+                const string value = argv[++i];
+                if (arg == "--steps") {
+                    opt.steps = stoull(value);
+                } else if (arg == "--scale") {
+                    opt.scale = stod(value);
+                } else if (arg == "--out") {
+                    opt.out = value;
+                } else {
+                    throw invalid_argument("unknown option " + arg);
+                }
+            } else {
+                const auto it = find_if(workloads.begin(), workloads.end(),
+                                        [&](const pair<string, Factory> &w) { return w.first == arg; });
+                if (it == workloads.end()) {
+                    throw invalid_argument("unknown workload " + arg);
+                }
+                opt.names.push_back(arg);
+            }
+        }
+        if (opt.steps == 0 or opt.scale <= 0) {
+            throw invalid_argument("the steps and the scale must be positive");
+        }
+    } catch (const exception &e) {
+        cerr << "bh_benchmark_bhxx: " << e.what() << endl;
+        usage(argv[0]);
+        return 1;
+    }
+
+    cout << "End-to-end benchmarks: " << opt.steps << " steady-state steps, scale " << opt.scale << ", "
+         << (opt.warm_cache ? "warm" : "empty") << " kernel cache\n\n";
+    cout << left << setw(18) << "workload" << right << setw(10) << "init s" << setw(10) << "cold s"
+         << setw(12) << "step ms" << setw(12) << "Melem/s" << setw(10) << "flushes" << setw(12) << "peak MiB"
+         << setw(18) << "checksum" << endl;
+    bool failed = false;
+    vector<Result> results;
+    for (const auto &w: workloads) {
+        if (not opt.names.empty() and find(opt.names.begin(), opt.names.end(), w.first) == opt.names.end()) {
+            continue;
+        }
+        results.push_back(run(opt, w.first, w.second));
+        const Result &r = results.back();
+        if (not r.error.empty()) {
+            cout << left << setw(18) << r.name << " failed: " << r.error << endl;
+            failed = true;
+            continue;
+        }
+        const double step = median(r.steps);
+        cout << left << setw(18) << r.name << right << fixed << setprecision(3) << setw(10) << r.init
+             << setw(10) << r.cold_start << setw(12) << step * 1e3 << setprecision(1)
+             << setw(12) << r.elements_per_step / step / 1e6 << setw(10) << r.flushes_per_step
+             << setw(12) << r.peak_rss / 1024.0 / 1024.0 << defaultfloat << setprecision(10)
+             << setw(18) << r.checksum << endl;
+    }
+
+    if (not opt.out.empty()) {
+        ofstream file(opt.out);
+        write_json(file, opt, results);
+        if (not file) {
+            cerr << "bh_benchmark_bhxx: cannot write " << opt.out << endl;
+            return 1;
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "workload.hpp"
+
+using namespace std;
+using namespace bhxx;
+
+namespace bohrium {
+namespace bench {
+
+namespace {
+
+/* All-pairs N-body simulation in 3-D, which computes the n x n pairwise accelerations by broadcasting the positions
+ * and reduces them per body.
+ */
+class NBody : public Workload {
+    const uint64_t n;
+    BhArray<double> mass;
+    BhArray<double> pos[3], vel[3];
+    static constexpr double dt = 0.01;
+    static constexpr double softening = 0.01;
+
+    // Returns the view of `ary` (1-D) broadcasted to n x n along `axis`
+    BhArray<double> spread(const BhArray<double> &ary, int64_t axis) {
+        return broadcast(ary, axis, n);
+    }
+
+public:
+    explicit NBody(uint64_t n) : n(n), mass({n}), pos{BhArray<double>({n}), BhArray<double>({n}),
+                                                       BhArray<double>({n})},
+                                 vel{BhArray<double>({n}), BhArray<double>({n}), BhArray<double>({n})} {
+        uniform(mass, 1, 0.5, 1.5);
+        for (int d = 0; d < 3; ++d) {
+            uniform(pos[d], 2 + d, -1, 1);
+            identity(vel[d], 0.0);
+        }
+    }
+
+    uint64_t elementsPerStep() const override {
+        return n * n;
+    }
+
+    void step() override {
+        // diff[d][i, j] = pos[d][j] - pos[d][i] and dist2 = sum(diff^2) + softening
+        BhArray<double> diff[3] = {BhArray<double>({n, n}), BhArray<double>({n, n}), BhArray<double>({n, n})};
+        BhArray<double> dist2({n, n}), tmp({n, n});
+        identity(dist2, softening);
+        for (int d = 0; d < 3; ++d) {
+            subtract(diff[d], spread(pos[d], 0), spread(pos[d], 1));
+            multiply(tmp, diff[d], diff[d]);
+            add(dist2, dist2, tmp);
+        }
+        // weight[i, j] = mass[j] / dist^3
+        BhArray<double> weight({n, n});
+        power(weight, dist2, -1.5);
+        multiply(weight, weight, spread(mass, 0));
+
+        BhArray<double> acc({n});
+        for (int d = 0; d < 3; ++d) {
+            multiply(tmp, diff[d], weight);
+            add_reduce(acc, tmp, 1);
+            multiply(acc, acc, dt);
+            add(vel[d], vel[d], acc);
+            multiply(acc, vel[d], dt);
+            add(pos[d], pos[d], acc);
+        }
+        Runtime::instance().flush();
+    }
+
+    double checksum() override {
+        double ret = 0;
+        for (int d = 0; d < 3; ++d) {
+            ret += sum(pos[d]);
+        }
+        return ret;
+    }
+};
+}
+
+unique_ptr<Workload> nbody(double scale) {
+    return unique_ptr<Workload>(new NBody(scaled(1000, scale)));
+}
+
+}
+} // namespace bohrium::bench
@@ -0,0 +1,168 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "workload.hpp"
+
+using namespace std;
+using namespace bhxx;
+
+namespace bohrium {
+namespace bench {
+
+namespace {
+
+typedef BhArray<double> Array;
+
+/* The shallow water equations solved by the two-step Lax-Wendroff scheme with reflecting boundaries, which is the
+ * classic Bohrium benchmark of a water drop in a (n+2) x (n+2) basin. The half steps in the x and y direction are the
+ * same computation with the roles of the momentums swapped.
+ */
+class ShallowWater : public Workload {
+    const uint64_t n;
+    Array height, mom_x, mom_y;
+    static constexpr double g = 9.80665;
+    static constexpr double dt = 0.02;
+
+    // Returns the flux `u^2 / h + g / 2 * h^2` of the momentum `u` along the direction of the flux
+    static Array flux(const Array &u, const Array &h) {
+        Array ret(u.shape), tmp(u.shape);
+        multiply(ret, u, u);
+        divide(ret, ret, h);
+        multiply(tmp, h, h);
+        multiply(tmp, tmp, g / 2);
+        add(ret, ret, tmp);
+        return ret;
+    }
+
+    // Returns the flux `u * v / h` of the momentum `v` across the direction of the flux
+    static Array cross(const Array &u, const Array &v, const Array &h) {
+        Array ret(u.shape);
+        multiply(ret, u, v);
+        divide(ret, ret, h);
+        return ret;
+    }
+
+    // Write `(a1 + a0) / 2 - dt / 2 * (f1 - f0)`, which is the Lax-Wendroff half step, into `out`
+    static void half_step(Array &out, const Array &a0, const Array &a1, const Array &f0, const Array &f1) {
+        Array tmp(out.shape);
+        add(out, a1, a0);
+        multiply(out, out, 0.5);
+        subtract(tmp, f1, f0);
+        multiply(tmp, tmp, dt / 2);
+        subtract(out, out, tmp);
+    }
+
+    /* The half step between the neighbours `0` and `1` along a direction
+     *
+     * @h,u,v  The height, the momentum along the direction, and the momentum across the direction at the
+     *         neighbours `0` and `1` (pairs of views)
+     * @return The height, the momentum along, and the momentum across at the midpoints
+     */
+    static vector<Array> lax_wendroff(const Array &h0, const Array &h1, const Array &u0, const Array &u1,
+                                      const Array &v0, const Array &v1) {
+        const Shape &shape = h0.shape;
+        vector<Array> ret = {Array(shape), Array(shape), Array(shape)};
+        half_step(ret[0], h0, h1, u0, u1);
+        half_step(ret[1], u0, u1, flux(u0, h0), flux(u1, h1));
+        half_step(ret[2], v0, v1, cross(u0, v0, h0), cross(u1, v1, h1));
+        return ret;
+    }
+
+    // Copy the view `src` into the view `dst`, negated when `negate` is true
+    static void reflect(Array dst, const Array &src, bool negate) {
+        if (negate) {
+            multiply(dst, src, -1.0);
+        } else {
+            identity(dst, src);
+        }
+    }
+
+    // The reflecting boundaries, where the momentum across the boundary is negated
+    void boundaries() {
+        const uint64_t m = n + 2;
+        for (Array *ary: {&height, &mom_x, &mom_y}) {
+            reflect(slice(*ary, {0, 0}, {m, 1}), slice(*ary, {0, 1}, {m, 1}), ary == &mom_y);
+            reflect(slice(*ary, {0, m - 1}, {m, 1}), slice(*ary, {0, m - 2}, {m, 1}), ary == &mom_y);
+            reflect(slice(*ary, {0, 0}, {1, m}), slice(*ary, {1, 0}, {1, m}), ary == &mom_x);
+            reflect(slice(*ary, {m - 1, 0}, {1, m}), slice(*ary, {m - 2, 0}, {1, m}), ary == &mom_x);
+        }
+    }
+
+public:
+    explicit ShallowWater(uint64_t n) : n(n), height({n + 2, n + 2}), mom_x({n + 2, n + 2}), mom_y({n + 2, n + 2}) {
+        identity(height, 1.0);
+        identity(mom_x, 0.0);
+        identity(mom_y, 0.0);
+        // The water drop
+        const uint64_t drop = n / 5;
+        Array splash = slice(height, {drop, drop}, {drop, drop});
+        add(splash, splash, 5.0);
+    }
+
+    uint64_t elementsPerStep() const override {
+        return n * n;
+    }
+
+    void step() override {
+        boundaries();
+
+        // The first half step in the x (first) and y (second) direction
+        const uint64_t m = n + 1;
+        auto xs = [this, m](const Array &ary, uint64_t i) { return slice(ary, {i, 1}, {m, n}); };
+        auto ys = [this, m](const Array &ary, uint64_t j) { return slice(ary, {1, j}, {n, m}); };
+        vector<Array> x = lax_wendroff(xs(height, 0), xs(height, 1), xs(mom_x, 0), xs(mom_x, 1),
+                                       xs(mom_y, 0), xs(mom_y, 1));
+        vector<Array> y = lax_wendroff(ys(height, 0), ys(height, 1), ys(mom_y, 0), ys(mom_y, 1),
+                                       ys(mom_x, 0), ys(mom_x, 1));
+        const Array &hx = x[0], &ux = x[1], &vx = x[2];
+        const Array &hy = y[0], &vy = y[1], &uy = y[2];
+
+        // The second half step, which updates the interior by the fluxes at the midpoints. The midpoints before an
+        // interior point are `at(.., 0, 0)` and the midpoints after are `at(.., 1, 0)` (x) and `at(.., 0, 1)` (y)
+        auto at = [this](const Array &ary, uint64_t i, uint64_t j) { return slice(ary, {i, j}, {n, n}); };
+        Array tmp({n, n}), diff({n, n});
+        auto update = [&](Array &ary, const Array &fx0, const Array &fx1, const Array &fy0, const Array &fy1) {
+            Array interior = slice(ary, {1, 1}, {n, n});
+            subtract(tmp, fx1, fx0);
+            subtract(diff, fy1, fy0);
+            add(tmp, tmp, diff);
+            multiply(tmp, tmp, dt);
+            subtract(interior, interior, tmp);
+        };
+        update(height, at(ux, 0, 0), at(ux, 1, 0), at(vy, 0, 0), at(vy, 0, 1));
+        update(mom_x, flux(at(ux, 0, 0), at(hx, 0, 0)), flux(at(ux, 1, 0), at(hx, 1, 0)),
+               cross(at(vy, 0, 0), at(uy, 0, 0), at(hy, 0, 0)), cross(at(vy, 0, 1), at(uy, 0, 1), at(hy, 0, 1)));
+        update(mom_y, cross(at(ux, 0, 0), at(vx, 0, 0), at(hx, 0, 0)), cross(at(ux, 1, 0), at(vx, 1, 0), at(hx, 1, 0)),
+               flux(at(vy, 0, 0), at(hy, 0, 0)), flux(at(vy, 0, 1), at(hy, 0, 1)));
+        Runtime::instance().flush();
+    }
+
+    double checksum() override {
+        return sum(height);
+    }
+};
+}
+
+unique_ptr<Workload> shallow_water(double scale) {
+    return unique_ptr<Workload>(new ShallowWater(scaled(500, scale)));
+}
+
+}
+} // namespace bohrium::bench
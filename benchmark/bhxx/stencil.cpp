@@ -0,0 +1,175 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "workload.hpp"
+
+using namespace std;
+using namespace bhxx;
+
+// The stencil workloads: a Jacobi solver that checks convergence every step, a 3-D heat equation, and a 2-D
+// diffusion whose time-stepping loop runs within one flush by `Runtime::flushAndRepeat()`
+
+namespace bohrium {
+namespace bench {
+
+namespace {
+
+// Write the mean of the four neighbours of the interior of `grid` (2-D) into `out`
+void five_point(BhArray<double> &out, const BhArray<double> &grid) {
+    const uint64_t n = grid.shape[0] - 2, m = grid.shape[1] - 2;
+    add(out, slice(grid, {0, 1}, {n, m}), slice(grid, {2, 1}, {n, m}));
+    add(out, out, slice(grid, {1, 0}, {n, m}));
+    add(out, out, slice(grid, {1, 2}, {n, m}));
+    multiply(out, out, 0.25);
+}
+
+// A grid of `n` x `n` zeros with a hot top row
+BhArray<double> hot_top_grid(uint64_t n) {
+    BhArray<double> ret({n, n});
+    identity(ret, 0.0);
+    BhArray<double> top = slice(ret, {0, 0}, {1, n});
+    identity(top, 100.0);
+    return ret;
+}
+
+/* Jacobi iteration of the Laplace equation on a grid with a hot top row. Every step computes the largest change,
+ * which the host reads like a convergence check would.
+ */
+class Jacobi : public Workload {
+    const uint64_t n;
+    BhArray<double> grid;
+    double delta = 0; // The largest change of the last step
+public:
+    explicit Jacobi(uint64_t n) : n(n), grid(hot_top_grid(n)) {}
+
+    uint64_t elementsPerStep() const override {
+        return (n - 2) * (n - 2);
+    }
+
+    void step() override {
+        BhArray<double> center = slice(grid, {1, 1}, {n - 2, n - 2});
+        BhArray<double> next({n - 2, n - 2});
+        five_point(next, grid);
+        BhArray<double> diff({n - 2, n - 2});
+        subtract(diff, next, center);
+        absolute(diff, diff);
+        identity(center, next);
+        BhArray<double> largest({n - 2});
+        maximum_reduce(largest, diff, 1);
+        BhArray<double> ret({1});
+        maximum_reduce(ret, largest, 0);
+        delta = as_scalar(ret);
+    }
+
+    double checksum() override {
+        return sum(grid);
+    }
+};
+
+/* Explicit time stepping of the 3-D heat equation (7-point stencil), which ping-pongs between two grids with a hot
+ * bottom layer.
+ */
+class Heat : public Workload {
+    const uint64_t n;
+    BhArray<double> cur, next;
+    static constexpr double alpha = 0.1;
+
+    static BhArray<double> grid(uint64_t n) {
+        BhArray<double> ret({n, n, n});
+        identity(ret, 0.0);
+        BhArray<double> bottom = slice(ret, {0, 0, 0}, {1, n, n});
+        identity(bottom, 100.0);
+        return ret;
+    }
+
+public:
+    explicit Heat(uint64_t n) : n(n), cur(grid(n)), next(grid(n)) {}
+
+    uint64_t elementsPerStep() const override {
+        return (n - 2) * (n - 2) * (n - 2);
+    }
+
+    void step() override {
+        const uint64_t m = n - 2;
+        BhArray<double> center = slice(cur, {1, 1, 1}, {m, m, m});
+        BhArray<double> out = slice(next, {1, 1, 1}, {m, m, m});
+        BhArray<double> laplace({m, m, m});
+        add(laplace, slice(cur, {0, 1, 1}, {m, m, m}), slice(cur, {2, 1, 1}, {m, m, m}));
+        add(laplace, laplace, slice(cur, {1, 0, 1}, {m, m, m}));
+        add(laplace, laplace, slice(cur, {1, 2, 1}, {m, m, m}));
+        add(laplace, laplace, slice(cur, {1, 1, 0}, {m, m, m}));
+        add(laplace, laplace, slice(cur, {1, 1, 2}, {m, m, m}));
+        BhArray<double> tmp({m, m, m});
+        multiply(tmp, center, 6.0);
+        subtract(laplace, laplace, tmp);
+        multiply(laplace, laplace, alpha);
+        add(out, center, laplace);
+        std::swap(cur, next);
+        Runtime::instance().flush();
+    }
+
+    double checksum() override {
+        return sum(cur);
+    }
+};
+
+/* 2-D diffusion where a step is `repeats` time steps, which `Runtime::flushAndRepeat()` runs within one flush.
+ * NB: the loop body may not free any arrays, thus all arrays live as long as the workload.
+ */
+class FlushAndRepeat : public Workload {
+    const uint64_t n;
+    static constexpr uint64_t repeats = 10;
+    BhArray<double> grid, next;
+public:
+    explicit FlushAndRepeat(uint64_t n) : n(n), grid(hot_top_grid(n)), next({n - 2, n - 2}) {}
+
+    uint64_t elementsPerStep() const override {
+        return (n - 2) * (n - 2) * repeats;
+    }
+
+    void step() override {
+        BhArray<double> center = slice(grid, {1, 1}, {n - 2, n - 2});
+        five_point(next, grid);
+        add(next, next, center);
+        multiply(next, next, 0.5);
+        identity(center, next);
+        Runtime::instance().flushAndRepeat(repeats, nullptr);
+    }
+
+    double checksum() override {
+        return sum(grid);
+    }
+};
+}
+
+unique_ptr<Workload> jacobi(double scale) {
+    return unique_ptr<Workload>(new Jacobi(scaled(1000, scale)));
+}
+
+unique_ptr<Workload> heat(double scale) {
+    return unique_ptr<Workload>(new Heat(scaled(100, scale)));
+}
+
+unique_ptr<Workload> flush_and_repeat(double scale) {
+    return unique_ptr<Workload>(new FlushAndRepeat(scaled(1000, scale)));
+}
+
+}
+} // namespace bohrium::bench
@@ -0,0 +1,50 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+
+#include "workload.hpp"
+
+using namespace std;
+using namespace bhxx;
+
+namespace bohrium {
+namespace bench {
+
+uint64_t scaled(uint64_t length, double scale, uint64_t minimum) {
+    return max(minimum, static_cast<uint64_t>(llround(length * scale)));
+}
+
+void uniform(BhArray<double> &out, uint64_t seed, double low, double high) {
+    const uint64_t nelem = out.numberOfElements();
+    BhArray<uint64_t> bits({nelem});
+    random(bits, seed, 0);
+    BhArray<double> flat(out.base, {nelem});
+    identity(flat, bits);
+    multiply(flat, flat, (high - low) / 18446744073709551616.0); // Divide by 2^64
+    add(flat, flat, low);
+}
+
+double sum(const BhArray<double> &ary) {
+    return as_scalar(accumulate(ary));
+}
+
+}
+} // namespace bohrium::bench
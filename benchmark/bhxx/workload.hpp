@@ -0,0 +1,86 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bhxx/bhxx.hpp>
+
+namespace bohrium {
+namespace bench {
+
+/** An application workload of the end-to-end benchmarks. The constructor allocates and initiates the arrays of the
+ * workload and `step()` advances it one time step. The harness flushes after the constructor, thus the instructions
+ * of a step are not mixed with the setup.
+ */
+class Workload {
+public:
+    virtual ~Workload() = default;
+
+    // Number of array elements a step computes, which defines the throughput of the workload
+    virtual uint64_t elementsPerStep() const = 0;
+
+    // Execute one time step, which must end with a flush
+    virtual void step() = 0;
+
+    // A checksum of the state of the workload, which should agree between stacks (up to rounding errors)
+    virtual double checksum() = 0;
+};
+
+// The workloads, which scale the length of each dimension by `scale`
+std::unique_ptr<Workload> jacobi(double scale);
+std::unique_ptr<Workload> heat(double scale);
+std::unique_ptr<Workload> flush_and_repeat(double scale);
+std::unique_ptr<Workload> black_scholes(double scale);
+std::unique_ptr<Workload> nbody(double scale);
+std::unique_ptr<Workload> shallow_water(double scale);
+std::unique_ptr<Workload> gather(double scale);
+
+// Returns `length` scaled by `scale` (at least `minimum`)
+uint64_t scaled(uint64_t length, double scale, uint64_t minimum = 3);
+
+// Fill `out` (contiguous) with uniformly distributed random numbers in [low, high)
+void uniform(bhxx::BhArray<double> &out, uint64_t seed, double low, double high);
+
+// Returns the sum of all elements of `ary` (NB: flushes)
+double sum(const bhxx::BhArray<double> &ary);
+
+/** Returns the view of `ary` that starts at the index `begin` and has the shape `shape`
+ *
+ * @ary    The array to slice
+ * @begin  The index of the first element of the view (one index per dimension)
+ * @shape  The shape of the view
+ * @return The view, which has the same base and stride as `ary`
+ */
+template<typename T>
+bhxx::BhArray<T> slice(const bhxx::BhArray<T> &ary, const std::vector<uint64_t> &begin, bhxx::Shape shape) {
+    assert(begin.size() == ary.rank() and shape.size() == ary.rank());
+    uint64_t offset = ary.offset;
+    for (size_t i = 0; i < begin.size(); ++i) {
+        assert(begin[i] + shape[i] <= ary.shape[i]);
+        offset += begin[i] * ary.stride[i];
+    }
+    return bhxx::BhArray<T>(ary.base, std::move(shape), ary.stride, offset);
+}
+
+}
+} // namespace bohrium::bench
@@ -0,0 +1,106 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+#include <jitk/codegen_cache.hpp>
+#include <jitk/symbol_table.hpp>
+#include <jitk/instruction.hpp>
+#include <jitk/apply_fusion.hpp>
+
+#include "synthetic.hpp"
+
+using namespace std;
+using namespace bohrium;
+using namespace bohrium::bench;
+
+namespace {
+
+// The kernel list of a synthetic program
+struct Kernels {
+    SyntheticProgram program;
+    jitk::Statistics stat;
+    jitk::FuseCache fcache;
+    vector<jitk::LoopB> kernel_list;
+
+    explicit Kernels(const ::benchmark::State &state) : program(synthetic_program(state)), stat(false, config()),
+                                                        fcache(stat) {
+        set<bh_base *> frees;
+        const vector<bh_instruction *> instr_list = jitk::remove_non_computed_system_instr(program.instr_list,
+                                                                                           frees);
+        kernel_list = jitk::get_kernel_list(instr_list, config(), fcache, stat, false, false);
+    }
+};
+
+// The construction of the symbol table of each kernel
+void BM_SymbolTable(::benchmark::State &state) {
+    Kernels kernels(state);
+    for (auto _: state) {
+        for (const jitk::LoopB &kernel: kernels.kernel_list) {
+            const jitk::SymbolTable symbols(kernel, false, true, true, true);
+            ::benchmark::DoNotOptimize(symbols.getNumBaseArrays());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SymbolTable)->Apply(synthetic_args);
+
+// A codegen cache lookup of each kernel that hits
+void BM_CodegenCacheLookup(::benchmark::State &state) {
+    Kernels kernels(state);
+    jitk::CodegenCache cache(kernels.stat);
+    vector<jitk::SymbolTable> symbols;
+    for (const jitk::LoopB &kernel: kernels.kernel_list) {
+        symbols.emplace_back(kernel, false, true, true, true);
+        cache.insert("source", kernel, symbols.back());
+    }
+    for (auto _: state) {
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            auto lookup = cache.lookup(kernels.kernel_list[i], symbols[i]);
+            ::benchmark::DoNotOptimize(lookup);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CodegenCacheLookup)->Apply(synthetic_args);
+
+// The code generation of each element-wise operation
+void BM_WriteOperation(::benchmark::State &state) {
+    SyntheticProgram program = synthetic_program(state);
+    vector<const bh_instruction *> instr_list;
+    for (const bh_instruction &instr: program.instr_list) {
+        if (bh_opcode_is_elementwise(instr.opcode)) {
+            instr_list.push_back(&instr);
+        }
+    }
+    const vector<string> ops = {"a0[i0]", "a1[i0]", "a2[i0]"};
+    for (auto _: state) {
+        stringstream ss;
+        for (const bh_instruction *instr: instr_list) {
+            jitk::write_operation(*instr, ops, ss, false);
+        }
+        ::benchmark::DoNotOptimize(ss);
+    }
+    state.SetItemsProcessed(state.iterations() * instr_list.size());
+}
+BENCHMARK(BM_WriteOperation)->Apply(synthetic_args);
+
+}
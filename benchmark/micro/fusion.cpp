@@ -0,0 +1,82 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+#include <jitk/fuser.hpp>
+#include <jitk/fuser_cache.hpp>
+#include <jitk/graph.hpp>
+#include <jitk/instruction.hpp>
+#include <jitk/apply_fusion.hpp>
+
+#include "synthetic.hpp"
+
+using namespace std;
+using namespace bohrium;
+using namespace bohrium::bench;
+
+namespace {
+
+// A fuse cache lookup that hits
+void BM_FuseCacheGet(::benchmark::State &state) {
+    SyntheticProgram program = synthetic_program(state);
+    set<bh_base *> frees;
+    const vector<bh_instruction *> instr_list = jitk::remove_non_computed_system_instr(program.instr_list, frees);
+    jitk::Statistics stat(false, config());
+    jitk::FuseCache fcache(stat);
+    jitk::get_kernel_list(instr_list, config(), fcache, stat, false, false); // Fills the cache
+    for (auto _: state) {
+        auto block_list = fcache.get(instr_list);
+        ::benchmark::DoNotOptimize(block_list);
+    }
+    state.SetItemsProcessed(state.iterations() * instr_list.size());
+}
+BENCHMARK(BM_FuseCacheGet)->Apply(synthetic_args);
+
+// The greedy fuser on the blocks of the (default) lossy pre-fuser
+void BM_GraphGreedy(::benchmark::State &state) {
+    SyntheticProgram program = synthetic_program(state);
+    set<bh_base *> frees;
+    const vector<bh_instruction *> instr_list = jitk::remove_non_computed_system_instr(program.instr_list, frees);
+    const vector<jitk::Block> block_list = jitk::pre_fuser_lossy(instr_list);
+    for (auto _: state) {
+        jitk::graph::DAG dag = jitk::graph::from_block_list(block_list);
+        jitk::graph::greedy(dag, false);
+        ::benchmark::DoNotOptimize(boost::num_vertices(dag));
+    }
+    state.SetItemsProcessed(state.iterations() * instr_list.size());
+}
+BENCHMARK(BM_GraphGreedy)->Apply(synthetic_args);
+
+// The complete fusion of an instruction list, which misses the fuse cache
+void BM_KernelList(::benchmark::State &state) {
+    SyntheticProgram program = synthetic_program(state);
+    set<bh_base *> frees;
+    const vector<bh_instruction *> instr_list = jitk::remove_non_computed_system_instr(program.instr_list, frees);
+    jitk::Statistics stat(false, config());
+    for (auto _: state) {
+        jitk::FuseCache fcache(stat);
+        auto kernel_list = jitk::get_kernel_list(instr_list, config(), fcache, stat, false, false);
+        ::benchmark::DoNotOptimize(kernel_list);
+    }
+    state.SetItemsProcessed(state.iterations() * instr_list.size());
+}
+BENCHMARK(BM_KernelList)->Apply(synthetic_args);
+
+}
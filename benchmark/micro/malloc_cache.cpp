@@ -0,0 +1,62 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <bh_malloc_cache.hpp>
+
+using namespace bohrium;
+
+namespace {
+
+void *heap_alloc(uint64_t nbytes) {
+    return std::malloc(nbytes);
+}
+
+void heap_free(void *mem, uint64_t) {
+    std::free(mem);
+}
+
+// Allocate and free `state.range(0)` segments of different sizes repeatedly, which hits the cache after the
+// first round
+void BM_MallocCache(::benchmark::State &state) {
+    const auto num_segments = static_cast<size_t>(state.range(0));
+    MallocCache cache(heap_alloc, heap_free, uint64_t{1} << 32);
+    std::vector<uint64_t> sizes(num_segments);
+    for (size_t i = 0; i < num_segments; ++i) {
+        sizes[i] = (i % 16 + 1) * 4096;
+    }
+    std::vector<void *> mem(num_segments);
+    for (auto _: state) {
+        for (size_t i = 0; i < num_segments; ++i) {
+            mem[i] = cache.alloc(sizes[i]);
+        }
+        for (size_t i = 0; i < num_segments; ++i) {
+            cache.free(sizes[i], mem[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_segments);
+    state.counters["hit_rate"] = 1.0 - static_cast<double>(cache.getTotalNumMisses()) / cache.getTotalNumLookups();
+}
+BENCHMARK(BM_MallocCache)->ArgName("segments")->Arg(1)->Arg(16)->Arg(256);
+
+}
@@ -0,0 +1,67 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+#include <bh_ir.hpp>
+
+#include "synthetic.hpp"
+
+using namespace std;
+using namespace bohrium;
+using namespace bohrium::bench;
+
+namespace {
+
+// The serialization of a BhIR where all base arrays are new to the receiver
+void BM_BhIRSerialize(::benchmark::State &state) {
+    SyntheticProgram program = synthetic_program(state);
+    BhIR bhir(program.instr_list, program.syncs);
+    int64_t nbytes = 0;
+    for (auto _: state) {
+        set<bh_base *> known_base_arrays;
+        vector<bh_base *> new_data;
+        const vector<char> archive = bhir.writeSerializedArchive(known_base_arrays, new_data);
+        nbytes = static_cast<int64_t>(archive.size());
+    }
+    state.SetItemsProcessed(state.iterations() * bhir.instr_list.size());
+    state.SetBytesProcessed(state.iterations() * nbytes);
+}
+BENCHMARK(BM_BhIRSerialize)->Apply(synthetic_args);
+
+// The de-serialization of a BhIR where all base arrays are new to the receiver
+void BM_BhIRDeserialize(::benchmark::State &state) {
+    SyntheticProgram program = synthetic_program(state);
+    BhIR bhir(program.instr_list, program.syncs);
+    set<bh_base *> known_base_arrays;
+    vector<bh_base *> new_data;
+    const vector<char> archive = bhir.writeSerializedArchive(known_base_arrays, new_data);
+    for (auto _: state) {
+        map<const bh_base *, bh_base> remote2local;
+        vector<bh_base *> data_recv;
+        set<bh_base *> frees;
+        BhIR received(archive, remote2local, data_recv, frees);
+        ::benchmark::DoNotOptimize(received);
+    }
+    state.SetItemsProcessed(state.iterations() * bhir.instr_list.size());
+    state.SetBytesProcessed(state.iterations() * archive.size());
+}
+BENCHMARK(BM_BhIRDeserialize)->Apply(synthetic_args);
+
+}
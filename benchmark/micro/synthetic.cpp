@@ -0,0 +1,101 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "synthetic.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace bench {
+
+SyntheticProgram::SyntheticProgram(int64_t num_instrs, const vector<int64_t> &shape, int64_t reduce_every) {
+    const bh_view a = newArray(shape);
+    const bh_view b = newArray(shape);
+    const vector<int64_t> reduced_shape(shape.begin(), shape.end() - 1);
+    const bh_opcode opcodes[] = {BH_ADD, BH_MULTIPLY, BH_SUBTRACT, BH_MAXIMUM};
+
+    bh_view prev = a;
+    for (int64_t i = 0; i < num_instrs; ++i) {
+        const bh_view out = newArray(shape);
+        instr_list.emplace_back(opcodes[i % 4], vector<bh_view>{out, prev, b});
+
+        if (reduce_every > 0 and not reduced_shape.empty() and (i + 1) % reduce_every == 0) {
+            const bh_view reduced = newArray(reduced_shape);
+            bh_instruction reduce(BH_ADD_REDUCE, {reduced, out, bh_view()});
+            reduce.constant = bh_constant(static_cast<int64_t>(shape.size() - 1));
+            instr_list.push_back(reduce);
+            syncs.insert(reduced.base);
+        }
+        if (prev.base != a.base) {
+            instr_list.emplace_back(BH_FREE, vector<bh_view>{prev});
+        }
+        prev = out;
+    }
+    syncs.insert(prev.base);
+}
+
+vector<bh_instruction *> SyntheticProgram::instrPointers() {
+    vector<bh_instruction *> ret;
+    ret.reserve(instr_list.size());
+    for (bh_instruction &instr: instr_list) {
+        ret.push_back(&instr);
+    }
+    return ret;
+}
+
+bh_view SyntheticProgram::newArray(const vector<int64_t> &shape) {
+    int64_t nelem = 1;
+    for (int64_t dim: shape) {
+        nelem *= dim;
+    }
+    _bases.emplace_back(nelem, bh_type::FLOAT64);
+    bh_view ret;
+    ret.base = &_bases.back();
+    ret.ndim = static_cast<int64_t>(shape.size());
+    ret.shape = BhIntVec(shape.begin(), shape.end());
+    ret.stride.resize(shape.size());
+    int64_t stride = 1;
+    for (int64_t i = ret.ndim - 1; i >= 0; --i) {
+        ret.stride[i] = stride;
+        stride *= shape[i];
+    }
+    return ret;
+}
+
+const ConfigParser &config() {
+    static const ConfigParser ret(-1);
+    return ret;
+}
+
+void synthetic_args(::benchmark::internal::Benchmark *b) {
+    b->ArgNames({"instrs", "ndim", "dim"});
+    b->Args({16, 1, 1000000});
+    b->Args({16, 2, 1000});
+    b->Args({128, 2, 1000});
+    b->Args({128, 3, 100});
+    b->Args({512, 2, 1000});
+}
+
+SyntheticProgram synthetic_program(const ::benchmark::State &state) {
+    return SyntheticProgram(state.range(0), vector<int64_t>(static_cast<size_t>(state.range(1)), state.range(2)));
+}
+
+}
+} // namespace bohrium::bench
@@ -0,0 +1,77 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <bh_instruction.hpp>
+#include <bh_config_parser.hpp>
+
+namespace bohrium {
+namespace bench {
+
+/** A synthetic instruction list of `num_instrs` element-wise operations on float64 arrays of `shape`.
+ * The operations form a chain of temporaries, which are freed after their last use, and every `reduce_every`
+ * operation also reduces the current temporary over its last axis into an array that is synced like the result
+ * of the chain.
+ * Notice, the base arrays have no data thus the instruction list can be fused, code generated, and
+ * serialized but not executed.
+ */
+class SyntheticProgram {
+public:
+    SyntheticProgram(int64_t num_instrs, const std::vector<int64_t> &shape, int64_t reduce_every = 8);
+
+    // The views of `instr_list` point into `_bases`, thus a copy would point into the bases of the original.
+    // Moving is fine since moving a deque keeps the addresses of its elements.
+    SyntheticProgram(const SyntheticProgram &) = delete;
+    SyntheticProgram &operator=(const SyntheticProgram &) = delete;
+    SyntheticProgram(SyntheticProgram &&) = default;
+    SyntheticProgram &operator=(SyntheticProgram &&) = default;
+
+    // The instruction list including the BH_FREE instructions
+    std::vector<bh_instruction> instr_list;
+
+    // The base arrays synced by the instruction list
+    std::set<bh_base *> syncs;
+
+    // Return pointers to the instructions in `instr_list`
+    std::vector<bh_instruction *> instrPointers();
+
+private:
+    std::deque<bh_base> _bases; // A deque never moves its elements
+
+    // Create a new base array and return a view of it with the shape `shape`
+    bh_view newArray(const std::vector<int64_t> &shape);
+};
+
+// The config of the benchmarks (the bridge section of the Bohrium config file)
+const ConfigParser &config();
+
+// The arguments of benchmarks of synthetic programs: number of instructions, number of dimensions, and the
+// length of each dimension
+void synthetic_args(::benchmark::internal::Benchmark *b);
+
+// Create the synthetic program of the arguments of `state` (see `synthetic_args()`)
+SyntheticProgram synthetic_program(const ::benchmark::State &state);
+
+}
+} // namespace bohrium::bench
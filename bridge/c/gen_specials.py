@@ -105,6 +105,22 @@ def main(args):
 {
     bhxx::Runtime::instance().setDeviceContext((void*)device_context);
 }
+"""
+
+    doc = "\n// Tag the following operations with the source location `filename:line` of the user program, which the\n"
+    doc += "// profilers use to attribute kernel time to source lines. Use NULL to stop tagging.\n"
+    impl += doc; head += doc
+    decl = "void bhc_set_source_location(const char *filename, int64_t line)"
+    head += "%s;\n" % decl
+    impl += "%s" % decl
+    impl += """
+{
+    if (filename == NULL) {
+        bhxx::Runtime::instance().resetSourceLocation();
+    } else {
+        bhxx::Runtime::instance().setSourceLocation(filename, line);
+    }
+}
 """
 
     doc = "\n// Create new flat array\n"
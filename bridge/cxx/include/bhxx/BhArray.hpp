@@ -85,13 +85,14 @@ public:
     explicit
     BhArray(Shape shape, Stride stride, uint64_t offset = 0) : offset(offset), shape(std::move(shape)),
                                                                stride(std::move(stride)),
-                                                               base(make_base_ptr(T(0), shape.prod())) {
-        assert(shape.size() == stride.size());
-        assert(shape.prod() > 0);
+                                                               base(make_base_ptr(T(0), this->shape.prod())) {
+        assert(this->shape.size() == this->stride.size());
+        assert(this->shape.prod() > 0);
     }
 
-    /** Create a new view (contiguous stride, row-major) */
-    explicit BhArray(Shape shape) : BhArray(std::move(shape), contiguous_stride(shape), 0) {}
+    /** Create a new view (contiguous stride, row-major)
+     *  NB: `shape` is copied since the evaluation order of the arguments is unspecified */
+    explicit BhArray(Shape shape) : BhArray(shape, contiguous_stride(shape), 0) {}
 
     /** Create a view that points to the given base
      *
@@ -106,8 +107,8 @@ public:
                                                                                              shape(std::move(shape)),
                                                                                              stride(std::move(stride)),
                                                                                              base(std::move(base)) {
-        assert(shape.size() == stride.size());
-        assert(shape.prod() > 0);
+        assert(this->shape.size() == this->stride.size());
+        assert(this->shape.prod() > 0);
     }
 
     /** Create a view that points to the given base (contiguous stride, row-major)
@@ -118,9 +119,9 @@ public:
      *        construct a BhBase object, use the make_base_ptr
      *        helper function.
      */
-    explicit BhArray(std::shared_ptr<BhBase> base, Shape shape) : BhArray(std::move(base), std::move(shape),
+    explicit BhArray(std::shared_ptr<BhBase> base, Shape shape) : BhArray(std::move(base), shape,
                                                                           contiguous_stride(shape), 0) {
-        assert(static_cast<uint64_t>(base->nelem()) == shape.prod());
+        assert(static_cast<uint64_t>(this->base->nelem()) == this->shape.prod());
     }
 
     //
@@ -171,6 +171,17 @@ public:
     // Get the number of calls to flush so far
     uint64_t getFlushCount() { return _flush_count; }
 
+    /** Tag the following instructions with the source location `filename:line` of the user program
+     * (see `bh_instruction::source_id`), which the profilers use to attribute kernel time to source lines
+     *
+     * @filename  The source filename
+     * @line      The line number
+     */
+    void setSourceLocation(const std::string &filename, int64_t line);
+
+    /// Stop tagging instructions with a source location
+    void resetSourceLocation() { _source_id = -1; }
+
 private:
     //@{
     /** BH_FREE for arrays is special, since we deal with the deletion of the
@@ -209,6 +220,9 @@ private:
 
     // Number of calls to flush
     uint64_t _flush_count = 0;
+
+    // The source location of the enqueued instructions (-1 means none)
+    int64_t _source_id = -1;
 };
 
 //
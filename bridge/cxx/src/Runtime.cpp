@@ -19,6 +19,7 @@ If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <bhxx/Runtime.hpp>
+#include <bh_source_location.hpp>
 #include <iterator>
 
 using namespace std;
@@ -31,6 +32,7 @@ Runtime::Runtime()
         extmethod_next_opcode_id(BH_MAX_OPCODE_ID + 1) {}
 
 void Runtime::enqueue(BhInstruction instr) {
+    instr.source_id = _source_id;
     instr_list.push_back(std::move(instr));
 
     // We hard-code a kernel size threshold here.
@@ -41,6 +43,10 @@ void Runtime::enqueue(BhInstruction instr) {
     }
 }
 
+void Runtime::setSourceLocation(const std::string &filename, int64_t line) {
+    _source_id = bh_source_location_id(filename, line);
+}
+
 void Runtime::enqueueRandom(BhArray<uint64_t>& out, uint64_t seed, uint64_t key) {
     BhInstruction instr(BH_RANDOM);
     instr.appendOperand(out);  // Append output array
@@ -84,15 +84,21 @@ class DisableBohrium:
 
 
 class Profiling:
-    """Profiling the Bohrium backends within the context."""
+    """Profiling the Bohrium backends within the context, which includes attributing the kernel time to the
+    Python source lines of the array operations."""
 
     def __init__(self):
-        pass
+        self._prof_source_lines = False
 
     def __enter__(self):
+        from . import _bh
         messaging.statistic_enable_and_reset()
+        self._prof_source_lines = _bh.prof_source_lines(True)
 
     def __exit__(self, *args):
+        from . import _bh
+        _bh.flush()  # Execute the operations of the context before reading the statistic
+        _bh.prof_source_lines(self._prof_source_lines)
         print(messaging.statistic())
 
 
@@ -7,7 +7,8 @@ Random functions
 """
 import bohrium as np
 import numpy_force as numpy
-from numpy_force.random import *
+import numpy_force.random as _npr  # LOCALHACK
+globals().update({_k: getattr(_npr, _k) for _k in _npr.__all__ if _k != 'RandomState'})  # LOCALHACK
 import operator
 import functools
 import datetime
@@ -245,6 +245,40 @@ def scatter(ary, indexes, values):
     ary[...] = flat.reshape(ary.shape)
 
 
+@fix_biclass_wrapper
+def scatter_add(ary, indexes, values):
+    """
+    scatter_add(ary, indexes, values)
+
+    Add 'values' to the elements of 'ary' selected by 'indexes'.
+    The values of 'indexes' are absolute indexed into a flatten 'ary'
+    and repeated indexes accumulate, which makes it equivalent to `numpy.add.at()`.
+    The shape of 'indexes' and 'value' must be equal.
+
+    Parameters
+    ----------
+    ary  : array_like
+        The target array to add the values to.
+    indexes : array_like, interpreted as integers
+        Array or list of indexes that will be added to in 'ary'
+    values : array_like
+        Values to add into 'ary"
+    """
+    from . import _bh
+
+    indexes = array_manipulation.flatten(array_create.array(indexes, dtype=numpy.uint64), always_copy=False)
+    values = array_manipulation.flatten(array_create.array(values, dtype=ary.dtype), always_copy=False)
+
+    assert indexes.shape == values.shape
+    if ary.size == 0 or indexes.size == 0:
+        return
+
+    # In order to ensure a contiguous array, we do the scatter-add on a flatten copy
+    flat = array_manipulation.flatten(ary, always_copy=True)
+    _bh.ufunc(_info.op['scatter_add']['id'], (flat, values, indexes))
+    ary[...] = flat.reshape(ary.shape)
+
+
 @fix_biclass_wrapper
 def put(a, ind, v, mode='raise'):
     """
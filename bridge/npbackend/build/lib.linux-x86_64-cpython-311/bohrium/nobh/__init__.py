@@ -0,0 +1,5 @@
+"""
+The subpackage `nobh` is for implementations not handled by the Bohrium backend.
+"""
+
+from .bincount import bincount
\ No newline at end of file
@@ -36,6 +36,7 @@ PyObject *masking        = NULL; // The masking Python module
 PyObject *loop           = NULL; // The loop Python module
 int bh_sync_warn         = 0;    // Boolean: should we warn when copying from Bohrium to NumPy
 int bh_mem_warn          = 0;    // Boolean: should we warn when about memory problems
+int bh_prof_source_lines = 0;    // Boolean: should we tag array operations with their Python source line
 
 // The current Python thread state
 PyThreadState *py_thread_state = NULL;
@@ -894,6 +895,8 @@ static PyMethodDef _bhMethods[] = {
             "Send and receive a message through the Bohrium stack\n"},
     {"same_view", (PyCFunction) PySameView, METH_VARARGS | METH_KEYWORDS,
             "Return true when `v1` and `v2` is exactly the same (incl. pointing to the same base)\n"},
+    {"prof_source_lines", (PyCFunction) PyProfSourceLines, METH_VARARGS | METH_KEYWORDS,
+            "Enable or disable the profiling of Python source lines and return the previous setting\n"},
     {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
@@ -982,6 +985,12 @@ PyMODINIT_FUNC init_bh(void)
         bh_mem_warn = 1;
     }
 
+    // Check the 'BH_PROF_SOURCE_LINES' flag
+    value = getenv("BH_PROF_SOURCE_LINES");
+    if (value != NULL) {
+        bh_prof_source_lines = 1;
+    }
+
     // Let's save the current Python thread state
     PyGILState_STATE gil = PyGILState_Ensure();
     py_thread_state = PyGILState_GetThisThreadState();
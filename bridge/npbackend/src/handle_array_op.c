@@ -105,7 +105,9 @@ PyObject *array_op(int opcode, const Py_ssize_t nop, PyObject **operand_list) {
         }
     }
 
+    source_location_begin();
     BhAPI_op(opcode, types, constants, operands);
+    source_location_end();
 
     // Clean up
     normalize_operand_cleanup(&cleanup);
@@ -73,7 +73,9 @@ PyExtMethod(PyObject *self, PyObject *args, PyObject *kwds) {
 
     }
 
+    source_location_begin();
     int err = BhAPI_extmethod(types[0], name, operands[0], operands[1], operands[2]);
+    source_location_end();
     if (err) {
         PyErr_Format(PyExc_TypeError, "The current runtime system does not support the extension method '%s'", name);
     }
@@ -252,7 +254,9 @@ PyObject* PyRandom123(PyObject *self, PyObject *args, PyObject *kwds) {
                 return ret;
             }
         }
+        source_location_begin();
         BhAPI_random123(operand, seed, key);
+        source_location_end();
         normalize_operand_cleanup(&cleanup);
     }
     return ret;
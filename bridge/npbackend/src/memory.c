@@ -21,7 +21,6 @@ If not, see <http://www.gnu.org/licenses/>.
 #include "memory.h"
 #include "util.h"
 #include "handle_special_op.h"
-#include <frameobject.h>
 
 // In OSX `MAP_ANONYMOUS` is called `MAP_ANON`
 #ifndef MAP_ANONYMOUS
@@ -119,28 +118,33 @@ static void _display_file_line(const char *filename, int lineno) {
     static void _display_backtrace(int stack_limit) {
         // First we try to get the current Python thread state using `PyGILState_GetThisThreadState()`
         PyThreadState *tstate = PyGILState_GetThisThreadState();
-        if (NULL == tstate || NULL == tstate->frame) {
+        PyFrameObject *frame = NULL;
+        if (NULL == tstate || NULL == (frame = PyThreadState_GetFrame(tstate))) {
             // If that fails, we use the previously saved one `py_thread_state`
             tstate = py_thread_state;
-            if (NULL == tstate || NULL == tstate->frame) {
+            if (NULL == tstate || NULL == (frame = PyThreadState_GetFrame(tstate))) {
                 // If that also fails, we give up
                 printf("<< sorry traceback info not available %p >>\n", tstate);
                 return;
             }
         }
-        // Now that we have the current Python thread state, we can print the backtrace
-        PyFrameObject *frame = tstate->frame;
+        // Now that we have the current Python frame, we can print the backtrace
         for(int i=0; i < stack_limit && frame != NULL; ++i) {
-            int line = PyCode_Addr2Line(frame->f_code, frame->f_lasti);
+            int line = PyFrame_GetLineNumber(frame);
+            PyCodeObject *code = PyFrame_GetCode(frame);
         #if defined(NPY_PY3K)
             Py_ssize_t filename_size;
-            const char *filename = PyUnicode_AsUTF8AndSize(frame->f_code->co_filename, &filename_size);
+            const char *filename = PyUnicode_AsUTF8AndSize(code->co_filename, &filename_size);
         #else
-            const char *filename = PyString_AsString(frame->f_code->co_filename);
+            const char *filename = PyString_AsString(code->co_filename);
         #endif
             _display_file_line(filename, line);
-            frame = frame->f_back;
+            Py_DECREF(code);
+            PyFrameObject *back = PyFrame_GetBack(frame);
+            Py_DECREF(frame);
+            frame = back;
         }
+        Py_XDECREF(frame);
     }
 #endif
 
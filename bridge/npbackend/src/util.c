@@ -175,3 +175,86 @@ PyObject *PySameView(PyObject *self, PyObject *args, PyObject *kwds) {
         Py_RETURN_FALSE;
     }
 }
+
+// Return the filename of `code` as a C string, which lives as long as `code`
+static const char *code_filename(PyCodeObject *code) {
+#if defined(NPY_PY3K)
+    const char *ret = PyUnicode_AsUTF8(code->co_filename);
+#else
+    const char *ret = PyString_AsString(code->co_filename);
+#endif
+    if (ret == NULL) {
+        PyErr_Clear();
+    }
+    return ret;
+}
+
+void source_location_begin(void) {
+    // The directory of the Bohrium package (incl. the trailing separator), which we find on the first call
+    static const char *package_dir = NULL;
+    static size_t package_dir_len = 0;
+
+    if (!bh_prof_source_lines) {
+        return;
+    }
+    if (package_dir == NULL) {
+        PyObject *file = PyObject_GetAttrString(bohrium, "__file__");
+        if (file == NULL) {
+            PyErr_Clear();
+            package_dir = "";
+        } else {
+#if defined(NPY_PY3K)
+            const char *filename = PyUnicode_AsUTF8(file);
+#else
+            const char *filename = PyString_AsString(file);
+#endif
+            if (filename == NULL) {
+                PyErr_Clear();
+            }
+            const char *sep = filename == NULL ? NULL : strrchr(filename, '/');
+            package_dir_len = sep == NULL ? 0 : (size_t) (sep - filename + 1);
+            char *dir = malloc(package_dir_len + 1); // NB: `strndup()` isn't C99
+            if (package_dir_len > 0) {
+                memcpy(dir, filename, package_dir_len);
+            }
+            dir[package_dir_len] = '\0';
+            package_dir = dir;
+            Py_DECREF(file);
+        }
+    }
+    // Skip the frames of the Bohrium package itself. NB: `PyEval_GetFrame()` returns a borrowed reference whereas
+    // `PyFrame_GetCode()` and `PyFrame_GetBack()` return new references.
+    PyFrameObject *frame = PyEval_GetFrame();
+    Py_XINCREF(frame);
+    while (frame != NULL) {
+        PyCodeObject *code = PyFrame_GetCode(frame);
+        const char *filename = code_filename(code);
+        if (filename != NULL && (package_dir_len == 0 || strncmp(filename, package_dir, package_dir_len) != 0)) {
+            BhAPI_set_source_location(filename, PyFrame_GetLineNumber(frame));
+            Py_DECREF(code);
+            Py_DECREF(frame);
+            return;
+        }
+        Py_DECREF(code);
+        PyFrameObject *back = PyFrame_GetBack(frame);
+        Py_DECREF(frame);
+        frame = back;
+    }
+}
+
+void source_location_end(void) {
+    if (bh_prof_source_lines) {
+        BhAPI_set_source_location(NULL, -1);
+    }
+}
+
+PyObject *PyProfSourceLines(PyObject *self, PyObject *args, PyObject *kwds) {
+    int enable;
+    static char *kwlist[] = {"enable", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "i", kwlist, &enable)) {
+        return NULL;
+    }
+    const int previous = bh_prof_source_lines;
+    bh_prof_source_lines = enable;
+    return PyBool_FromLong(previous);
+}
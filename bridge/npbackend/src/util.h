@@ -28,6 +28,24 @@ If not, see <http://www.gnu.org/licenses/>.
 #define NO_IMPORT_BH_API
 #include "_bh.h"
 
+/** The frame objects are opaque from Python 3.11, thus we use the accessors of Python 3.9+, which return new
+    references. Before Python 3.9, we implement them on top of the public frame struct. */
+#if PY_VERSION_HEX < 0x030900B1
+#include <frameobject.h>
+static inline PyCodeObject *PyFrame_GetCode(PyFrameObject *frame) {
+    Py_INCREF(frame->f_code);
+    return frame->f_code;
+}
+static inline PyFrameObject *PyFrame_GetBack(PyFrameObject *frame) {
+    Py_XINCREF(frame->f_back);
+    return frame->f_back;
+}
+static inline PyFrameObject *PyThreadState_GetFrame(PyThreadState *tstate) {
+    Py_XINCREF(tstate->frame);
+    return tstate->frame;
+}
+#endif
+
 /** This corresponds to `numpy.isscalar()`, which does not count 0-dim arrays as scalars
     In Bohrium, we handle 0-dim arrays as regular arrays. */
 #define IsAnyScalar(o) (PyArray_IsScalar(o, Generic) || PyArray_IsPythonNumber(o))
@@ -88,3 +106,14 @@ BhArray *get_base(PyObject *ary);
  */
 int same_view(PyArrayObject *v1, PyArrayObject *v2);
 PyObject *PySameView(PyObject *self, PyObject *args, PyObject *kwds);
+
+/** Tag the following array operations with the source location of the Python code that called into Bohrium,
+ *  which is the innermost frame outside of the Bohrium package. Does nothing unless `bh_prof_source_lines` is set.
+ */
+void source_location_begin(void);
+
+/** Stop tagging array operations with a source location (see `source_location_begin()`) */
+void source_location_end(void);
+
+/** Enable or disable the tagging of array operations with their source location and return the previous setting */
+PyObject *PyProfSourceLines(PyObject *self, PyObject *args, PyObject *kwds);
@@ -0,0 +1,967 @@
+# This file is auto generated by the setup.py
+op = { 'absolute': { 'elementwise': True,
+                'id': 6,
+                'name': 'absolute',
+                'nop': 2,
+                'type_sig': [ ['bool', 'bool'],
+                              ['float32', 'float32'],
+                              ['float64', 'float64'],
+                              ['float32', 'complex64'],
+                              ['float64', 'complex128'],
+                              ['int16', 'int16'],
+                              ['int32', 'int32'],
+                              ['int64', 'int64'],
+                              ['int8', 'int8'],
+                              ['uint16', 'uint16'],
+                              ['uint32', 'uint32'],
+                              ['uint64', 'uint64'],
+                              ['uint8', 'uint8']]},
+  'add': { 'elementwise': True,
+           'id': 1,
+           'name': 'add',
+           'nop': 3,
+           'type_sig': [ ['bool', 'bool', 'bool'],
+                         ['complex128', 'complex128', 'complex128'],
+                         ['complex64', 'complex64', 'complex64'],
+                         ['float32', 'float32', 'float32'],
+                         ['float64', 'float64', 'float64'],
+                         ['int16', 'int16', 'int16'],
+                         ['int32', 'int32', 'int32'],
+                         ['int64', 'int64', 'int64'],
+                         ['int8', 'int8', 'int8'],
+                         ['uint16', 'uint16', 'uint16'],
+                         ['uint32', 'uint32', 'uint32'],
+                         ['uint64', 'uint64', 'uint64'],
+                         ['uint8', 'uint8', 'uint8']]},
+  'add_accumulate': { 'elementwise': False,
+                      'id': 75,
+                      'name': 'add_accumulate',
+                      'nop': 3,
+                      'type_sig': [ ['complex128', 'complex128', 'int64'],
+                                    ['complex64', 'complex64', 'int64'],
+                                    ['float32', 'float32', 'int64'],
+                                    ['float64', 'float64', 'int64'],
+                                    ['int16', 'int16', 'int64'],
+                                    ['int32', 'int32', 'int64'],
+                                    ['int64', 'int64', 'int64'],
+                                    ['int8', 'int8', 'int64'],
+                                    ['uint16', 'uint16', 'int64'],
+                                    ['uint32', 'uint32', 'int64'],
+                                    ['uint64', 'uint64', 'int64'],
+                                    ['uint8', 'uint8', 'int64']]},
+  'add_reduce': { 'elementwise': False,
+                  'id': 59,
+                  'name': 'add_reduce',
+                  'nop': 3,
+                  'type_sig': [ ['complex128', 'complex128', 'int64'],
+                                ['complex64', 'complex64', 'int64'],
+                                ['float32', 'float32', 'int64'],
+                                ['float64', 'float64', 'int64'],
+                                ['int16', 'int16', 'int64'],
+                                ['int32', 'int32', 'int64'],
+                                ['int64', 'int64', 'int64'],
+                                ['int8', 'int8', 'int64'],
+                                ['uint16', 'uint16', 'int64'],
+                                ['uint32', 'uint32', 'int64'],
+                                ['uint64', 'uint64', 'int64'],
+                                ['uint8', 'uint8', 'int64']]},
+  'arccos': { 'elementwise': True,
+              'id': 32,
+              'name': 'arccos',
+              'nop': 2,
+              'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'arccosh': { 'elementwise': True,
+               'id': 35,
+               'name': 'arccosh',
+               'nop': 2,
+               'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'arcsin': { 'elementwise': True,
+              'id': 31,
+              'name': 'arcsin',
+              'nop': 2,
+              'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'arcsinh': { 'elementwise': True,
+               'id': 34,
+               'name': 'arcsinh',
+               'nop': 2,
+               'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'arctan': { 'elementwise': True,
+              'id': 33,
+              'name': 'arctan',
+              'nop': 2,
+              'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'arctan2': { 'elementwise': True,
+               'id': 37,
+               'name': 'arctan2',
+               'nop': 3,
+               'type_sig': [ ['float32', 'float32', 'float32'],
+                             ['float64', 'float64', 'float64']]},
+  'arctanh': { 'elementwise': True,
+               'id': 36,
+               'name': 'arctanh',
+               'nop': 2,
+               'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'bitwise_and': { 'elementwise': True,
+                   'id': 19,
+                   'name': 'bitwise_and',
+                   'nop': 3,
+                   'type_sig': [ ['bool', 'bool', 'bool'],
+                                 ['int16', 'int16', 'int16'],
+                                 ['int32', 'int32', 'int32'],
+                                 ['int64', 'int64', 'int64'],
+                                 ['int8', 'int8', 'int8'],
+                                 ['uint16', 'uint16', 'uint16'],
+                                 ['uint32', 'uint32', 'uint32'],
+                                 ['uint64', 'uint64', 'uint64'],
+                                 ['uint8', 'uint8', 'uint8']]},
+  'bitwise_and_reduce': { 'elementwise': False,
+                          'id': 64,
+                          'name': 'bitwise_and_reduce',
+                          'nop': 3,
+                          'type_sig': [ ['bool', 'bool', 'int64'],
+                                        ['int16', 'int16', 'int64'],
+                                        ['int32', 'int32', 'int64'],
+                                        ['int64', 'int64', 'int64'],
+                                        ['int8', 'int8', 'int64'],
+                                        ['uint16', 'uint16', 'int64'],
+                                        ['uint32', 'uint32', 'int64'],
+                                        ['uint64', 'uint64', 'int64'],
+                                        ['uint8', 'uint8', 'int64']]},
+  'bitwise_or': { 'elementwise': True,
+                  'id': 20,
+                  'name': 'bitwise_or',
+                  'nop': 3,
+                  'type_sig': [ ['bool', 'bool', 'bool'],
+                                ['int16', 'int16', 'int16'],
+                                ['int32', 'int32', 'int32'],
+                                ['int64', 'int64', 'int64'],
+                                ['int8', 'int8', 'int8'],
+                                ['uint16', 'uint16', 'uint16'],
+                                ['uint32', 'uint32', 'uint32'],
+                                ['uint64', 'uint64', 'uint64'],
+                                ['uint8', 'uint8', 'uint8']]},
+  'bitwise_or_reduce': { 'elementwise': False,
+                         'id': 66,
+                         'name': 'bitwise_or_reduce',
+                         'nop': 3,
+                         'type_sig': [ ['bool', 'bool', 'int64'],
+                                       ['int16', 'int16', 'int64'],
+                                       ['int32', 'int32', 'int64'],
+                                       ['int64', 'int64', 'int64'],
+                                       ['int8', 'int8', 'int64'],
+                                       ['uint16', 'uint16', 'int64'],
+                                       ['uint32', 'uint32', 'int64'],
+                                       ['uint64', 'uint64', 'int64'],
+                                       ['uint8', 'uint8', 'int64']]},
+  'bitwise_xor': { 'elementwise': True,
+                   'id': 21,
+                   'name': 'bitwise_xor',
+                   'nop': 3,
+                   'type_sig': [ ['bool', 'bool', 'bool'],
+                                 ['int16', 'int16', 'int16'],
+                                 ['int32', 'int32', 'int32'],
+                                 ['int64', 'int64', 'int64'],
+                                 ['int8', 'int8', 'int8'],
+                                 ['uint16', 'uint16', 'uint16'],
+                                 ['uint32', 'uint32', 'uint32'],
+                                 ['uint64', 'uint64', 'uint64'],
+                                 ['uint8', 'uint8', 'uint8']]},
+  'bitwise_xor_reduce': { 'elementwise': False,
+                          'id': 68,
+                          'name': 'bitwise_xor_reduce',
+                          'nop': 3,
+                          'type_sig': [ ['bool', 'bool', 'int64'],
+                                        ['int16', 'int16', 'int64'],
+                                        ['int32', 'int32', 'int64'],
+                                        ['int64', 'int64', 'int64'],
+                                        ['int8', 'int8', 'int64'],
+                                        ['uint16', 'uint16', 'int64'],
+                                        ['uint32', 'uint32', 'int64'],
+                                        ['uint64', 'uint64', 'int64'],
+                                        ['uint8', 'uint8', 'int64']]},
+  'ceil': { 'elementwise': True,
+            'id': 46,
+            'name': 'ceil',
+            'nop': 2,
+            'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'cond_scatter': { 'elementwise': False,
+                    'id': 82,
+                    'name': 'cond_scatter',
+                    'nop': 4,
+                    'type_sig': [ ['bool', 'bool', 'uint64', 'bool'],
+                                  [ 'complex128',
+                                    'complex128',
+                                    'uint64',
+                                    'bool'],
+                                  ['complex64', 'complex64', 'uint64', 'bool'],
+                                  ['float32', 'float32', 'uint64', 'bool'],
+                                  ['float64', 'float64', 'uint64', 'bool'],
+                                  ['int16', 'int16', 'uint64', 'bool'],
+                                  ['int32', 'int32', 'uint64', 'bool'],
+                                  ['int64', 'int64', 'uint64', 'bool'],
+                                  ['int8', 'int8', 'uint64', 'bool'],
+                                  ['uint16', 'uint16', 'uint64', 'bool'],
+                                  ['uint32', 'uint32', 'uint64', 'bool'],
+                                  ['uint64', 'uint64', 'uint64', 'bool'],
+                                  ['uint8', 'uint8', 'uint64', 'bool']]},
+  'conj': { 'elementwise': True,
+            'id': 84,
+            'name': 'conj',
+            'nop': 2,
+            'type_sig': [ ['complex64', 'complex64'],
+                          ['complex128', 'complex128']]},
+  'cos': { 'elementwise': True,
+           'id': 25,
+           'name': 'cos',
+           'nop': 2,
+           'type_sig': [ ['complex128', 'complex128'],
+                         ['complex64', 'complex64'],
+                         ['float32', 'float32'],
+                         ['float64', 'float64']]},
+  'cosh': { 'elementwise': True,
+            'id': 28,
+            'name': 'cosh',
+            'nop': 2,
+            'type_sig': [ ['complex128', 'complex128'],
+                          ['complex64', 'complex64'],
+                          ['float32', 'float32'],
+                          ['float64', 'float64']]},
+  'divide': { 'elementwise': True,
+              'id': 4,
+              'name': 'divide',
+              'nop': 3,
+              'type_sig': [ ['complex128', 'complex128', 'complex128'],
+                            ['complex64', 'complex64', 'complex64'],
+                            ['float32', 'float32', 'float32'],
+                            ['float64', 'float64', 'float64'],
+                            ['int16', 'int16', 'int16'],
+                            ['int32', 'int32', 'int32'],
+                            ['int64', 'int64', 'int64'],
+                            ['int8', 'int8', 'int8'],
+                            ['uint16', 'uint16', 'uint16'],
+                            ['uint32', 'uint32', 'uint32'],
+                            ['uint64', 'uint64', 'uint64'],
+                            ['uint8', 'uint8', 'uint8']]},
+  'equal': { 'elementwise': True,
+             'id': 11,
+             'name': 'equal',
+             'nop': 3,
+             'type_sig': [ ['bool', 'bool', 'bool'],
+                           ['bool', 'complex128', 'complex128'],
+                           ['bool', 'complex64', 'complex64'],
+                           ['bool', 'float32', 'float32'],
+                           ['bool', 'float64', 'float64'],
+                           ['bool', 'int16', 'int16'],
+                           ['bool', 'int32', 'int32'],
+                           ['bool', 'int64', 'int64'],
+                           ['bool', 'int8', 'int8'],
+                           ['bool', 'uint16', 'uint16'],
+                           ['bool', 'uint32', 'uint32'],
+                           ['bool', 'uint64', 'uint64'],
+                           ['bool', 'uint8', 'uint8']]},
+  'exp': { 'elementwise': True,
+           'id': 38,
+           'name': 'exp',
+           'nop': 2,
+           'type_sig': [ ['complex128', 'complex128'],
+                         ['complex64', 'complex64'],
+                         ['float32', 'float32'],
+                         ['float64', 'float64']]},
+  'exp2': { 'elementwise': True,
+            'id': 39,
+            'name': 'exp2',
+            'nop': 2,
+            'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'expm1': { 'elementwise': True,
+             'id': 40,
+             'name': 'expm1',
+             'nop': 2,
+             'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'floor': { 'elementwise': True,
+             'id': 48,
+             'name': 'floor',
+             'nop': 2,
+             'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'gather': { 'elementwise': False,
+              'id': 79,
+              'name': 'gather',
+              'nop': 3,
+              'type_sig': [ ['bool', 'bool', 'uint64'],
+                            ['complex128', 'complex128', 'uint64'],
+                            ['complex64', 'complex64', 'uint64'],
+                            ['float32', 'float32', 'uint64'],
+                            ['float64', 'float64', 'uint64'],
+                            ['int16', 'int16', 'uint64'],
+                            ['int32', 'int32', 'uint64'],
+                            ['int64', 'int64', 'uint64'],
+                            ['int8', 'int8', 'uint64'],
+                            ['uint16', 'uint16', 'uint64'],
+                            ['uint32', 'uint32', 'uint64'],
+                            ['uint64', 'uint64', 'uint64'],
+                            ['uint8', 'uint8', 'uint64']]},
+  'greater': { 'elementwise': True,
+               'id': 7,
+               'name': 'greater',
+               'nop': 3,
+               'type_sig': [ ['bool', 'bool', 'bool'],
+                             ['bool', 'float32', 'float32'],
+                             ['bool', 'float64', 'float64'],
+                             ['bool', 'int16', 'int16'],
+                             ['bool', 'int32', 'int32'],
+                             ['bool', 'int64', 'int64'],
+                             ['bool', 'int8', 'int8'],
+                             ['bool', 'uint16', 'uint16'],
+                             ['bool', 'uint32', 'uint32'],
+                             ['bool', 'uint64', 'uint64'],
+                             ['bool', 'uint8', 'uint8']]},
+  'greater_equal': { 'elementwise': True,
+                     'id': 8,
+                     'name': 'greater_equal',
+                     'nop': 3,
+                     'type_sig': [ ['bool', 'bool', 'bool'],
+                                   ['bool', 'float32', 'float32'],
+                                   ['bool', 'float64', 'float64'],
+                                   ['bool', 'int16', 'int16'],
+                                   ['bool', 'int32', 'int32'],
+                                   ['bool', 'int64', 'int64'],
+                                   ['bool', 'int8', 'int8'],
+                                   ['bool', 'uint16', 'uint16'],
+                                   ['bool', 'uint32', 'uint32'],
+                                   ['bool', 'uint64', 'uint64'],
+                                   ['bool', 'uint8', 'uint8']]},
+  'identity': { 'elementwise': True,
+                'id': 53,
+                'name': 'identity',
+                'nop': 2,
+                'type_sig': [ ['bool', 'bool'],
+                              ['bool', 'float32'],
+                              ['bool', 'float64'],
+                              ['bool', 'int16'],
+                              ['bool', 'int32'],
+                              ['bool', 'int64'],
+                              ['bool', 'int8'],
+                              ['bool', 'uint16'],
+                              ['bool', 'uint32'],
+                              ['bool', 'uint64'],
+                              ['bool', 'uint8'],
+                              ['complex128', 'bool'],
+                              ['complex128', 'complex128'],
+                              ['complex128', 'complex64'],
+                              ['complex128', 'float32'],
+                              ['complex128', 'float64'],
+                              ['complex128', 'int16'],
+                              ['complex128', 'int32'],
+                              ['complex128', 'int64'],
+                              ['complex128', 'int8'],
+                              ['complex128', 'uint16'],
+                              ['complex128', 'uint32'],
+                              ['complex128', 'uint64'],
+                              ['complex128', 'uint8'],
+                              ['complex64', 'bool'],
+                              ['complex64', 'complex128'],
+                              ['complex64', 'complex64'],
+                              ['complex64', 'float32'],
+                              ['complex64', 'float64'],
+                              ['complex64', 'int16'],
+                              ['complex64', 'int32'],
+                              ['complex64', 'int64'],
+                              ['complex64', 'int8'],
+                              ['complex64', 'uint16'],
+                              ['complex64', 'uint32'],
+                              ['complex64', 'uint64'],
+                              ['complex64', 'uint8'],
+                              ['float32', 'bool'],
+                              ['float32', 'float32'],
+                              ['float32', 'float64'],
+                              ['float32', 'int16'],
+                              ['float32', 'int32'],
+                              ['float32', 'int64'],
+                              ['float32', 'int8'],
+                              ['float32', 'uint16'],
+                              ['float32', 'uint32'],
+                              ['float32', 'uint64'],
+                              ['float32', 'uint8'],
+                              ['float64', 'bool'],
+                              ['float64', 'float32'],
+                              ['float64', 'float64'],
+                              ['float64', 'int16'],
+                              ['float64', 'int32'],
+                              ['float64', 'int64'],
+                              ['float64', 'int8'],
+                              ['float64', 'uint16'],
+                              ['float64', 'uint32'],
+                              ['float64', 'uint64'],
+                              ['float64', 'uint8'],
+                              ['int16', 'bool'],
+                              ['int16', 'float32'],
+                              ['int16', 'float64'],
+                              ['int16', 'int16'],
+                              ['int16', 'int32'],
+                              ['int16', 'int64'],
+                              ['int16', 'int8'],
+                              ['int16', 'uint16'],
+                              ['int16', 'uint32'],
+                              ['int16', 'uint64'],
+                              ['int16', 'uint8'],
+                              ['int32', 'bool'],
+                              ['int32', 'float32'],
+                              ['int32', 'float64'],
+                              ['int32', 'int16'],
+                              ['int32', 'int32'],
+                              ['int32', 'int64'],
+                              ['int32', 'int8'],
+                              ['int32', 'uint16'],
+                              ['int32', 'uint32'],
+                              ['int32', 'uint64'],
+                              ['int32', 'uint8'],
+                              ['int64', 'bool'],
+                              ['int64', 'float32'],
+                              ['int64', 'float64'],
+                              ['int64', 'int16'],
+                              ['int64', 'int32'],
+                              ['int64', 'int64'],
+                              ['int64', 'int8'],
+                              ['int64', 'uint16'],
+                              ['int64', 'uint32'],
+                              ['int64', 'uint64'],
+                              ['int64', 'uint8'],
+                              ['int8', 'bool'],
+                              ['int8', 'float32'],
+                              ['int8', 'float64'],
+                              ['int8', 'int16'],
+                              ['int8', 'int32'],
+                              ['int8', 'int64'],
+                              ['int8', 'int8'],
+                              ['int8', 'uint16'],
+                              ['int8', 'uint32'],
+                              ['int8', 'uint64'],
+                              ['int8', 'uint8'],
+                              ['uint16', 'bool'],
+                              ['uint16', 'float32'],
+                              ['uint16', 'float64'],
+                              ['uint16', 'int16'],
+                              ['uint16', 'int32'],
+                              ['uint16', 'int64'],
+                              ['uint16', 'int8'],
+                              ['uint16', 'uint16'],
+                              ['uint16', 'uint32'],
+                              ['uint16', 'uint64'],
+                              ['uint16', 'uint8'],
+                              ['uint32', 'bool'],
+                              ['uint32', 'float32'],
+                              ['uint32', 'float64'],
+                              ['uint32', 'int16'],
+                              ['uint32', 'int32'],
+                              ['uint32', 'int64'],
+                              ['uint32', 'int8'],
+                              ['uint32', 'uint16'],
+                              ['uint32', 'uint32'],
+                              ['uint32', 'uint64'],
+                              ['uint32', 'uint8'],
+                              ['uint64', 'bool'],
+                              ['uint64', 'float32'],
+                              ['uint64', 'float64'],
+                              ['uint64', 'int16'],
+                              ['uint64', 'int32'],
+                              ['uint64', 'int64'],
+                              ['uint64', 'int8'],
+                              ['uint64', 'uint16'],
+                              ['uint64', 'uint32'],
+                              ['uint64', 'uint64'],
+                              ['uint64', 'uint8'],
+                              ['uint8', 'bool'],
+                              ['uint8', 'float32'],
+                              ['uint8', 'float64'],
+                              ['uint8', 'int16'],
+                              ['uint8', 'int32'],
+                              ['uint8', 'int64'],
+                              ['uint8', 'int8'],
+                              ['uint8', 'uint16'],
+                              ['uint8', 'uint32'],
+                              ['uint8', 'uint64'],
+                              ['uint8', 'uint8']]},
+  'imag': { 'elementwise': True,
+            'id': 74,
+            'name': 'imag',
+            'nop': 2,
+            'type_sig': [['float64', 'complex128'], ['float32', 'complex64']]},
+  'invert': { 'elementwise': True,
+              'id': 22,
+              'name': 'invert',
+              'nop': 2,
+              'type_sig': [ ['bool', 'bool'],
+                            ['int16', 'int16'],
+                            ['int32', 'int32'],
+                            ['int64', 'int64'],
+                            ['int8', 'int8'],
+                            ['uint16', 'uint16'],
+                            ['uint32', 'uint32'],
+                            ['uint64', 'uint64'],
+                            ['uint8', 'uint8']]},
+  'isfinite': { 'elementwise': True,
+                'id': 83,
+                'name': 'isfinite',
+                'nop': 2,
+                'type_sig': [ ['bool', 'bool'],
+                              ['bool', 'complex64'],
+                              ['bool', 'complex128'],
+                              ['bool', 'int8'],
+                              ['bool', 'int16'],
+                              ['bool', 'int32'],
+                              ['bool', 'int64'],
+                              ['bool', 'uint8'],
+                              ['bool', 'uint16'],
+                              ['bool', 'uint32'],
+                              ['bool', 'uint64'],
+                              ['bool', 'float32'],
+                              ['bool', 'float64']]},
+  'isinf': { 'elementwise': True,
+             'id': 52,
+             'name': 'isinf',
+             'nop': 2,
+             'type_sig': [ ['bool', 'bool'],
+                           ['bool', 'complex64'],
+                           ['bool', 'complex128'],
+                           ['bool', 'int8'],
+                           ['bool', 'int16'],
+                           ['bool', 'int32'],
+                           ['bool', 'int64'],
+                           ['bool', 'uint8'],
+                           ['bool', 'uint16'],
+                           ['bool', 'uint32'],
+                           ['bool', 'uint64'],
+                           ['bool', 'float32'],
+                           ['bool', 'float64']]},
+  'isnan': { 'elementwise': True,
+             'id': 51,
+             'name': 'isnan',
+             'nop': 2,
+             'type_sig': [ ['bool', 'bool'],
+                           ['bool', 'complex64'],
+                           ['bool', 'complex128'],
+                           ['bool', 'int8'],
+                           ['bool', 'int16'],
+                           ['bool', 'int32'],
+                           ['bool', 'int64'],
+                           ['bool', 'uint8'],
+                           ['bool', 'uint16'],
+                           ['bool', 'uint32'],
+                           ['bool', 'uint64'],
+                           ['bool', 'float32'],
+                           ['bool', 'float64']]},
+  'left_shift': { 'elementwise': True,
+                  'id': 23,
+                  'name': 'left_shift',
+                  'nop': 3,
+                  'type_sig': [ ['int16', 'int16', 'int16'],
+                                ['int32', 'int32', 'int32'],
+                                ['int64', 'int64', 'int64'],
+                                ['int8', 'int8', 'int8'],
+                                ['uint16', 'uint16', 'uint16'],
+                                ['uint32', 'uint32', 'uint32'],
+                                ['uint64', 'uint64', 'uint64'],
+                                ['uint8', 'uint8', 'uint8']]},
+  'less': { 'elementwise': True,
+            'id': 9,
+            'name': 'less',
+            'nop': 3,
+            'type_sig': [ ['bool', 'bool', 'bool'],
+                          ['bool', 'float32', 'float32'],
+                          ['bool', 'float64', 'float64'],
+                          ['bool', 'int16', 'int16'],
+                          ['bool', 'int32', 'int32'],
+                          ['bool', 'int64', 'int64'],
+                          ['bool', 'int8', 'int8'],
+                          ['bool', 'uint16', 'uint16'],
+                          ['bool', 'uint32', 'uint32'],
+                          ['bool', 'uint64', 'uint64'],
+                          ['bool', 'uint8', 'uint8']]},
+  'less_equal': { 'elementwise': True,
+                  'id': 10,
+                  'name': 'less_equal',
+                  'nop': 3,
+                  'type_sig': [ ['bool', 'bool', 'bool'],
+                                ['bool', 'float32', 'float32'],
+                                ['bool', 'float64', 'float64'],
+                                ['bool', 'int16', 'int16'],
+                                ['bool', 'int32', 'int32'],
+                                ['bool', 'int64', 'int64'],
+                                ['bool', 'int8', 'int8'],
+                                ['bool', 'uint16', 'uint16'],
+                                ['bool', 'uint32', 'uint32'],
+                                ['bool', 'uint64', 'uint64'],
+                                ['bool', 'uint8', 'uint8']]},
+  'log': { 'elementwise': True,
+           'id': 41,
+           'name': 'log',
+           'nop': 2,
+           'type_sig': [ ['complex128', 'complex128'],
+                         ['complex64', 'complex64'],
+                         ['float32', 'float32'],
+                         ['float64', 'float64']]},
+  'log10': { 'elementwise': True,
+             'id': 43,
+             'name': 'log10',
+             'nop': 2,
+             'type_sig': [ ['complex128', 'complex128'],
+                           ['complex64', 'complex64'],
+                           ['float32', 'float32'],
+                           ['float64', 'float64']]},
+  'log1p': { 'elementwise': True,
+             'id': 44,
+             'name': 'log1p',
+             'nop': 2,
+             'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'log2': { 'elementwise': True,
+            'id': 42,
+            'name': 'log2',
+            'nop': 2,
+            'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'logical_and': { 'elementwise': True,
+                   'id': 13,
+                   'name': 'logical_and',
+                   'nop': 3,
+                   'type_sig': [['bool', 'bool', 'bool']]},
+  'logical_and_reduce': { 'elementwise': False,
+                          'id': 63,
+                          'name': 'logical_and_reduce',
+                          'nop': 3,
+                          'type_sig': [['bool', 'bool', 'int64']]},
+  'logical_not': { 'elementwise': True,
+                   'id': 16,
+                   'name': 'logical_not',
+                   'nop': 2,
+                   'type_sig': [['bool', 'bool']]},
+  'logical_or': { 'elementwise': True,
+                  'id': 14,
+                  'name': 'logical_or',
+                  'nop': 3,
+                  'type_sig': [['bool', 'bool', 'bool']]},
+  'logical_or_reduce': { 'elementwise': False,
+                         'id': 65,
+                         'name': 'logical_or_reduce',
+                         'nop': 3,
+                         'type_sig': [['bool', 'bool', 'int64']]},
+  'logical_xor': { 'elementwise': True,
+                   'id': 15,
+                   'name': 'logical_xor',
+                   'nop': 3,
+                   'type_sig': [['bool', 'bool', 'bool']]},
+  'logical_xor_reduce': { 'elementwise': False,
+                          'id': 67,
+                          'name': 'logical_xor_reduce',
+                          'nop': 3,
+                          'type_sig': [['bool', 'bool', 'int64']]},
+  'maximum': { 'elementwise': True,
+               'id': 17,
+               'name': 'maximum',
+               'nop': 3,
+               'type_sig': [ ['bool', 'bool', 'bool'],
+                             ['float32', 'float32', 'float32'],
+                             ['float64', 'float64', 'float64'],
+                             ['int16', 'int16', 'int16'],
+                             ['int32', 'int32', 'int32'],
+                             ['int64', 'int64', 'int64'],
+                             ['int8', 'int8', 'int8'],
+                             ['uint16', 'uint16', 'uint16'],
+                             ['uint32', 'uint32', 'uint32'],
+                             ['uint64', 'uint64', 'uint64'],
+                             ['uint8', 'uint8', 'uint8']]},
+  'maximum_reduce': { 'elementwise': False,
+                      'id': 62,
+                      'name': 'maximum_reduce',
+                      'nop': 3,
+                      'type_sig': [ ['bool', 'bool', 'int64'],
+                                    ['float32', 'float32', 'int64'],
+                                    ['float64', 'float64', 'int64'],
+                                    ['int16', 'int16', 'int64'],
+                                    ['int32', 'int32', 'int64'],
+                                    ['int64', 'int64', 'int64'],
+                                    ['int8', 'int8', 'int64'],
+                                    ['uint16', 'uint16', 'int64'],
+                                    ['uint32', 'uint32', 'int64'],
+                                    ['uint64', 'uint64', 'int64'],
+                                    ['uint8', 'uint8', 'int64']]},
+  'minimum': { 'elementwise': True,
+               'id': 18,
+               'name': 'minimum',
+               'nop': 3,
+               'type_sig': [ ['bool', 'bool', 'bool'],
+                             ['float32', 'float32', 'float32'],
+                             ['float64', 'float64', 'float64'],
+                             ['int16', 'int16', 'int16'],
+                             ['int32', 'int32', 'int32'],
+                             ['int64', 'int64', 'int64'],
+                             ['int8', 'int8', 'int8'],
+                             ['uint16', 'uint16', 'uint16'],
+                             ['uint32', 'uint32', 'uint32'],
+                             ['uint64', 'uint64', 'uint64'],
+                             ['uint8', 'uint8', 'uint8']]},
+  'minimum_reduce': { 'elementwise': False,
+                      'id': 61,
+                      'name': 'minimum_reduce',
+                      'nop': 3,
+                      'type_sig': [ ['bool', 'bool', 'int64'],
+                                    ['float32', 'float32', 'int64'],
+                                    ['float64', 'float64', 'int64'],
+                                    ['int16', 'int16', 'int64'],
+                                    ['int32', 'int32', 'int64'],
+                                    ['int64', 'int64', 'int64'],
+                                    ['int8', 'int8', 'int64'],
+                                    ['uint16', 'uint16', 'int64'],
+                                    ['uint32', 'uint32', 'int64'],
+                                    ['uint64', 'uint64', 'int64'],
+                                    ['uint8', 'uint8', 'int64']]},
+  'mod': { 'elementwise': True,
+           'id': 50,
+           'name': 'mod',
+           'nop': 3,
+           'type_sig': [ ['float32', 'float32', 'float32'],
+                         ['float64', 'float64', 'float64'],
+                         ['int16', 'int16', 'int16'],
+                         ['int32', 'int32', 'int32'],
+                         ['int64', 'int64', 'int64'],
+                         ['int8', 'int8', 'int8'],
+                         ['uint16', 'uint16', 'uint16'],
+                         ['uint32', 'uint32', 'uint32'],
+                         ['uint64', 'uint64', 'uint64'],
+                         ['uint8', 'uint8', 'uint8']]},
+  'multiply': { 'elementwise': True,
+                'id': 3,
+                'name': 'multiply',
+                'nop': 3,
+                'type_sig': [ ['bool', 'bool', 'bool'],
+                              ['complex128', 'complex128', 'complex128'],
+                              ['complex64', 'complex64', 'complex64'],
+                              ['float32', 'float32', 'float32'],
+                              ['float64', 'float64', 'float64'],
+                              ['int16', 'int16', 'int16'],
+                              ['int32', 'int32', 'int32'],
+                              ['int64', 'int64', 'int64'],
+                              ['int8', 'int8', 'int8'],
+                              ['uint16', 'uint16', 'uint16'],
+                              ['uint32', 'uint32', 'uint32'],
+                              ['uint64', 'uint64', 'uint64'],
+                              ['uint8', 'uint8', 'uint8']]},
+  'multiply_accumulate': { 'elementwise': False,
+                           'id': 76,
+                           'name': 'multiply_accumulate',
+                           'nop': 3,
+                           'type_sig': [ ['complex128', 'complex128', 'int64'],
+                                         ['complex64', 'complex64', 'int64'],
+                                         ['float32', 'float32', 'int64'],
+                                         ['float64', 'float64', 'int64'],
+                                         ['int16', 'int16', 'int64'],
+                                         ['int32', 'int32', 'int64'],
+                                         ['int64', 'int64', 'int64'],
+                                         ['int8', 'int8', 'int64'],
+                                         ['uint16', 'uint16', 'int64'],
+                                         ['uint32', 'uint32', 'int64'],
+                                         ['uint64', 'uint64', 'int64'],
+                                         ['uint8', 'uint8', 'int64']]},
+  'multiply_reduce': { 'elementwise': False,
+                       'id': 60,
+                       'name': 'multiply_reduce',
+                       'nop': 3,
+                       'type_sig': [ ['complex128', 'complex128', 'int64'],
+                                     ['complex64', 'complex64', 'int64'],
+                                     ['float32', 'float32', 'int64'],
+                                     ['float64', 'float64', 'int64'],
+                                     ['int16', 'int16', 'int64'],
+                                     ['int32', 'int32', 'int64'],
+                                     ['int64', 'int64', 'int64'],
+                                     ['int8', 'int8', 'int64'],
+                                     ['uint16', 'uint16', 'int64'],
+                                     ['uint32', 'uint32', 'int64'],
+                                     ['uint64', 'uint64', 'int64'],
+                                     ['uint8', 'uint8', 'int64']]},
+  'not_equal': { 'elementwise': True,
+                 'id': 12,
+                 'name': 'not_equal',
+                 'nop': 3,
+                 'type_sig': [ ['bool', 'bool', 'bool'],
+                               ['bool', 'complex128', 'complex128'],
+                               ['bool', 'complex64', 'complex64'],
+                               ['bool', 'float32', 'float32'],
+                               ['bool', 'float64', 'float64'],
+                               ['bool', 'int16', 'int16'],
+                               ['bool', 'int32', 'int32'],
+                               ['bool', 'int64', 'int64'],
+                               ['bool', 'int8', 'int8'],
+                               ['bool', 'uint16', 'uint16'],
+                               ['bool', 'uint32', 'uint32'],
+                               ['bool', 'uint64', 'uint64'],
+                               ['bool', 'uint8', 'uint8']]},
+  'power': { 'elementwise': True,
+             'id': 5,
+             'name': 'power',
+             'nop': 3,
+             'type_sig': [ ['complex128', 'complex128', 'complex128'],
+                           ['complex64', 'complex64', 'complex64'],
+                           ['float32', 'float32', 'float32'],
+                           ['float64', 'float64', 'float64'],
+                           ['int16', 'int16', 'int16'],
+                           ['int32', 'int32', 'int32'],
+                           ['int64', 'int64', 'int64'],
+                           ['int8', 'int8', 'int8'],
+                           ['uint16', 'uint16', 'uint16'],
+                           ['uint32', 'uint32', 'uint32'],
+                           ['uint64', 'uint64', 'uint64'],
+                           ['uint8', 'uint8', 'uint8']]},
+  'random': { 'elementwise': False,
+              'id': 71,
+              'name': 'random',
+              'nop': 2,
+              'type_sig': [['uint64', 'r123']]},
+  'range': { 'elementwise': False,
+             'id': 72,
+             'name': 'range',
+             'nop': 1,
+             'type_sig': [['uint32'], ['uint64']]},
+  'real': { 'elementwise': True,
+            'id': 73,
+            'name': 'real',
+            'nop': 2,
+            'type_sig': [['float64', 'complex128'], ['float32', 'complex64']]},
+  'remainder': { 'elementwise': True,
+                 'id': 81,
+                 'name': 'remainder',
+                 'nop': 3,
+                 'type_sig': [ ['float32', 'float32', 'float32'],
+                               ['float64', 'float64', 'float64'],
+                               ['int16', 'int16', 'int16'],
+                               ['int32', 'int32', 'int32'],
+                               ['int64', 'int64', 'int64'],
+                               ['int8', 'int8', 'int8'],
+                               ['uint16', 'uint16', 'uint16'],
+                               ['uint32', 'uint32', 'uint32'],
+                               ['uint64', 'uint64', 'uint64'],
+                               ['uint8', 'uint8', 'uint8']]},
+  'right_shift': { 'elementwise': True,
+                   'id': 24,
+                   'name': 'right_shift',
+                   'nop': 3,
+                   'type_sig': [ ['int16', 'int16', 'int16'],
+                                 ['int32', 'int32', 'int32'],
+                                 ['int64', 'int64', 'int64'],
+                                 ['int8', 'int8', 'int8'],
+                                 ['uint16', 'uint16', 'uint16'],
+                                 ['uint32', 'uint32', 'uint32'],
+                                 ['uint64', 'uint64', 'uint64'],
+                                 ['uint8', 'uint8', 'uint8']]},
+  'rint': { 'elementwise': True,
+            'id': 49,
+            'name': 'rint',
+            'nop': 2,
+            'type_sig': [['float32', 'float32'], ['float64', 'float64']]},
+  'scatter': { 'elementwise': False,
+               'id': 80,
+               'name': 'scatter',
+               'nop': 3,
+               'type_sig': [ ['bool', 'bool', 'uint64'],
+                             ['complex128', 'complex128', 'uint64'],
+                             ['complex64', 'complex64', 'uint64'],
+                             ['float32', 'float32', 'uint64'],
+                             ['float64', 'float64', 'uint64'],
+                             ['int16', 'int16', 'uint64'],
+                             ['int32', 'int32', 'uint64'],
+                             ['int64', 'int64', 'uint64'],
+                             ['int8', 'int8', 'uint64'],
+                             ['uint16', 'uint16', 'uint64'],
+                             ['uint32', 'uint32', 'uint64'],
+                             ['uint64', 'uint64', 'uint64'],
+                             ['uint8', 'uint8', 'uint64']]},
+  'scatter_add': { 'elementwise': False,
+                   'id': 85,
+                   'name': 'scatter_add',
+                   'nop': 3,
+                   'type_sig': [ ['complex128', 'complex128', 'uint64'],
+                                 ['complex64', 'complex64', 'uint64'],
+                                 ['float32', 'float32', 'uint64'],
+                                 ['float64', 'float64', 'uint64'],
+                                 ['int16', 'int16', 'uint64'],
+                                 ['int32', 'int32', 'uint64'],
+                                 ['int64', 'int64', 'uint64'],
+                                 ['int8', 'int8', 'uint64'],
+                                 ['uint16', 'uint16', 'uint64'],
+                                 ['uint32', 'uint32', 'uint64'],
+                                 ['uint64', 'uint64', 'uint64'],
+                                 ['uint8', 'uint8', 'uint64']]},
+  'sign': { 'elementwise': True,
+            'id': 77,
+            'name': 'sign',
+            'nop': 2,
+            'type_sig': [ ['complex128', 'complex128'],
+                          ['complex64', 'complex64'],
+                          ['float32', 'float32'],
+                          ['float64', 'float64'],
+                          ['int16', 'int16'],
+                          ['int32', 'int32'],
+                          ['int64', 'int64'],
+                          ['int8', 'int8']]},
+  'sin': { 'elementwise': True,
+           'id': 26,
+           'name': 'sin',
+           'nop': 2,
+           'type_sig': [ ['complex128', 'complex128'],
+                         ['complex64', 'complex64'],
+                         ['float32', 'float32'],
+                         ['float64', 'float64']]},
+  'sinh': { 'elementwise': True,
+            'id': 29,
+            'name': 'sinh',
+            'nop': 2,
+            'type_sig': [ ['complex128', 'complex128'],
+                          ['complex64', 'complex64'],
+                          ['float32', 'float32'],
+                          ['float64', 'float64']]},
+  'sqrt': { 'elementwise': True,
+            'id': 45,
+            'name': 'sqrt',
+            'nop': 2,
+            'type_sig': [ ['complex128', 'complex128'],
+                          ['complex64', 'complex64'],
+                          ['float32', 'float32'],
+                          ['float64', 'float64']]},
+  'subtract': { 'elementwise': True,
+                'id': 2,
+                'name': 'subtract',
+                'nop': 3,
+                'type_sig': [ ['complex128', 'complex128', 'complex128'],
+                              ['complex64', 'complex64', 'complex64'],
+                              ['float32', 'float32', 'float32'],
+                              ['float64', 'float64', 'float64'],
+                              ['int16', 'int16', 'int16'],
+                              ['int32', 'int32', 'int32'],
+                              ['int64', 'int64', 'int64'],
+                              ['int8', 'int8', 'int8'],
+                              ['uint16', 'uint16', 'uint16'],
+                              ['uint32', 'uint32', 'uint32'],
+                              ['uint64', 'uint64', 'uint64'],
+                              ['uint8', 'uint8', 'uint8']]},
+  'tan': { 'elementwise': True,
+           'id': 27,
+           'name': 'tan',
+           'nop': 2,
+           'type_sig': [ ['complex128', 'complex128'],
+                         ['complex64', 'complex64'],
+                         ['float32', 'float32'],
+                         ['float64', 'float64']]},
+  'tanh': { 'elementwise': True,
+            'id': 30,
+            'name': 'tanh',
+            'nop': 2,
+            'type_sig': [ ['complex128', 'complex128'],
+                          ['complex64', 'complex64'],
+                          ['float32', 'float32'],
+                          ['float64', 'float64']]},
+  'trunc': { 'elementwise': True,
+             'id': 47,
+             'name': 'trunc',
+             'nop': 2,
+             'type_sig': [['float32', 'float32'], ['float64', 'float64']]}}
+def numpy_types():
+    import numpy
+    return [numpy.dtype('bool_'), numpy.dtype('int8'), numpy.dtype('int16'), numpy.dtype('int32'), numpy.dtype('int64'), numpy.dtype('uint8'), numpy.dtype('uint16'), numpy.dtype('uint32'), numpy.dtype('uint64'), numpy.dtype('float32'), numpy.dtype('float64'), numpy.dtype('complex64'), numpy.dtype('complex128')]
+
+    
\ No newline at end of file
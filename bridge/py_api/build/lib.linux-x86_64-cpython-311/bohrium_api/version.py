@@ -0,0 +1,2 @@
+__version__ = "0.10.1"
+__version_info__ = (0, 10, 1, 0)
@@ -59,6 +59,12 @@ static const char *BhAPI_message(const char *msg) {
     return bhc_message(msg);
 }
 
+/// Tag the following operations with the source location `filename:line` of the user program.
+/// Use NULL to stop tagging.
+static void BhAPI_set_source_location(const char *filename, int64_t line) {
+    bhc_set_source_location(filename, line);
+}
+
 /// Get the device context, such as OpenCL's cl_context, of the first VE in the runtime stack.
 /// If the first VE isn't a device, NULL is returned.
 static void* BhAPI_getDeviceContext(void) {
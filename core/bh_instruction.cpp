@@ -83,7 +83,7 @@ BhIntVec bh_instruction::shape() const {
         assert(not operand[2].isConstant());
         const bh_view &view = operand[2];
         return view.shape;
-    } else if (opcode == BH_SCATTER or opcode == BH_COND_SCATTER) {
+    } else if (opcode == BH_SCATTER or opcode == BH_COND_SCATTER or opcode == BH_SCATTER_ADD) {
         // The principal shape of a scatter is the shape of the index and input array, which are equal.
         assert(operand.size() >= 3);
         assert(not operand[1].isConstant());
@@ -155,7 +155,7 @@ void bh_instruction::remove_axis(int64_t axis) {
         }
 
         // Ignore scatter's output operand, which is allowed any shape
-        if (opcode == BH_SCATTER or opcode == BH_COND_SCATTER) {
+        if (opcode == BH_SCATTER or opcode == BH_COND_SCATTER or opcode == BH_SCATTER_ADD) {
             return;
         }
 
@@ -195,7 +195,7 @@ void bh_instruction::transpose(int64_t axis1, int64_t axis2) {
         }
 
         // The output array of scatter is has arbitrary shape and stride
-        if (opcode == BH_SCATTER or opcode == BH_COND_SCATTER) {
+        if (opcode == BH_SCATTER or opcode == BH_COND_SCATTER or opcode == BH_SCATTER_ADD) {
             return;
         }
 
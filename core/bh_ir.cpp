@@ -18,137 +18,351 @@ GNU Lesser General Public License along with Bohrium.
 If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <boost/archive/binary_oarchive.hpp>
-#include <boost/archive/binary_iarchive.hpp>
-#include <boost/iostreams/stream_buffer.hpp>
-#include <boost/iostreams/stream.hpp>
-#include <boost/iostreams/device/back_inserter.hpp>
-#include <boost/serialization/vector.hpp>
-#include <boost/serialization/set.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
 
 #include <bh_ir.hpp>
 #include <bh_util.hpp>
 
 using namespace std;
-using namespace boost;
-namespace io = boost::iostreams;
 
+namespace {
 
-BhIR::BhIR(const std::vector<char> &serialized_archive, std::map<const bh_base*, bh_base> &remote2local,
-           vector<bh_base*> &data_recv, set<bh_base*> &frees) {
+/* The serialization format of a BhIR, which starts with the magic bytes "BhIR" and the format version.
+ * All integers are varints (signed integers are zigzag encoded) and the base arrays and views are interned:
+ *
+ *   nrepeats
+ *   base table:  count, {remote base pointer, flag (0: known, 1: new, 2: new with data), [type byte, nelem]}
+ *   view table:  count, {base index, start, ndim, shape..., stride..., has slides, [slides]}
+ *   instructions: count, {opcode, noperands, {view index + 1 or 0 for a constant}..., constant type, value bytes,
+ *                         source id}
+ *   syncs:        count, {base index}...
+ *   repeat condition: base index + 1 or 0 for none
+ */
+const char format_magic[] = {'B', 'h', 'I', 'R'};
+constexpr uint64_t format_version = 2;
 
-    // Wrap 'serialized_archive' in an input stream
-    iostreams::basic_array_source<char> source(&serialized_archive[0], serialized_archive.size());
-    iostreams::stream<iostreams::basic_array_source<char> > input_stream(source);
-    archive::binary_iarchive ia(input_stream);
+// Appends varints and bytes to a byte vector
+class Writer {
+    vector<char> &_out;
+public:
+    explicit Writer(vector<char> &out) : _out(out) {}
 
-    // Load number of repeats and the repeat condition
-    ia >> _nrepeats;
-    {
-        size_t t;
-        ia >> t;
-        _repeat_condition = reinterpret_cast<bh_base*>(t);
+    void byte(uint8_t value) {
+        _out.push_back(static_cast<char>(value));
     }
 
-    // Load the instruction list
-    ia >> instr_list;
-
-    // Load the set of syncs
-    {
-        vector<size_t> base_as_int;
-        ia >> base_as_int;
-        for(size_t base: base_as_int) {
-            _syncs.insert(reinterpret_cast<bh_base*>(base));
+    void uvarint(uint64_t value) {
+        while (value >= 0x80) {
+            byte(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
         }
+        byte(static_cast<uint8_t>(value));
     }
 
-    // Load the new base arrays
-    std::vector<bh_base> news;
-    ia >> news;
+    void svarint(int64_t value) {
+        uvarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
 
-    // Find all freed base arrays (remote base pointers)
-    for (const bh_instruction &instr: instr_list) {
-        if (instr.opcode == BH_FREE) {
-            frees.insert(instr.operand[0].base);
+    void bytes(const void *data, size_t nbytes) {
+        const char *p = static_cast<const char *>(data);
+        _out.insert(_out.end(), p, p + nbytes);
+    }
+};
+
+// Reads varints and bytes directly from a serialized buffer
+class Reader {
+    const char *_pos;
+    const char *_end;
+public:
+    Reader(const char *begin, const char *end) : _pos(begin), _end(end) {}
+
+    uint8_t byte() {
+        if (_pos == _end) {
+            throw runtime_error("BhIR: the serialized archive is truncated");
         }
+        return static_cast<uint8_t>(*_pos++);
     }
 
-    // Add the new base array to 'remote2local' and to 'data_recv'
-    size_t new_base_count = 0;
-    for (const bh_instruction &instr: instr_list) {
-        for (const bh_view &v: instr.getViews()) {
-            if (not util::exist(remote2local, v.base)) {
-                assert(new_base_count < news.size());
-                remote2local.emplace(v.base, news.at(new_base_count++));
-                if (remote2local.at(v.base).getDataPtr() != nullptr)
-                    data_recv.push_back(&remote2local.at(v.base));
+    uint64_t uvarint() {
+        uint64_t ret = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7) {
+            const uint8_t b = byte();
+            ret |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) {
+                return ret;
             }
         }
+        throw runtime_error("BhIR: malformed varint in the serialized archive");
     }
-    assert(new_base_count == news.size());
 
-    // Update all base pointers to point to the local bases
-    for (bh_instruction &instr: instr_list) {
-        for (bh_view &v: instr.getViews()) {
-            v.base = &remote2local.at(v.base);
-        }
+    int64_t svarint() {
+        const uint64_t value = uvarint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
     }
-    // Update all base pointers in the bhir's `_syncs` set
-    {
-        set<bh_base*> syncs_as_local_ptr;
-        for (bh_base *base: _syncs) {
-            if (util::exist(remote2local, base)) {
-                syncs_as_local_ptr.insert(&remote2local.at(base));
-            }
+
+    void bytes(void *dest, size_t nbytes) {
+        if (nbytes > static_cast<size_t>(_end - _pos)) {
+            throw runtime_error("BhIR: the serialized archive is truncated");
         }
-        _syncs = std::move(syncs_as_local_ptr);
+        memcpy(dest, _pos, nbytes);
+        _pos += nbytes;
     }
-    // Update the `_repeat_condition` pointer
-    if (_repeat_condition != nullptr) {
-        _repeat_condition = &remote2local.at(_repeat_condition);
+
+    bool done() const {
+        return _pos == _end;
     }
+};
 
+void write_view(Writer &w, const bh_view &view, uint64_t base_index) {
+    w.uvarint(base_index);
+    w.svarint(view.start);
+    w.uvarint(static_cast<uint64_t>(view.ndim));
+    for (int64_t i = 0; i < view.ndim; ++i) {
+        w.svarint(view.shape[i]);
+    }
+    for (int64_t i = 0; i < view.ndim; ++i) {
+        w.svarint(view.stride[i]);
+    }
+    const bh_slide &slides = view.slides;
+    const bool has_slides = not slides.dims.empty() or slides.iteration_counter != 0 or not slides.resets.empty();
+    w.byte(has_slides);
+    if (has_slides) {
+        w.uvarint(slides.dims.size());
+        for (const bh_slide_dim &dim: slides.dims) {
+            w.svarint(dim.rank);
+            w.svarint(dim.offset_change);
+            w.svarint(dim.shape_change);
+            w.svarint(dim.stride);
+            w.svarint(dim.shape);
+            w.svarint(dim.step_delay);
+        }
+        w.svarint(slides.iteration_counter);
+        w.uvarint(slides.resets.size());
+        for (const auto &reset: slides.resets) {
+            w.svarint(reset.first);
+            w.svarint(reset.second.first);
+            w.svarint(reset.second.second);
+        }
+    }
 }
 
-std::vector<char> BhIR::writeSerializedArchive(set<bh_base *> &known_base_arrays, vector<bh_base *> &new_data) {
+// Read a view written by `write_view()`, which returns the base index through `base_index`
+bh_view read_view(Reader &r, uint64_t &base_index) {
+    bh_view view;
+    base_index = r.uvarint();
+    view.start = r.svarint();
+    view.ndim = static_cast<int64_t>(r.uvarint());
+    if (view.ndim > BH_MAXDIM) {
+        throw runtime_error("BhIR: view in the serialized archive has too many dimensions");
+    }
+    view.shape.resize(static_cast<size_t>(view.ndim));
+    view.stride.resize(static_cast<size_t>(view.ndim));
+    for (int64_t i = 0; i < view.ndim; ++i) {
+        view.shape[i] = r.svarint();
+    }
+    for (int64_t i = 0; i < view.ndim; ++i) {
+        view.stride[i] = r.svarint();
+    }
+    if (r.byte() != 0) {
+        bh_slide &slides = view.slides;
+        slides.dims.resize(r.uvarint());
+        for (bh_slide_dim &dim: slides.dims) {
+            dim.rank = r.svarint();
+            dim.offset_change = r.svarint();
+            dim.shape_change = r.svarint();
+            dim.stride = r.svarint();
+            dim.shape = r.svarint();
+            dim.step_delay = r.svarint();
+        }
+        slides.iteration_counter = r.svarint();
+        const uint64_t nresets = r.uvarint();
+        for (uint64_t i = 0; i < nresets; ++i) {
+            const int64_t dim = r.svarint();
+            const int64_t first = r.svarint();
+            slides.resets[dim] = make_pair(first, r.svarint());
+        }
+    }
+    return view;
+}
+}
+
+BhIR::BhIR(const std::vector<char> &serialized_archive, std::map<const bh_base*, bh_base> &remote2local,
+           vector<bh_base*> &data_recv, set<bh_base*> &frees) {
+
+    // We parse the archive in-place
+    Reader r(serialized_archive.data(), serialized_archive.data() + serialized_archive.size());
+    char magic[sizeof(format_magic)];
+    r.bytes(magic, sizeof(magic));
+    if (memcmp(magic, format_magic, sizeof(magic)) != 0 or r.uvarint() != format_version) {
+        throw runtime_error("BhIR: unsupported serialized archive (version mismatch between the two ends?)");
+    }
+    _nrepeats = r.uvarint();
+
+    // Load the base table and add the new base arrays to 'remote2local' and to 'data_recv'
+    const uint64_t nbases = r.uvarint();
+    vector<const bh_base *> remotes(nbases);
+    vector<bh_base *> bases(nbases); // The local base arrays, which are NULL when unknown
+    for (uint64_t i = 0; i < nbases; ++i) {
+        remotes[i] = reinterpret_cast<const bh_base *>(r.uvarint());
+        const uint8_t flag = r.byte();
+        if (flag != 0) {
+            const auto type = static_cast<bh_type>(r.byte());
+            const auto nelem = static_cast<int64_t>(r.uvarint());
+            auto it = remote2local.emplace(remotes[i], bh_base(nelem, type));
+            if (not it.second) {
+                throw runtime_error("BhIR: the serialized archive has a new base array that is already known");
+            }
+            bases[i] = &it.first->second;
+            if (flag == 2) {
+                data_recv.push_back(bases[i]);
+            }
+        } else {
+            auto it = remote2local.find(remotes[i]);
+            bases[i] = it == remote2local.end() ? nullptr : &it->second;
+        }
+    }
+    auto local_base = [&](uint64_t index) -> bh_base * {
+        if (index >= nbases or bases[index] == nullptr) {
+            throw runtime_error("BhIR: the serialized archive refers to an unknown base array");
+        }
+        return bases[index];
+    };
+
+    // Load the view table
+    const uint64_t nviews = r.uvarint();
+    vector<bh_view> views(nviews);
+    vector<uint64_t> view_base_index(nviews);
+    for (uint64_t i = 0; i < nviews; ++i) {
+        views[i] = read_view(r, view_base_index[i]);
+        views[i].base = local_base(view_base_index[i]);
+    }
 
-    // Find new base arrays in 'bhir', which the de-serializing component should know about, and their data (if any)
-    vector<bh_base> new_bases; // New base arrays in the order they appear in the instruction list
+    // Load the instruction list and find all freed base arrays (remote base pointers)
+    instr_list.resize(r.uvarint());
     for (bh_instruction &instr: instr_list) {
-        for (const bh_view &v: instr.getViews()) {
-            if (not util::exist(known_base_arrays, v.base)) {
-                new_bases.push_back(*v.base);
-                known_base_arrays.insert(v.base);
-                if (v.base->getDataPtr() != nullptr) {
-                    new_data.push_back(v.base);
+        instr.opcode = static_cast<bh_opcode>(r.uvarint());
+        instr.operand.resize(r.uvarint());
+        for (bh_view &operand: instr.operand) {
+            const uint64_t id = r.uvarint();
+            if (id > nviews) {
+                throw runtime_error("BhIR: the serialized archive refers to an unknown view");
+            }
+            if (id > 0) {
+                operand = views[id - 1];
+                if (instr.opcode == BH_FREE) {
+                    frees.insert(const_cast<bh_base *>(remotes[view_base_index[id - 1]]));
                 }
             }
         }
+        instr.constant.type = static_cast<bh_type>(r.byte());
+        r.bytes(&instr.constant.value, static_cast<size_t>(bh_type_size(instr.constant.type)));
+        instr.source_id = r.svarint();
     }
 
-    // Wrap 'ret' in an output stream
-    std::vector<char> ret;
-    iostreams::stream<iostreams::back_insert_device<vector<char> > > output_stream(ret);
-    archive::binary_oarchive oa(output_stream);
+    // Load the set of syncs
+    const uint64_t nsyncs = r.uvarint();
+    for (uint64_t i = 0; i < nsyncs; ++i) {
+        _syncs.insert(local_base(r.uvarint()));
+    }
 
-    // Write number of repeats and the repeat condition
-    oa << _nrepeats;
-    if (_repeat_condition != nullptr and util::exist(known_base_arrays, _repeat_condition)) {
-        size_t t = reinterpret_cast<size_t >(_repeat_condition);
-        oa << t;
-    } else {
-        size_t t = 0;
-        oa << t;
+    // Load the repeat condition
+    const uint64_t repeat_condition = r.uvarint();
+    _repeat_condition = repeat_condition == 0 ? nullptr : local_base(repeat_condition - 1);
+
+    if (not r.done()) {
+        throw runtime_error("BhIR: the serialized archive has trailing bytes");
     }
+}
+
+std::vector<char> BhIR::writeSerializedArchive(set<bh_base *> &known_base_arrays, vector<bh_base *> &new_data) {
+
+    // Intern the base arrays. New base arrays, which the de-serializing component should know about, and their
+    // data (if any) are found in the order they appear in the instruction list.
+    std::map<const bh_base *, uint64_t> base_index;
+    vector<char> base_table;
+    Writer base_writer(base_table);
+    auto intern_base = [&](bh_base *base) -> uint64_t {
+        auto it = base_index.find(base);
+        if (it != base_index.end()) {
+            return it->second;
+        }
+        const uint64_t index = base_index.size();
+        base_index.emplace(base, index);
+        base_writer.uvarint(reinterpret_cast<uint64_t>(base));
+        if (util::exist(known_base_arrays, base)) {
+            base_writer.byte(0);
+        } else {
+            known_base_arrays.insert(base);
+            const bool has_data = base->getDataPtr() != nullptr;
+            base_writer.byte(has_data ? 2 : 1);
+            base_writer.byte(static_cast<uint8_t>(base->dtype()));
+            base_writer.uvarint(static_cast<uint64_t>(base->nelem()));
+            if (has_data) {
+                new_data.push_back(base);
+            }
+        }
+        return index;
+    };
+
+    // Intern the views, which are identified by their encoding
+    std::unordered_map<string, uint64_t> view_index;
+    vector<char> view_table;
+    auto intern_view = [&](const bh_view &view) -> uint64_t {
+        vector<char> encoding;
+        Writer view_writer(encoding);
+        write_view(view_writer, view, intern_base(view.base));
+        auto it = view_index.emplace(string(encoding.begin(), encoding.end()), view_index.size());
+        if (it.second) {
+            view_table.insert(view_table.end(), encoding.begin(), encoding.end());
+        }
+        return it.first->second;
+    };
 
     // Write the instruction list
-    oa << instr_list;
+    vector<char> instructions;
+    Writer instr_writer(instructions);
+    instr_writer.uvarint(instr_list.size());
+    for (const bh_instruction &instr: instr_list) {
+        instr_writer.uvarint(static_cast<uint64_t>(instr.opcode));
+        instr_writer.uvarint(instr.operand.size());
+        for (const bh_view &operand: instr.operand) {
+            instr_writer.uvarint(operand.isConstant() ? 0 : intern_view(operand) + 1);
+        }
+        instr_writer.byte(static_cast<uint8_t>(instr.constant.type));
+        instr_writer.bytes(&instr.constant.value, static_cast<size_t>(bh_type_size(instr.constant.type)));
+        instr_writer.svarint(instr.source_id);
+    }
 
-    vector<size_t> base_as_int;
-    for(bh_base *base: _syncs) {
-        base_as_int.push_back(reinterpret_cast<size_t>(base));
+    // Write the syncs and the repeat condition, which the de-serializing component ignores when unknown
+    vector<uint64_t> syncs;
+    for (bh_base *base: _syncs) {
+        if (util::exist(known_base_arrays, base)) {
+            syncs.push_back(intern_base(base));
+        }
+    }
+    instr_writer.uvarint(syncs.size());
+    for (uint64_t index: syncs) {
+        instr_writer.uvarint(index);
     }
-    oa << base_as_int;
-    oa << new_bases;
+    if (_repeat_condition != nullptr and util::exist(known_base_arrays, _repeat_condition)) {
+        instr_writer.uvarint(intern_base(_repeat_condition) + 1);
+    } else {
+        instr_writer.uvarint(0);
+    }
+
+    // Concatenate the header, the tables, and the instructions
+    vector<char> ret;
+    ret.reserve(16 + base_table.size() + view_table.size() + instructions.size());
+    Writer w(ret);
+    w.bytes(format_magic, sizeof(format_magic));
+    w.uvarint(format_version);
+    w.uvarint(_nrepeats);
+    w.uvarint(base_index.size());
+    w.bytes(base_table.data(), base_table.size());
+    w.uvarint(view_index.size());
+    w.bytes(view_table.data(), view_table.size());
+    w.bytes(instructions.data(), instructions.size());
     return ret;
 }
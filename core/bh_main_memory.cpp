@@ -22,6 +22,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <bh_malloc_cache.hpp>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <mutex>
 
 #if defined(__APPLE__) || defined(__MACOSX)
 #include <sys/sysctl.h>
@@ -72,26 +73,51 @@ void main_mem_free(void *mem, uint64_t nbytes) {
 }
 
 MallocCache malloc_cache(main_mem_malloc, main_mem_free, 0);
+// Guards `malloc_cache` since components such as the proxy allocate memory from multiple threads
+std::mutex malloc_cache_mutex;
 }
 
 void bh_data_malloc(bh_base *base) {
     if (base == nullptr) return;
     if (base->getDataPtr() != nullptr) return;
+    std::lock_guard<std::mutex> lock(malloc_cache_mutex);
     base->resetDataPtr(malloc_cache.alloc(base->nbytes()));
 }
 
 void bh_data_free(bh_base *base) {
     if (base == nullptr) return;
     if (base->getDataPtr() == nullptr) return;
+    std::lock_guard<std::mutex> lock(malloc_cache_mutex);
     malloc_cache.free(base->nbytes(), base->getDataPtr());
     base->resetDataPtr();
 }
 
+void bh_data_adopt(bh_base *base, void *mem) {
+    assert(base != nullptr);
+    assert(base->getDataPtr() == nullptr);
+    std::lock_guard<std::mutex> lock(malloc_cache_mutex);
+    malloc_cache.adopt(base->nbytes(), mem);
+    base->resetDataPtr(mem);
+}
+
+void *bh_memory_malloc(uint64_t nbytes) {
+    std::lock_guard<std::mutex> lock(malloc_cache_mutex);
+    return malloc_cache.alloc(nbytes);
+}
+
+void bh_memory_free(void *mem, uint64_t nbytes) {
+    if (mem == nullptr) return;
+    std::lock_guard<std::mutex> lock(malloc_cache_mutex);
+    malloc_cache.free(nbytes, mem);
+}
+
 void bh_set_malloc_cache_limit(uint64_t nbytes) {
+    std::lock_guard<std::mutex> lock(malloc_cache_mutex);
     malloc_cache.setLimit(nbytes);
 }
 
 void bh_get_malloc_cache_stat(uint64_t &cache_lookup, uint64_t &cache_misses, uint64_t &max_memory_usage) {
+    std::lock_guard<std::mutex> lock(malloc_cache_mutex);
     cache_lookup = malloc_cache.getTotalNumLookups();
     cache_misses = malloc_cache.getTotalNumMisses();
     max_memory_usage = malloc_cache.getMaxMemAllocated();
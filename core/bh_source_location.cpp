@@ -0,0 +1,54 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include <utility>
+
+#include <bh_source_location.hpp>
+
+using namespace std;
+
+namespace {
+mutex registry_mutex;
+map<pair<string, int64_t>, int64_t> registry_ids;
+vector<string> registry_names; // Indexed by id
+}
+
+int64_t bh_source_location_id(const string &filename, int64_t line) {
+    lock_guard<mutex> lock(registry_mutex);
+    const auto it = registry_ids.find(make_pair(filename, line));
+    if (it != registry_ids.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<int64_t>(registry_names.size());
+    registry_ids.insert(make_pair(make_pair(filename, line), id));
+    registry_names.push_back(filename + ":" + to_string(line));
+    return id;
+}
+
+string bh_source_location_name(int64_t id) {
+    lock_guard<mutex> lock(registry_mutex);
+    if (id >= 0 and id < static_cast<int64_t>(registry_names.size())) {
+        return registry_names[id];
+    }
+    return "#" + to_string(id);
+}
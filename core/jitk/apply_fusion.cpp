@@ -102,6 +102,7 @@ void add_identity_block(LoopB &loop, int64_t &origin_count) {
             identity_instr.operand[1].base = nullptr;
             identity_instr.constant = sweep_identity(sweep_instr->opcode, sweep_instr->operand[0].base->dtype());
             identity_instr.origin_id = origin_count++;
+            identity_instr.source_id = sweep_instr->source_id;
             identity_instr.constructor = sweep_instr->constructor;
             // We have to manually set the sweep axis of an accumulate output to 1. The backend will execute
             // the for-loop in serial thus only the first element should be the identity.
@@ -147,6 +148,7 @@ vector<LoopB> add_identity_block(vector<Block> &block_list, int64_t &origin_coun
             identity_instr.operand[1].base = nullptr;
             identity_instr.constant = sweep_identity(sweep_instr->opcode, sweep_instr->operand[0].base->dtype());
             identity_instr.origin_id = origin_count++;
+            identity_instr.source_id = sweep_instr->source_id;
             identity_instr.constructor = sweep_instr->constructor;
             // We have to manually set the sweep axis of an accumulate output to 1. The backend will execute
             // the for-loop in serial thus only the first element should be the identity.
@@ -190,9 +192,12 @@ vector<Block> get_block_list(const vector<bh_instruction*> &instr_list, const Co
         stat.num_blocks_out_of_fuser += block_list.size();
         const auto tfusion = chrono::steady_clock::now();
         stat.time_pre_fusion += tfusion - tpre_fusion;
+        stat.tracer->record("pre-fusion", "fusion", tpre_fusion, tfusion, 0, instr_list.size());
         // Then we fuse fully
         apply_transformers(config, block_list, config.defaultGetList("fuser_list", {"greedy"}), avoid_rank0_sweep);
-        stat.time_fusion += chrono::steady_clock::now() - tfusion;
+        const auto tend = chrono::steady_clock::now();
+        stat.time_fusion += tend - tfusion;
+        stat.tracer->record("fusion", "fusion", tfusion, tend, 0, block_list.size());
         fcache.insert(instr_list, block_list);
     }
 
@@ -547,14 +547,14 @@ bool data_parallel_compatible(const InstrPtr a, const InstrPtr b) {
     }
 
     // Scatter writes in arbitrary order
-    if (a->opcode == BH_SCATTER or a->opcode == BH_COND_SCATTER) {
+    if (a->opcode == BH_SCATTER or a->opcode == BH_COND_SCATTER or a->opcode == BH_SCATTER_ADD) {
 
         for (size_t i = 0; i < b->operand.size(); ++i) {
             if ((not b->operand[i].isConstant()) and a->operand[0].base == b->operand[i].base) {
                 return false;
             }
         }
-    } else if (b->opcode == BH_SCATTER or b->opcode == BH_COND_SCATTER) {
+    } else if (b->opcode == BH_SCATTER or b->opcode == BH_COND_SCATTER or b->opcode == BH_SCATTER_ADD) {
         for (size_t i = 0; i < a->operand.size(); ++i) {
             if ((not a->operand[i].isConstant()) and b->operand[0].base == a->operand[i].base) {
                 return false;
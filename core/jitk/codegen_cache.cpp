@@ -36,6 +36,9 @@ namespace {
 void hash_stream(const bh_view &view, const SymbolTable &symbols, std::stringstream &ss) {
     ss << "dtype: " << static_cast<uint32_t>(view.base->dtype());
     ss << "baseid: " << symbols.baseID(view.base);
+    if (symbols.isStreamingStore(view.base)) {
+        ss << "streaming-store: ";
+    }
 
     if (symbols.strides_as_var) {
         ss << "strideid: " << symbols.offsetStridesID(view);
@@ -74,6 +77,9 @@ void hash_stream(const bh_instruction &instr, const SymbolTable &symbols, std::s
         }
     }
     ss << "sweep: " << instr.sweep_axis();
+    if (instr.opcode == BH_SCATTER_ADD and symbols.isPrivatized(instr.operand[0].base)) {
+        ss << "privatized: "; // NB: the number of elements is an argument of the kernel
+    }
 }
 
 /* The Block hash consists of the following fields:
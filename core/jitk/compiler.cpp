@@ -20,15 +20,116 @@ If not, see <http://www.gnu.org/licenses/>.
 
 #include <sstream>
 #include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
 #include <boost/algorithm/string/replace.hpp>
 
 #include <jitk/compiler.hpp>
 
 using namespace std;
 
+extern char **environ;
+
 namespace bohrium {
 namespace jitk {
 
+namespace {
+/* Execute `cmd` by the shell with `input` piped into its stdin and return its resource usage, which includes the
+ * processes it waited for, e.g. the compiler driver waits for the compiler proper, the assembler, and the linker.
+ * NB: like popen(), we use posix_spawn(), which unlike fork() is cheap even when this process is large.
+ *     Also like popen(), the pipe is close-on-exec, thus processes spawned concurrently by other threads cannot
+ *     inherit its write end, which would keep the command from ever seeing EOF.
+ *
+ * Throws runtime_error when the command fails
+ */
+CompilerUsage execute(const string &cmd, const char *input, size_t input_len) {
+    int fds[2];
+#ifdef __linux__
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        perror("pipe2()");
+        throw runtime_error("Compiler: pipe2() failed");
+    }
+#else
+    // NB: without pipe2(), a process spawned by another thread between pipe() and fcntl() may still inherit the pipe
+    if (pipe(fds) != 0) {
+        perror("pipe()");
+        throw runtime_error("Compiler: pipe() failed");
+    }
+    if (fcntl(fds[0], F_SETFD, FD_CLOEXEC) != 0 or fcntl(fds[1], F_SETFD, FD_CLOEXEC) != 0) {
+        perror("fcntl()");
+        close(fds[0]);
+        close(fds[1]);
+        throw runtime_error("Compiler: fcntl() failed");
+    }
+#endif
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[0], STDIN_FILENO);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+    posix_spawn_file_actions_addclose(&actions, fds[1]);
+    const char *argv[] = {"sh", "-c", cmd.c_str(), nullptr};
+    pid_t pid;
+    const int spawn_res = posix_spawn(&pid, "/bin/sh", &actions, nullptr, const_cast<char **>(argv), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[0]);
+    if (spawn_res != 0) {
+        close(fds[1]);
+        fprintf(stderr, "posix_spawn() failed for [%s]: %s\n", cmd.c_str(), strerror(spawn_res));
+        throw runtime_error("Compiler: posix_spawn() failed");
+    }
+
+    // Write / pipe to stdin
+    size_t written = 0;
+    while (written < input_len) {
+        const ssize_t res = write(fds[1], input + written, input_len - written);
+        if (res < 0 and errno == EINTR) {
+            continue;
+        }
+        if (res < 0) {
+            perror("write()");
+            break;
+        }
+        written += static_cast<size_t>(res);
+    }
+    close(fds[1]);
+
+    int status;
+    struct rusage usage;
+    while (wait4(pid, &status, 0, &usage) < 0) {
+        if (errno != EINTR) {
+            perror("wait4()");
+            throw runtime_error("Compiler: wait4() failed");
+        }
+    }
+    if (written < input_len) {
+        throw runtime_error("Compiler: write() failed");
+    }
+    if (not WIFEXITED(status)) {
+        fprintf(stderr, "compile command killed by signal %d: [%s]\n", WTERMSIG(status), cmd.c_str());
+        throw runtime_error("Compiler: the compile command failed");
+    }
+    if (WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "compile command exited with %d: [%s]\n", WEXITSTATUS(status), cmd.c_str());
+        throw runtime_error("Compiler: the compile command failed");
+    }
+
+    CompilerUsage ret;
+    ret.cpu_time = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+                   usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+#if defined(__APPLE__) || defined(__MACOSX)
+    ret.max_rss = static_cast<uint64_t>(usage.ru_maxrss); // macOS reports bytes
+#else
+    ret.max_rss = static_cast<uint64_t>(usage.ru_maxrss) * 1024; // Linux reports kilobytes
+#endif
+    return ret;
+}
+}
+
 string expand_compile_cmd(const string &cmd_template, const string &out, const string &in, const string &config_path) {
     string ret = cmd_template;
     boost::replace_all(ret, "{OUT}", out);
@@ -41,63 +142,20 @@ Compiler::Compiler(string cmd_template, string config_path, bool verbose) : cmd_
                                                                             verbose(verbose) {}
 
 
-void Compiler::compile(string object_abspath, const char* sourcecode, size_t source_len) const {
+CompilerUsage Compiler::compile(string object_abspath, const char* sourcecode, size_t source_len) const {
     const string cmd = expand_compile_cmd(cmd_template, object_abspath, " - ", config_path);
     if (verbose) {
         cout << "compile command: " << cmd << endl;
     }
-
-    FILE* cmd_stdin = popen(cmd.c_str(), "w");  // Open process and get stdin stream
-    if (!cmd_stdin) {
-        perror("popen()");
-        fprintf(stderr, "popen() failed for: [%s]", sourcecode);
-        throw runtime_error("Compiler: popen() failed");
-    }
-                                                // Write / pipe to stdin
-    int write_res = fwrite(sourcecode, sizeof(char), source_len, cmd_stdin);
-    if (write_res < (int)source_len) {
-        perror("fwrite()");
-        fprintf(stderr, "fwrite() failed in file %s at line # %d\n", __FILE__, __LINE__-5);
-        pclose(cmd_stdin);
-        throw runtime_error("Compiler: error!");
-    }
-
-    int flush_res = fflush(cmd_stdin);          // Flush stdin
-    if (EOF == flush_res) {
-        perror("fflush()");
-        fprintf(stderr, "fflush() failed in file %s at line # %d\n", __FILE__, __LINE__-5);
-        pclose(cmd_stdin);
-        throw runtime_error("Compiler: fflush() failed");
-    }
-
-    int exit_code = (pclose(cmd_stdin)/256);
-    if (0!=exit_code) {
-        perror("pclose()");
-        fprintf(stderr, "pclose() failed.\n");
-        throw runtime_error("Compiler: pclose() failed");
-    }
+    return execute(cmd, sourcecode, source_len);
 }
 
-void Compiler::compile(string object_abspath, string src_abspath) const {
+CompilerUsage Compiler::compile(string object_abspath, string src_abspath) const {
     const string cmd = expand_compile_cmd(cmd_template, object_abspath, src_abspath, config_path);
     if (verbose) {
         cout << "compile command: " << cmd << endl;
     }
-
-    // Execute the process
-    FILE *cmd_stdin = NULL;                     // Handle for library-file
-    cmd_stdin = popen(cmd.c_str(), "w");        // Execute the command
-    if (!cmd_stdin) {
-        std::cout << "Err: Could not execute process! ["<< cmd <<"]" << std::endl;
-        throw runtime_error("Compiler: error!");
-    }
-    fflush(cmd_stdin);
-    int exit_code = (pclose(cmd_stdin)/256);
-    if (0!=exit_code) {
-        perror("pclose()");
-        fprintf(stderr, "pclose() failed.\n");
-        throw runtime_error("Compiler: pclose() failed");
-    }
+    return execute(cmd, nullptr, 0);
 }
 
 }}
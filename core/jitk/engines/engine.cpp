@@ -64,6 +64,10 @@ void Engine::writeKernelFunctionArguments(const jitk::SymbolTable &symbols,
         }
     }
 
+    for (const bh_base *base: symbols.privatizedScatterAdds()) {
+        stmp << "const " << writeType(bh_type::UINT64) << " n" << symbols.baseID(base) << ", ";
+    }
+
     if (not symbols.constIDs().empty()) {
         for (auto it = symbols.constIDs().begin(); it != symbols.constIDs().end(); ++it) {
             const InstrPtr &instr = *it;
@@ -199,6 +203,21 @@ void Engine::writeBlock(const SymbolTable &symbols,
         }
     }
 
+    // Declare scalar-replacement of outputs written using non-temporal stores
+    if (kernel.rank >= 0 and symbols.useStreamingStores()) {
+        for (const InstrPtr &instr: iterator::allLocalInstr(kernel)) {
+            if (not instr->operand.empty()) {
+                const bh_view &view = instr->operand[0];
+                if (symbols.isStreamingStore(view.base) and not scope.isDeclared(view)) {
+                    scope.insertScalarReplaced(view);
+                    util::spaces(out, 8 + kernel.rank * 4);
+                    scope.writeDeclaration(view, writeType(view.base->dtype()), out);
+                    out << "// For non-temporal store\n";
+                }
+            }
+        }
+    }
+
     // Write the for-loop body
     for (const Block &b: kernel._block_list) {
         if (b.isInstr()) { // Finally, let's write the instruction
@@ -222,6 +241,7 @@ void Engine::writeBlock(const SymbolTable &symbols,
             writeBlock(symbols, &scope, b.getLoop(), thread_stack, opencl, out);
             util::spaces(out, 4 + b.rank() * 4);
             out << "}\n";
+            loopTailWriter(symbols, scope, b.getLoop(), out);
         }
     }
 
@@ -230,7 +250,15 @@ void Engine::writeBlock(const SymbolTable &symbols,
         for (const InstrPtr &instr: iterator::allLocalInstr(kernel)) {
             if (not instr->operand.empty()) {
                 const bh_view &view = instr->operand[0];
-                if (scope.isScalarReplaced(view)) {
+                if (scope.isScalarReplaced(view) and symbols.isStreamingStore(view.base)) {
+                    util::spaces(out, 8 + kernel.rank * 4);
+                    out << "BH_STREAM_STORE(&a" << symbols.baseID(view.base);
+                    write_array_subscription(scope, view, out, false);
+                    out << ", ";
+                    scope.getName(view, out);
+                    out << ");\n";
+                    scope.eraseScalarReplaced(view);
+                } else if (scope.isScalarReplaced(view)) {
                     util::spaces(out, 8 + kernel.rank * 4);
                     out << "a" << symbols.baseID(view.base);
                     if (bh_opcode_is_reduction(instr->opcode)) {
@@ -284,8 +312,8 @@ void Engine::writeInstr(Scope &scope, const bh_instruction &instr, int indent, b
         get_name_and_subscription(scope, instr.operand[2], ss);
         ss << "]";
         ops.push_back(ss.str());
-    } else if (instr.opcode == BH_SCATTER or instr.opcode == BH_COND_SCATTER) {
-        // Format of SCATTER: out[out.start + in2[<loop-indexes>]] = in1[<loop-indexes>]
+    } else if (instr.opcode == BH_SCATTER or instr.opcode == BH_COND_SCATTER or instr.opcode == BH_SCATTER_ADD) {
+        // Format of SCATTER: out[out.start + in2[<loop-indexes>]] = in1[<loop-indexes>] (SCATTER_ADD uses '+=')
         stringstream ss;
         scope.getName(instr.operand[0], ss);
         ss << "[" << instr.operand[0].start << " + ";
@@ -25,6 +25,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <bh_config_parser.hpp>
 #include <jitk/statistics.hpp>
 #include <jitk/apply_fusion.hpp>
+#include <jitk/memory_planner.hpp>
 
 #include <bh_view.hpp>
 #include <bh_component.hpp>
@@ -39,6 +40,8 @@ namespace jitk {
 void EngineCPU::handleExecution(BhIR *bhir) {
 
     const auto texecution = chrono::steady_clock::now();
+    const auto phases = stat.phaseTimers();
+    stat.tracer->beginFlush();
 
     map<string, bool> kernel_config = {
             {"strides_as_var", comp.config.defaultGet<bool>("strides_as_var", true)},
@@ -47,6 +50,12 @@ void EngineCPU::handleExecution(BhIR *bhir) {
             {"use_volatile",   comp.config.defaultGet<bool>("volatile", false)}
     };
 
+    // Outputs larger than this number of bytes are written using non-temporal stores (-1 means disabled)
+    const int64_t streaming_store_threshold = comp.config.defaultGet<int64_t>("streaming_store_threshold", -1);
+
+    // Scatter-add outputs of this number of elements or fewer get a private copy per thread (-1 means disabled)
+    const int64_t privatize_threshold = comp.config.defaultGet<int64_t>("scatter_add_privatize_threshold", 16384);
+
     // Some statistics
     stat.record(*bhir);
 
@@ -72,13 +81,23 @@ void EngineCPU::handleExecution(BhIR *bhir) {
     vector<LoopB> kernel_list = get_kernel_list(instr_list, comp.config, fcache, stat, false,
                                                 comp.config.defaultGet<bool>("monolithic", true));
 
-    for (const LoopB &kernel: kernel_list) {
+    // Let's pack the base arrays that live and die within the kernel list into one arena (-1 disables)
+    const int64_t arena_min_nbytes = comp.config.defaultGet<int64_t>("arena_min_nbytes", -1);
+    MemoryPlanner planner(kernel_list, bhir->getSyncs(), arena_min_nbytes);
+    planner.allocate(stat);
+
+    for (size_t kernel_index = 0; kernel_index < kernel_list.size(); ++kernel_index) {
+        const LoopB &kernel = kernel_list[kernel_index];
+        planner.assignDataPtrs(kernel_index);
+
         // Let's create the symbol table for the kernel
         const SymbolTable symbols(kernel,
                                   kernel_config["use_volatile"],
                                   kernel_config["strides_as_var"],
                                   kernel_config["index_as_var"],
-                                  kernel_config["const_as_var"]
+                                  kernel_config["const_as_var"],
+                                  streaming_store_threshold,
+                                  privatize_threshold
         );
 
         stat.record(symbols);
@@ -109,7 +128,9 @@ void EngineCPU::handleExecution(BhIR *bhir) {
                 stringstream ss;
                 writeKernel(kernel, symbols, {}, lookup.second, ss);
                 string source = ss.str();
-                stat.time_codegen += chrono::steady_clock::now() - tcodegen;
+                const auto tcodegen_end = chrono::steady_clock::now();
+                stat.time_codegen += tcodegen_end - tcodegen;
+                stat.tracer->record("codegen", "codegen", tcodegen, tcodegen_end, lookup.second, source.size());
 
                 execute(symbols, source, lookup.second, constants);
                 codegen_cache.insert(std::move(source), kernel, symbols);
@@ -118,10 +139,14 @@ void EngineCPU::handleExecution(BhIR *bhir) {
 
         // Finally, let's cleanup
         for (bh_base *base: kernel.getAllFrees()) {
-            bh_data_free(base);
+            planner.free(base);
         }
     }
-    stat.time_total_execution += chrono::steady_clock::now() - texecution;
+    const auto texecution_end = chrono::steady_clock::now();
+    stat.time_total_execution += texecution_end - texecution;
+    stat.tracer->record("flush", "flush", texecution, texecution_end, 0, bhir->instr_list.size());
+    stat.observeFlush(phases);
+    publishMetrics();
 }
 
 void EngineCPU::handleExtmethod(BhIR *bhir){
@@ -136,7 +161,9 @@ void EngineCPU::handleExtmethod(BhIR *bhir){
             instr_list.clear(); // Notice, it is legal to clear a moved vector.
             const auto texecution = std::chrono::steady_clock::now();
             ext->second.execute(&instr, nullptr); // Execute the extension method
-            stat.time_ext_method += std::chrono::steady_clock::now() - texecution;
+            const auto texecution_end = std::chrono::steady_clock::now();
+            stat.observeExtmethod(texecution_end - texecution);
+            stat.tracer->record("extmethod", "extmethod", texecution, texecution_end);
         } else {
             instr_list.push_back(instr);
         }
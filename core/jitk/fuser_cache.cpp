@@ -123,6 +123,7 @@ void update_with_origin(bh_instruction &instr, const bh_instruction *origin,
                         const std::map<bh_base*, bh_base*> &base_cached2new) {
     assert(instr.origin_id == origin->origin_id);
     assert(instr.opcode == origin->opcode);
+    instr.source_id = origin->source_id;
     for (size_t i = 0; i < instr.operand.size(); ++i) {
         if (instr.operand[i].hasSlide()) {
             instr.operand[i].start = origin->operand[i].start;
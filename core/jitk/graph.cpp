@@ -83,6 +83,29 @@ bool path_exist(Vertex a, Vertex b, const DAG &dag, bool only_long_path) {
     return false;
 }
 
+/* Remove the vertex 'v', which must have no edges, from the 'dag'
+ * NB: we cannot use boost::remove_vertex() since its re-indexing of the set-based edge lists increments an
+ *     erased iterator (at least in Boost 1.74), which corrupts the edge sets. Instead, we rebuild the DAG, which
+ *     preserves the order of the vertices and edges.
+ *
+ * Complexity: O(E + V)
+ */
+void remove_vertex(DAG &dag, Vertex v) {
+    assert(boost::in_degree(v, dag) == 0 and boost::out_degree(v, dag) == 0);
+    DAG ret;
+    for (Vertex u = 0; u < boost::num_vertices(dag); ++u) {
+        if (u != v) {
+            boost::add_vertex(std::move(dag[u]), ret);
+        }
+    }
+    BOOST_FOREACH(Edge e, boost::edges(dag)) {
+        const Vertex src = boost::source(e, dag);
+        const Vertex dst = boost::target(e, dag);
+        boost::add_edge(src > v ? src - 1 : src, dst > v ? dst - 1 : dst, ret);
+    }
+    dag = std::move(ret);
+}
+
 // Create a DAG based on the 'block_list'
 DAG from_block_list(const vector<Block> &block_list) {
     DAG graph;
@@ -194,7 +217,7 @@ void merge_vertices(DAG &dag, Vertex a, Vertex b, const bool remove_b) {
     // Finally, cleanup of 'b'
     boost::clear_vertex(b, dag);
     if (remove_b) {
-        boost::remove_vertex(b, dag);
+        remove_vertex(dag, b);
     }
     assert(validate(dag));
 }
@@ -236,7 +259,7 @@ void merge_system_pendants(DAG &dag) {
     // Remove the vertex leftover from the merge
     // NB: because of Vertex invalidation, we have to traverse in reverse
     BOOST_REVERSE_FOREACH(Edge &e, merges) {
-        boost::remove_vertex(boost::target(e, dag), dag);
+        remove_vertex(dag, boost::target(e, dag));
     }
     assert(validate(dag));
 }
@@ -0,0 +1,60 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+
+#include <jitk/histogram.hpp>
+
+using namespace std;
+
+namespace bohrium {
+namespace jitk {
+
+constexpr int Histogram::SUB_BUCKET_BITS;
+constexpr uint64_t Histogram::SUB_BUCKET_COUNT;
+constexpr int Histogram::MAX_EXPONENT;
+constexpr size_t Histogram::NUM_BUCKETS;
+
+uint64_t Histogram::countLessOrEqual(double seconds) const {
+    uint64_t ret = 0;
+    for (size_t i = 0; i < NUM_BUCKETS and bucketUpperBound(i) <= seconds * 1e9; ++i) {
+        ret += _buckets[i];
+    }
+    return ret;
+}
+
+double Histogram::percentile(double quantile) const {
+    if (_count == 0) {
+        return 0;
+    }
+    // The rank of the value we are looking for, which is at least one
+    const auto rank = std::max(uint64_t{1}, static_cast<uint64_t>(ceil(quantile * _count)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        seen += _buckets[i];
+        if (seen >= rank) {
+            return min(bucketUpperBound(i) / 1e9, _max);
+        }
+    }
+    return _max;
+}
+
+}
+} // namespace bohrium::jitk
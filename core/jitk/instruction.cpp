@@ -538,6 +538,9 @@ void write_operation(const bh_instruction &instr, const vector <string> &ops, st
         case BH_COND_SCATTER:
             out << "if (" << ops[2] << ") { " << ops[0] << " = " << ops[1] << "; }";
             break;
+        case BH_SCATTER_ADD:
+            out << ops[0] << " += " << ops[1] << ";";
+            break;
         default:
             cerr << "Instruction \"" << instr << "\" not supported\n";
             throw runtime_error("Instruction not supported.");
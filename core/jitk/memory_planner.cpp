@@ -0,0 +1,168 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include <jitk/memory_planner.hpp>
+#include <jitk/iterator.hpp>
+#include <jitk/symbol_table.hpp>
+#include <bh_main_memory.hpp>
+
+using namespace std;
+
+namespace bohrium {
+namespace jitk {
+
+namespace {
+// The alignment of the base arrays within the arena (a cache line)
+constexpr uint64_t ALIGNMENT = 64;
+
+uint64_t align(uint64_t nbytes) {
+    return (nbytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+}
+
+MemoryPlanner::MemoryPlanner(const vector<LoopB> &kernel_list, const set<bh_base *> &syncs, int64_t min_nbytes) {
+    if (min_nbytes < 0) {
+        return;
+    }
+    _live_in.resize(kernel_list.size());
+
+    // Find the first kernel that access each unallocated base array
+    map<bh_base *, size_t> first_access;
+    for (size_t i = 0; i < kernel_list.size(); ++i) {
+        for (const InstrPtr &instr: iterator::allInstr(kernel_list[i])) {
+            if (bh_opcode_is_system(instr->opcode)) {
+                continue;
+            }
+            for (const bh_base *b: iterator::allBases(*instr)) {
+                bh_base *base = const_cast<bh_base *>(b);
+                if (base->getDataPtr() == nullptr and first_access.find(base) == first_access.end()) {
+                    first_access[base] = i;
+                }
+            }
+        }
+    }
+
+    // Base arrays freed by a later kernel than the one creating them have a live range that spans multiple kernels.
+    // Temporary arrays local to one kernel, which the kernel accesses arbitrarily (e.g. the input of a gather),
+    // are kernel arguments like any other array and live in that kernel only. NB: we leave out the other kernel
+    // temporaries since array contraction replaces them by scalars.
+    vector<pair<bh_base *, Plan> > candidates;
+    for (size_t i = 0; i < kernel_list.size(); ++i) {
+        const set<bh_base *> temps = kernel_list[i].getAllTemps();
+        set<bh_base *> array_always;
+        for (const InstrPtr &instr: iterator::allInstr(kernel_list[i])) {
+            bh_base *base = array_always_base(*instr);
+            if (base != nullptr) {
+                array_always.insert(base);
+            }
+        }
+        for (bh_base *base: kernel_list[i].getAllFrees()) {
+            auto it = first_access.find(base);
+            if (it == first_access.end() or it->second > i or util::exist(syncs, base) or
+                base->nbytes() < min_nbytes) {
+                continue;
+            }
+            const bool kernel_temp = it->second == i or util::exist(temps, base);
+            if (kernel_temp and not util::exist(array_always, base)) {
+                continue;
+            }
+            candidates.push_back(make_pair(base, Plan{it->second, i, 0}));
+        }
+    }
+
+    // Greedy packing by decreasing size: each base array gets the lowest offset that doesn't overlap the base arrays
+    // already placed with an overlapping live range
+    sort(candidates.begin(), candidates.end(), [](const pair<bh_base *, Plan> &a, const pair<bh_base *, Plan> &b) {
+        if (a.first->nbytes() != b.first->nbytes()) {
+            return a.first->nbytes() > b.first->nbytes();
+        }
+        return a.second.first < b.second.first;
+    });
+    vector<pair<bh_base *, Plan> > placed;
+    for (auto &candidate: candidates) {
+        Plan &plan = candidate.second;
+        const uint64_t nbytes = align(candidate.first->nbytes());
+
+        // The occupied arena ranges sorted by offset
+        vector<pair<uint64_t, uint64_t> > occupied;
+        for (const auto &p: placed) {
+            if (p.second.first <= plan.last and plan.first <= p.second.last) {
+                occupied.push_back(make_pair(p.second.offset, p.second.offset + align(p.first->nbytes())));
+            }
+        }
+        sort(occupied.begin(), occupied.end());
+        uint64_t offset = 0;
+        for (const auto &range: occupied) {
+            if (offset + nbytes <= range.first) {
+                break;
+            }
+            offset = std::max(offset, range.second);
+        }
+        plan.offset = offset;
+        _arena_nbytes = std::max(_arena_nbytes, offset + nbytes);
+        _total_nbytes += nbytes;
+        placed.push_back(candidate);
+    }
+
+    for (const auto &p: placed) {
+        _plans.insert(p);
+        _live_in[p.second.first].push_back(p.first);
+    }
+}
+
+MemoryPlanner::~MemoryPlanner() {
+    bh_memory_free(_arena, _arena_nbytes);
+}
+
+void MemoryPlanner::allocate(Statistics &stat) {
+    if (_plans.empty()) {
+        return;
+    }
+    assert(_arena == nullptr);
+    _arena = bh_memory_malloc(_arena_nbytes);
+    ++stat.arena_allocations;
+    stat.arena_base_arrays += _plans.size();
+    if (_total_nbytes - _arena_nbytes > stat.arena_max_reduction) {
+        stat.arena_max_reduction = _total_nbytes - _arena_nbytes;
+    }
+}
+
+void MemoryPlanner::assignDataPtrs(size_t kernel_index) {
+    if (_arena == nullptr) {
+        return;
+    }
+    for (bh_base *base: _live_in.at(kernel_index)) {
+        assert(base->getDataPtr() == nullptr);
+        base->resetDataPtr(static_cast<char *>(_arena) + _plans.at(base).offset);
+    }
+}
+
+void MemoryPlanner::free(bh_base *base) {
+    if (_arena != nullptr and isPlanned(base)) {
+        base->resetDataPtr();
+    } else {
+        bh_data_free(base);
+    }
+}
+
+} // jitk
+} // bohrium
@@ -0,0 +1,54 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+#include <jitk/metrics.hpp>
+
+using namespace std;
+
+namespace bohrium {
+namespace jitk {
+
+void MetricsEndpoint::publish(const string &text) {
+    _last_published = chrono::steady_clock::now();
+    ++_num_published;
+
+    // We write a temporary file next to the metrics file and rename it, which is atomic on POSIX
+    const string tmp_filename = _filename + ".tmp." + to_string(getpid());
+    {
+        ofstream file(tmp_filename);
+        file << text;
+        if (not file) {
+            cerr << "[Metrics] cannot write '" << tmp_filename << "'" << endl;
+            return;
+        }
+    }
+    if (rename(tmp_filename.c_str(), _filename.c_str()) != 0) {
+        cerr << "[Metrics] cannot rename '" << tmp_filename << "' to '" << _filename << "'" << endl;
+        remove(tmp_filename.c_str());
+    }
+}
+
+}
+} // namespace bohrium::jitk
@@ -18,6 +18,9 @@ GNU Lesser General Public License along with Bohrium.
 If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <map>
+#include <algorithm>
+
 #include <bh_util.hpp>
 #include <jitk/symbol_table.hpp>
 #include <jitk/view.hpp>
@@ -28,11 +31,29 @@ using namespace std;
 namespace bohrium {
 namespace jitk {
 
+bh_base *array_always_base(const bh_instruction &instr) {
+    // Since accumulate accesses the previous index, it should always be an array
+    if (bh_opcode_is_accumulate(instr.opcode)) {
+        return instr.operand[0].base;
+    } else if (instr.opcode == BH_GATHER) { // Gather accesses the input arbitrarily
+        if (not instr.operand[1].isConstant()) {
+            return instr.operand[1].base;
+        }
+      // Scatter accesses the output arbitrarily
+    } else if (instr.opcode == BH_SCATTER or instr.opcode == BH_COND_SCATTER or instr.opcode == BH_SCATTER_ADD) {
+        return instr.operand[0].base;
+    }
+    return nullptr;
+}
+
 SymbolTable::SymbolTable(const LoopB &kernel,
                          bool use_volatile,
                          bool strides_as_var,
                          bool index_as_var,
-                         bool const_as_var) : _useRandom(false),
+                         bool const_as_var,
+                         int64_t streaming_store_threshold,
+                         int64_t privatize_threshold) : _useRandom(false),
+                                              _kernel(&kernel),
                                               use_volatile(use_volatile),
                                               strides_as_var(strides_as_var),
                                               index_as_var(index_as_var),
@@ -55,16 +76,9 @@ SymbolTable::SymbolTable(const LoopB &kernel,
                 _constant_set.insert(instr);
             }
         }
-        // Since accumulate accesses the previous index, it should always be an array
-        if (bh_opcode_is_accumulate(instr->opcode)) {
-            _array_always.insert(instr->operand[0].base);
-        } else if (instr->opcode == BH_GATHER) { // Gather accesses the input arbitrarily
-            if (not instr->operand[1].isConstant()) {
-                _array_always.insert(instr->operand[1].base);
-            }
-          // Scatter accesses the output arbitrarily
-        } else if (instr->opcode == BH_SCATTER or instr->opcode == BH_COND_SCATTER) {
-            _array_always.insert(instr->operand[0].base);
+        bh_base *array_always = array_always_base(*instr);
+        if (array_always != nullptr) {
+            _array_always.insert(array_always);
         } else if (instr->opcode == BH_RANDOM) {
             _useRandom = true;
         }
@@ -96,6 +110,100 @@ SymbolTable::SymbolTable(const LoopB &kernel,
             _offset_stride_views[v.second] = &(v.first);
         }
     }
+    if (streaming_store_threshold >= 0) {
+        findStreamingStores(kernel, streaming_store_threshold);
+    }
+    if (privatize_threshold >= 0) {
+        std::set<const bh_base*> privatized;
+        for (const InstrPtr &instr: iterator::allInstr(kernel)) {
+            if (instr->opcode == BH_SCATTER_ADD and instr->operand[0].base->nelem() <= privatize_threshold) {
+                privatized.insert(instr->operand[0].base);
+            }
+        }
+        for (const bh_base *base: _params) {
+            if (util::exist(privatized, base)) {
+                _privatized.push_back(base);
+            }
+        }
+    }
+}
+
+void SymbolTable::estimateWork() const {
+    if (_work_estimated) {
+        return;
+    }
+    _work_estimated = true;
+    // The largest part of each base array that the kernel reads and writes
+    std::map<const bh_base*, uint64_t> reads, writes;
+    auto touch = [](std::map<const bh_base*, uint64_t> &touched, const bh_view &view) {
+        const uint64_t nbytes = std::min(static_cast<uint64_t>(view.shape.prod()) * bh_type_size(view.base->dtype()),
+                                         static_cast<uint64_t>(view.base->nbytes()));
+        uint64_t &t = touched[view.base];
+        t = std::max(t, nbytes);
+    };
+    for (const InstrPtr &instr: iterator::allInstr(*_kernel)) {
+        if (bh_opcode_is_system(instr->opcode)) {
+            continue;
+        }
+        // NB: reading an array that the kernel already wrote hits the cache or registers thus it is free
+        for (size_t i = 1; i < instr->operand.size(); ++i) {
+            if (not instr->operand[i].isConstant() and not util::exist(writes, instr->operand[i].base)) {
+                touch(reads, instr->operand[i]);
+            }
+        }
+        touch(writes, instr->operand[0]);
+        if (instr->source_id >= 0) {
+            _source_weights[instr->source_id] += instr->shape().prod();
+        }
+        // Copies, gathers, and scatters only move data
+        if (instr->opcode != BH_IDENTITY and instr->opcode != BH_GATHER and instr->opcode != BH_SCATTER and
+            instr->opcode != BH_COND_SCATTER) {
+            _num_operations += instr->shape().prod();
+        }
+    }
+    for (const bh_base *base: _params) {
+        _num_bytes_moved += util::exist(reads, base) ? reads.at(base) : 0;
+        _num_bytes_moved += util::exist(writes, base) ? writes.at(base) : 0;
+    }
+}
+
+void SymbolTable::findStreamingStores(const LoopB &kernel, int64_t threshold) {
+    // Count the number of writes and reads of each base array
+    std::map<const bh_base*, int64_t> nwrites;
+    std::set<const bh_base*> reads;
+    std::vector<const bh_instruction*> candidates;
+    for (const InstrPtr &instr: iterator::allInstr(kernel)) {
+        if (bh_opcode_is_system(instr->opcode)) {
+            continue;
+        }
+        for (size_t i = 1; i < instr->operand.size(); ++i) {
+            if (not instr->operand[i].isConstant()) {
+                reads.insert(instr->operand[i].base);
+            }
+        }
+        const bh_view &out = instr->operand[0];
+        ++nwrites[out.base];
+        // Reductions, accumulations, and scatters read or access the output arbitrarily
+        if (instr->constructor and not (bh_opcode_is_reduction(instr->opcode) or
+                                        bh_opcode_is_accumulate(instr->opcode) or
+                                        instr->opcode == BH_SCATTER or
+                                        instr->opcode == BH_COND_SCATTER or
+                                        instr->opcode == BH_SCATTER_ADD)) {
+            candidates.push_back(&(*instr));
+        }
+    }
+
+    // A streaming store requires a contiguous, large, and write-only output with an element size of 4 or 8 bytes
+    for (const bh_instruction *instr: candidates) {
+        bh_base *base = instr->operand[0].base;
+        const int64_t elem_size = bh_type_size(base->dtype());
+        if (nwrites.at(base) == 1 and not util::exist(reads, base) and
+            util::exist_linearly(_params, base) and not isAlwaysArray(base) and
+            instr->operand[0].isContiguous() and not bh_type_is_complex(base->dtype()) and
+            (elem_size == 4 or elem_size == 8) and base->nbytes() >= threshold) {
+            _streaming_stores.insert(base);
+        }
+    }
 }
 
 
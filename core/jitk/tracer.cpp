@@ -0,0 +1,145 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+#include <jitk/tracer.hpp>
+
+using namespace std;
+
+namespace bohrium {
+namespace jitk {
+
+namespace {
+atomic<uint64_t> num_tracers{0};
+
+// The rings of the calling thread by the ID of the tracer they belong to. A thread records into the tracers of
+// every engine in the stack (e.g. opencl and its openmp child), which are a handful. NB: the cache is trivially
+// destructible since the engines might record events after the thread local objects of the thread are destroyed.
+struct RingCache {
+    uint64_t tracer;
+    void *ring;
+};
+constexpr size_t ring_cache_size = 8;
+thread_local RingCache ring_cache[ring_cache_size];
+thread_local size_t ring_cache_next;
+
+// Microseconds between `a` and `b`
+double us(Tracer::TimePoint a, Tracer::TimePoint b) {
+    return chrono::duration<double, micro>(b - a).count();
+}
+}
+
+Tracer::Tracer(bool enabled, uint64_t capacity) : _enabled(enabled), _capacity(max<uint64_t>(capacity, 1)),
+                                                  _id(++num_tracers), _start(chrono::steady_clock::now()) {}
+
+Tracer::Ring &Tracer::ring() {
+    for (const RingCache &cached: ring_cache) {
+        if (cached.tracer == _id) {
+            return *static_cast<Ring *>(cached.ring);
+        }
+    }
+    // The thread might have a ring already, which the cache has evicted
+    lock_guard<mutex> lock(_mutex);
+    const thread::id thread = this_thread::get_id();
+    Ring *ret = nullptr;
+    for (const unique_ptr<Ring> &r: _rings) {
+        if (r->thread == thread) {
+            ret = r.get();
+            break;
+        }
+    }
+    if (ret == nullptr) {
+        _rings.emplace_back(new Ring());
+        ret = _rings.back().get();
+        ret->tid = _rings.size();
+        ret->thread = thread;
+    }
+    ring_cache[ring_cache_next++ % ring_cache_size] = RingCache{_id, ret};
+    return *ret;
+}
+
+void Tracer::beginFlush() {
+    if (_enabled) {
+        ring().flush = ++_num_flushes;
+    }
+}
+
+void Tracer::record(const char *name, const char *category, TimePoint begin, TimePoint end, uint64_t hash,
+                    int64_t size) {
+    if (not _enabled) {
+        return;
+    }
+    Ring &r = ring();
+    lock_guard<mutex> lock(r.mutex); // Only contended while exporting
+    const Event event{name, category, begin, end, r.flush, hash, size};
+    if (r.events.size() < _capacity) { // The ring grows until it is full
+        r.events.push_back(event);
+    } else {
+        r.events[r.next % _capacity] = event;
+    }
+    ++r.next;
+}
+
+void Tracer::writeChromeTrace(ostream &out) const {
+    const pid_t pid = getpid();
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    lock_guard<mutex> lock(_mutex);
+    for (const unique_ptr<Ring> &r: _rings) {
+        lock_guard<mutex> ring_lock(r->mutex);
+        if (not first) {
+            out << ",\n";
+        }
+        first = false;
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid << ", \"tid\": " << r->tid
+            << ", \"args\": {\"name\": \"engine thread " << r->tid << "\"}}";
+        // The oldest events are overwritten when the ring is full
+        const uint64_t begin = r->next > _capacity ? r->next - _capacity : 0;
+        for (uint64_t i = begin; i < r->next; ++i) {
+            const Event &e = r->events[i % _capacity];
+            out << ",\n{\"name\": \"" << e.name << "\", \"cat\": \"" << e.category << "\", \"ph\": \"X\", \"pid\": "
+                << pid << ", \"tid\": " << r->tid << ", \"ts\": " << us(_start, e.begin) << ", \"dur\": "
+                << us(e.begin, e.end) << ", \"args\": {\"flush\": " << e.flush;
+            if (e.hash != 0) {
+                out << ", \"hash\": \"" << hex << e.hash << dec << "\"";
+            }
+            if (e.size >= 0) {
+                out << ", \"size\": " << e.size;
+            }
+            out << "}}";
+        }
+    }
+    out << "\n]}\n";
+}
+
+void Tracer::writeChromeTrace(const string &filename) const {
+    ofstream file(filename);
+    if (not file) {
+        throw runtime_error("Tracer: cannot create '" + filename + "'");
+    }
+    writeChromeTrace(file);
+}
+
+}
+} // namespace bohrium::jitk
@@ -0,0 +1,91 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <set>
+
+#include <bh_component.hpp>
+
+#include "trace.hpp"
+
+using namespace bohrium;
+using namespace component;
+using namespace std;
+
+namespace {
+// Records the BhIRs that pass through into a trace file, which `bh_replay` replays through any stack
+class Impl : public ComponentImpl {
+private:
+    trace::Writer writer;
+    set<bh_base *> known_base_arrays;
+    bool record_data;
+
+    // The host might change the data of `base`, thus it is recorded again the next time it is used
+    void forget(bh_base *base, bool nullify) {
+        writer.hostAccess(base, nullify);
+        known_base_arrays.erase(base);
+    }
+
+public:
+    Impl(int stack_level) : ComponentImpl(stack_level),
+                            writer(config.defaultGet<string>("file", "bh_trace.bin")),
+                            record_data(config.defaultGet("data", true)) {}
+
+    ~Impl() override = default;
+
+    void execute(BhIR *bhir) override {
+        vector<bh_base *> new_data;
+        const vector<char> archive = bhir->writeSerializedArchive(known_base_arrays, new_data);
+        for (const bh_instruction &instr: bhir->instr_list) {
+            if (instr.opcode == BH_FREE) {
+                known_base_arrays.erase(instr.operand[0].base);
+            }
+        }
+        // The data is recorded before the child might change it
+        const auto offset = writer.bhir(archive, new_data, record_data);
+        const auto start = chrono::steady_clock::now();
+        child.execute(bhir);
+        const auto duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+        writer.duration(offset, static_cast<uint64_t>(duration.count()));
+    }
+
+    void extmethod(const string &name, bh_opcode opcode) override {
+        writer.extmethod(name, opcode);
+        child.extmethod(name, opcode);
+    }
+
+    void *getMemoryPointer(bh_base &base, bool copy2host, bool force_alloc, bool nullify) override {
+        forget(&base, nullify);
+        return child.getMemoryPointer(base, copy2host, force_alloc, nullify);
+    }
+
+    void setMemoryPointer(bh_base *base, bool host_ptr, void *mem) override {
+        forget(base, false);
+        child.setMemoryPointer(base, host_ptr, mem);
+    }
+};
+} //Unnamed namespace
+
+extern "C" ComponentImpl* create(int stack_level) {
+    return new Impl(stack_level);
+}
+extern "C" void destroy(ComponentImpl* self) {
+    delete self;
+}
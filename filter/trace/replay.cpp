@@ -0,0 +1,211 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <bh_component.hpp>
+#include <bh_main_memory.hpp>
+
+#include "trace.hpp"
+
+using namespace std;
+using namespace bohrium;
+using namespace component;
+
+// Replays a trace file, which the trace filter has recorded, through the stack of `BH_STACK` and reports the
+// latency of each flush i.e. the execution of a BhIR and the host accesses that follows it
+
+namespace {
+
+struct Flush {
+    size_t ninstr;
+    double recorded; // Seconds
+    double replayed; // Seconds
+};
+
+// Returns the `p` percentile of `values` (which gets sorted)
+double percentile(vector<double> values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    sort(values.begin(), values.end());
+    const auto i = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+    return values[min(i, values.size() - 1)];
+}
+
+void print_row(const string &name, const vector<double> &latencies) {
+    double total = 0;
+    for (double t: latencies) {
+        total += t;
+    }
+    cout << left << setw(12) << name << right << fixed << setprecision(3)
+         << setw(12) << total * 1e3
+         << setw(11) << percentile(latencies, 50) * 1e3
+         << setw(11) << percentile(latencies, 90) * 1e3
+         << setw(11) << percentile(latencies, 99) * 1e3
+         << setw(11) << percentile(latencies, 100) * 1e3 << endl;
+}
+
+// Replay the trace file `filename` through `stack`
+vector<Flush> replay(ComponentFace &stack, const string &filename, bool register_extmethods) {
+    trace::Reader reader(filename);
+    map<const bh_base *, bh_base> remote2local;
+    vector<Flush> ret;
+    trace::Record type;
+    while (reader.next(type)) {
+        switch (type) {
+            case trace::Record::BHIR: {
+                const auto recorded = reader.read<uint64_t>();
+                const vector<char> archive = reader.read(reader.read<uint64_t>());
+                vector<bh_base *> data_recv;
+                set<bh_base *> frees;
+                BhIR bhir(archive, remote2local, data_recv, frees);
+                if (reader.read<uint64_t>() != data_recv.size()) {
+                    throw runtime_error("trace: the number of new arrays doesn't match the BhIR");
+                }
+                for (bh_base *base: data_recv) {
+                    const auto nbytes = reader.read<uint64_t>();
+                    bh_data_malloc(base);
+                    if (nbytes == 0) { // The data wasn't recorded
+                        memset(base->getDataPtr(), 0, static_cast<size_t>(base->nbytes()));
+                    } else if (nbytes == static_cast<uint64_t>(base->nbytes())) {
+                        reader.read(base->getDataPtr(), nbytes);
+                    } else {
+                        throw runtime_error("trace: the size of the array data doesn't match the base array");
+                    }
+                }
+                const auto start = chrono::steady_clock::now();
+                stack.execute(&bhir);
+                const chrono::duration<double> replayed = chrono::steady_clock::now() - start;
+                ret.push_back(Flush{bhir.instr_list.size(), recorded / 1e9, replayed.count()});
+                for (bh_base *remote: frees) {
+                    remote2local.erase(remote);
+                }
+                break;
+            }
+            case trace::Record::HOST_ACCESS: {
+                const auto remote = reinterpret_cast<const bh_base *>(reader.read<uint64_t>());
+                reader.read<uint8_t>(); // Nullify, which we always do since the trace sends the array again
+                auto it = remote2local.find(remote);
+                if (it == remote2local.end()) {
+                    break;
+                }
+                bh_base &local = it->second;
+                const auto start = chrono::steady_clock::now();
+                local.resetDataPtr(stack.getMemoryPointer(local, true, false, true));
+                if (not ret.empty()) {
+                    ret.back().replayed += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                }
+                bh_data_free(&local);
+                remote2local.erase(it);
+                break;
+            }
+            case trace::Record::EXTMETHOD: {
+                const auto opcode = static_cast<bh_opcode>(reader.read<int64_t>());
+                const string name = reader.rest();
+                if (register_extmethods) {
+                    stack.extmethod(name, opcode);
+                }
+                break;
+            }
+            default:
+                throw runtime_error("trace: unknown record type");
+        }
+    }
+
+    // Free the base arrays that the trace didn't free
+    vector<bh_instruction> instr_list;
+    for (auto &r: remote2local) {
+        instr_list.emplace_back(BH_FREE, vector<bh_view>{bh_view(&r.second)});
+    }
+    if (not instr_list.empty()) {
+        BhIR bhir(std::move(instr_list), {});
+        stack.execute(&bhir);
+    }
+    return ret;
+}
+}
+
+int main(int argc, char *argv[]) {
+    int repeats = 1;
+    bool verbose = false;
+    string filename;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg == "-r" and i + 1 < argc) {
+            repeats = max(1, atoi(argv[++i]));
+        } else if (arg == "-v") {
+            verbose = true;
+        } else if (filename.empty() and arg[0] != '-') {
+            filename = arg;
+        } else {
+            filename.clear();
+            break;
+        }
+    }
+    if (filename.empty()) {
+        cout << "Usage: " << argv[0] << " [-r repeats] [-v] trace-file\n"
+             << "Replays a trace file, which the trace filter has recorded, through the stack of BH_STACK" << endl;
+        return 1;
+    }
+
+    try {
+        const char *stack_name = getenv("BH_STACK");
+        ComponentFace stack(ConfigParser(-1).getChildLibraryPath(), 0);
+        vector<double> recorded;
+        for (int r = 0; r < repeats; ++r) {
+            const vector<Flush> flushes = replay(stack, filename, r == 0);
+            vector<double> replayed;
+            size_t ninstr = 0;
+            for (const Flush &f: flushes) {
+                replayed.push_back(f.replayed);
+                ninstr += f.ninstr;
+            }
+            if (r == 0) {
+                for (const Flush &f: flushes) {
+                    recorded.push_back(f.recorded);
+                }
+                cout << "Replaying '" << filename << "' (" << flushes.size() << " flushes, " << ninstr
+                     << " instructions) through the stack '" << (stack_name ? stack_name : "default") << "'\n\n";
+                if (verbose) {
+                    cout << setw(8) << "flush" << setw(14) << "instructions" << setw(15) << "recorded ms"
+                         << setw(15) << "replayed ms" << "\n";
+                    for (size_t i = 0; i < flushes.size(); ++i) {
+                        cout << setw(8) << i << setw(14) << flushes[i].ninstr << fixed << setprecision(3)
+                             << setw(15) << flushes[i].recorded * 1e3 << setw(15) << flushes[i].replayed * 1e3 << "\n";
+                    }
+                    cout << "\n";
+                }
+                cout << left << setw(12) << "latency" << right << setw(12) << "total ms" << setw(11) << "p50 ms"
+                     << setw(11) << "p90 ms" << setw(11) << "p99 ms" << setw(11) << "max ms" << endl;
+                print_row("recorded", recorded);
+            }
+            print_row("replay " + to_string(r + 1), replayed);
+        }
+    } catch (const exception &e) {
+        cerr << "bh_replay: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
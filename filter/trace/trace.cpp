@@ -0,0 +1,138 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <stdexcept>
+
+#include "trace.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace trace {
+
+namespace {
+const char magic[8] = {'B', 'H', 'T', 'R', 'A', 'C', 'E', '\0'};
+const uint32_t version = 1;
+}
+
+Writer::Writer(const string &filename) : _file(filename, ios::binary | ios::trunc) {
+    if (not _file) {
+        throw runtime_error("trace: cannot create '" + filename + "'");
+    }
+    _file.write(magic, sizeof(magic));
+    write(version);
+}
+
+streampos Writer::begin(Record type) {
+    write(static_cast<uint8_t>(type));
+    write(uint64_t{0}); // The size of the payload, which `end()` writes
+    return _file.tellp();
+}
+
+void Writer::end(streampos payload) {
+    const streampos pos = _file.tellp();
+    _file.seekp(payload - static_cast<streamoff>(sizeof(uint64_t)));
+    write(static_cast<uint64_t>(pos - payload));
+    _file.seekp(pos);
+    if (not _file) {
+        throw runtime_error("trace: writing the trace file failed");
+    }
+}
+
+streampos Writer::bhir(const vector<char> &archive, const vector<bh_base *> &new_data, bool data) {
+    const streampos payload = begin(Record::BHIR);
+    write(uint64_t{0}); // The duration, which `duration()` writes
+    write(static_cast<uint64_t>(archive.size()));
+    _file.write(archive.data(), archive.size());
+    write(static_cast<uint64_t>(new_data.size()));
+    for (const bh_base *base: new_data) {
+        const auto nbytes = static_cast<uint64_t>(data ? base->nbytes() : 0);
+        write(nbytes);
+        _file.write(static_cast<const char *>(base->getDataPtr()), nbytes);
+    }
+    end(payload);
+    return payload;
+}
+
+void Writer::duration(streampos offset, uint64_t nanoseconds) {
+    const streampos pos = _file.tellp();
+    _file.seekp(offset);
+    write(nanoseconds);
+    _file.seekp(pos);
+    _file.flush();
+}
+
+void Writer::hostAccess(const bh_base *base, bool nullify) {
+    const streampos payload = begin(Record::HOST_ACCESS);
+    write(reinterpret_cast<uint64_t>(base));
+    write(static_cast<uint8_t>(nullify));
+    end(payload);
+}
+
+void Writer::extmethod(const string &name, bh_opcode opcode) {
+    const streampos payload = begin(Record::EXTMETHOD);
+    write(static_cast<int64_t>(opcode));
+    _file.write(name.data(), name.size());
+    end(payload);
+}
+
+Reader::Reader(const string &filename) : _file(filename, ios::binary) {
+    char m[sizeof(magic)];
+    uint32_t v = 0;
+    _file.read(m, sizeof(m));
+    _file.read(reinterpret_cast<char *>(&v), sizeof(v));
+    if (not _file or memcmp(m, magic, sizeof(magic)) != 0) {
+        throw runtime_error("trace: '" + filename + "' is not a trace file");
+    }
+    if (v != version) {
+        throw runtime_error("trace: '" + filename + "' has an unsupported version");
+    }
+}
+
+bool Reader::next(Record &type) {
+    uint8_t t;
+    uint64_t nbytes;
+    if (not _file.read(reinterpret_cast<char *>(&t), sizeof(t))) {
+        return false;
+    }
+    if (not _file.read(reinterpret_cast<char *>(&nbytes), sizeof(nbytes))) {
+        throw runtime_error("trace: truncated record");
+    }
+    _payload.resize(nbytes);
+    if (not _file.read(_payload.data(), nbytes)) {
+        throw runtime_error("trace: truncated record");
+    }
+    _pos = 0;
+    type = static_cast<Record>(t);
+    return true;
+}
+
+const char *Reader::take(size_t n) {
+    if (n > _payload.size() - _pos) {
+        throw runtime_error("trace: malformed record");
+    }
+    const char *ret = _payload.data() + _pos;
+    _pos += n;
+    return ret;
+}
+
+}
+} // namespace bohrium::trace
@@ -0,0 +1,128 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <bh_ir.hpp>
+
+namespace bohrium {
+namespace trace {
+
+/** A trace file is a header followed by records, which are a type, the size of the payload, and the payload:
+ *    BHIR:        the recorded duration of the execution (ns), the BhIR (`BhIR::writeSerializedArchive()`), and
+ *                 the size and the data of each new base array with data (the size is zero when not recorded)
+ *    HOST_ACCESS: a base array (ID) that the host has accessed and whether it was nullified. The base array is
+ *                 forgotten, thus the recorder sends it again, including its data, the next time it is used.
+ *    EXTMETHOD:   the opcode and the name of a new extension method
+ */
+enum class Record : uint8_t {
+    BHIR = 1,
+    HOST_ACCESS = 2,
+    EXTMETHOD = 3
+};
+
+// Writes a trace file
+class Writer {
+private:
+    std::ofstream _file;
+
+    // Write the header of a record and return the offset of the payload
+    std::streampos begin(Record type);
+
+    // Write the size of the payload that starts at `payload`
+    void end(std::streampos payload);
+
+    template<typename T>
+    void write(const T &value) {
+        _file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+public:
+    // Create the trace file `filename`
+    explicit Writer(const std::string &filename);
+
+    /** Write a BhIR record, which must be followed by a call to `duration()` when the BhIR has executed
+     *
+     * @param archive   The serialized BhIR
+     * @param new_data  The new base arrays with data in the order of the archive
+     * @param data      Whether to record the data of `new_data`
+     * @return          The offset of the duration, which `duration()` writes
+     */
+    std::streampos bhir(const std::vector<char> &archive, const std::vector<bh_base *> &new_data, bool data);
+
+    // Write the duration of the BhIR record at `offset`
+    void duration(std::streampos offset, uint64_t nanoseconds);
+
+    // Write a HOST_ACCESS record
+    void hostAccess(const bh_base *base, bool nullify);
+
+    // Write an EXTMETHOD record
+    void extmethod(const std::string &name, bh_opcode opcode);
+};
+
+// Reads a trace file one record at a time
+class Reader {
+private:
+    std::ifstream _file;
+    std::vector<char> _payload;
+    size_t _pos = 0;
+
+    // Read `n` bytes of the payload
+    const char *take(size_t n);
+
+public:
+    // Open the trace file `filename`, which throws `std::runtime_error` when it isn't a trace file
+    explicit Reader(const std::string &filename);
+
+    // Read the next record into the payload and returns false at the end of the file
+    bool next(Record &type);
+
+    // Read a value of the payload
+    template<typename T>
+    T read() {
+        T ret;
+        memcpy(&ret, take(sizeof(T)), sizeof(T));
+        return ret;
+    }
+
+    // Read `n` bytes of the payload
+    std::vector<char> read(size_t n) {
+        const char *p = take(n);
+        return std::vector<char>(p, p + n);
+    }
+
+    // Read `n` bytes of the payload into `dest`
+    void read(void *dest, size_t n) {
+        memcpy(dest, take(n), n);
+    }
+
+    // Read the rest of the payload
+    std::string rest() {
+        const size_t n = _payload.size() - _pos;
+        const char *p = take(n);
+        return std::string(p, n);
+    }
+};
+
+}
+} // namespace bohrium::trace
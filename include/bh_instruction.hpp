@@ -22,6 +22,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <boost/serialization/is_bitwise_serializable.hpp>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 #include <vector>
 #include <set>
@@ -47,6 +48,9 @@ struct bh_instruction {
     // copy, transpose, and reshape does not change the 'origin_id'.
     // For now, this flag is only used by the code generators.
     int64_t origin_id = -1; // -1 indicates: unset
+    // The source location in the user program that created this instruction (see `bh_source_location_id()`),
+    // which the bridges set when profiling source lines. Transformations does not change the 'source_id'.
+    int64_t source_id = -1; // -1 indicates: unset
 
     /// Constructors
     bh_instruction() = default;
@@ -58,6 +62,7 @@ struct bh_instruction {
         constant = instr.constant;
         constructor = instr.constructor;
         origin_id = instr.origin_id;
+        source_id = instr.source_id;
         operand = instr.operand;
     }
 
@@ -157,9 +162,13 @@ struct bh_instruction {
         ar & operand;
         //We use make_array as a hack to make bh_constant BOOST_IS_BITWISE_SERIALIZABLE
         ar & boost::serialization::make_array(&constant, 1);
+        if (version >= 1) {
+            ar & source_id;
+        }
     }
 };
 BOOST_IS_BITWISE_SERIALIZABLE(bh_constant)
+BOOST_CLASS_VERSION(bh_instruction, 1)
 
 // Implements pprint of an instruction
 std::ostream &operator<<(std::ostream &out, const bh_instruction &instr);
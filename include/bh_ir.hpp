@@ -56,7 +56,7 @@ public:
      *
      *
      * \param serialized_archive Byte vector that makes up the serialized archive. The archive should be created with
-     *                           `writeSerializedArchive`, which uses `boost::archive::binary_iarchive`.
+     *                           `writeSerializedArchive`, which uses a compact versioned binary format.
      *
      * \param remote2local Map that maps remote array bases to local bases. The map is updated to include the new
      *                     array bases encountered in this BhIR thus this map should stay allocated throughout the
@@ -76,7 +76,8 @@ public:
          std::set<bh_base*> &frees);
 
 
-    /** Write the BhIR into a serialized archive.
+    /** Write the BhIR into a serialized archive, which interns the base arrays and views in tables and encodes
+     *  all integers as varints.
      *
      * \param known_base_arrays Set of known base arrays. The set is updated to include new base arrays in this BhIR.
      *                          The new base arrays are also serialized into the return archive.
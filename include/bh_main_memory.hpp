@@ -39,6 +39,29 @@ void bh_data_malloc(bh_base* base);
  */
 void bh_data_free(bh_base* base);
 
+/** Hand the memory mapping `mem` over to `base`, which must not have any data memory already.
+ * The mapping must be created by `mmap()`, be of size `base->nbytes()`, and is freed by `bh_data_free()`
+ * like any other data memory.
+ *
+ * @base    The base in question
+ * @mem     The memory mapping
+ */
+void bh_data_adopt(bh_base* base, void *mem);
+
+/** Allocate `nbytes` of main memory through the malloc cache, which isn't tied to a base array
+ *
+ * @param nbytes Number of bytes to allocate
+ * @return The memory allocation
+ */
+void *bh_memory_malloc(uint64_t nbytes);
+
+/** Free the memory allocation `mem` of size `nbytes` allocated with `bh_memory_malloc()`
+ *
+ * @param mem    The memory allocation
+ * @param nbytes Number of bytes of the allocation
+ */
+void bh_memory_free(void *mem, uint64_t nbytes);
+
 /** Set the size limit of the main memory malloc cache (see MallocCache::setLimit())
  *
  * @param nbytes The memory limit in bytes
@@ -206,6 +206,21 @@ public:
         return ret;
     }
 
+    /** Take ownership of the memory allocation `memory` of size `nbytes`, which was allocated outside of the cache.
+     * The allocation must be freeable by the free function given to the constructor.
+     *
+     * @param nbytes The size of the memory allocation
+     * @param memory The memory allocation
+     */
+    void adopt(uint64_t nbytes, void *memory) {
+        assert(memory != nullptr);
+        shrinkToFitLimit(nbytes);
+        _mem_allocated += nbytes;
+        if (_mem_allocated > _stat_allocated_max) {
+            _stat_allocated_max = _mem_allocated;
+        }
+    }
+
     /** Frees a memory allocation of size `nbytes`
      *
      * @param nbytes The size of the memory allocation
@@ -0,0 +1,41 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/** Return the compact id of the source location `filename:line`, which is registered on the first call.
+ * The bridges tag instructions with these ids (see `bh_instruction::source_id`) such that the profilers
+ * can attribute kernel time to the source lines of the user program.
+ *
+ * @filename  The source filename
+ * @line      The line number
+ * @return    The id, which is non-negative and unique within the process
+ */
+int64_t bh_source_location_id(const std::string &filename, int64_t line);
+
+/** Return the location, "filename:line", of the source location `id`.
+ * If `id` isn't registered in this process (e.g. it was registered by a remote frontend), "#<id>" is returned.
+ *
+ * @id      The source location id
+ * @return  The source location as a string
+ */
+std::string bh_source_location_name(int64_t id);
@@ -28,6 +28,12 @@ If not, see <http://www.gnu.org/licenses/>.
 namespace bohrium {
 namespace jitk {
 
+/** The resource usage of a compilation */
+struct CompilerUsage {
+    double cpu_time = 0;  // User and system seconds of the compiler processes
+    uint64_t max_rss = 0; // Peak resident set size of the compiler processes in bytes
+};
+
 /**
  * compile() forks and executes a system process.
  */
@@ -42,9 +48,10 @@ public:
     /**
      *  Compile by piping, the given sourcecode into a shared object.
      *
+     *  Returns the resource usage of the compiler
      *  Throws runtime_error on compilation failure
      */
-    void compile(std::string object_abspath, const char* sourcecode,size_t source_len) const;
+    CompilerUsage compile(std::string object_abspath, const char* sourcecode,size_t source_len) const;
 
     /**
      *  Compile source on disk.
@@ -53,9 +60,10 @@ public:
     /**
      *  Compile by disk writing, the given sourcecode into a shared object.
      *
+     *  Returns the resource usage of the compiler
      *  Throws runtime_error on compilation failure
      */
-    void compile(std::string object_abspath, std::string src_abspath) const;
+    CompilerUsage compile(std::string object_abspath, std::string src_abspath) const;
 };
 
 /** Returns the command where {OUT} and {IN} are expanded. */
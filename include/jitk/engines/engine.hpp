@@ -122,11 +122,25 @@ public:
         setConstructorFlag(instr_list, constructed_arrays);
     };
 
-    /** Update statistics with final aggregated values of the engine */
-    virtual void updateFinalStatistics() {} // Default we do nothing
+    /** Update the statistics counters that are cheap to read, such as the malloc cache and the memory usage */
+    virtual void updateStatisticCounters() {} // Default we do nothing
+
+    /** Update statistics with final aggregated values of the engine, which might be expensive to compute */
+    virtual void updateFinalStatistics() {
+        updateStatisticCounters();
+    }
 
 protected:
 
+    /** Write the statistics to the metrics endpoint when it is enabled and the update interval has passed.
+     *  NB: this runs in the middle of the execution, thus we only update the cheap counters */
+    void publishMetrics() {
+        if (stat.metrics->due()) {
+            updateStatisticCounters();
+            stat.metrics->publish(stat.exportPrometheus());
+        }
+    }
+
     /** Handle execution of the `bhir` */
     virtual void handleExecution(BhIR *bhir) = 0;
 
@@ -173,6 +187,19 @@ protected:
                                 const std::vector<uint64_t> &thread_stack,
                                 std::stringstream &out) = 0;
 
+    /** Write the source code that follows a loop, which is called after the closing bracket of the loop.
+     * Default we write nothing
+     *
+     * @param symbols       The symbol table
+     * @param scope         The scope
+     * @param block         The block
+     * @param out           The stream output
+     */
+    virtual void loopTailWriter(const SymbolTable &symbols,
+                                Scope &scope,
+                                const LoopB &block,
+                                std::stringstream &out) {}
+
     /** Write the source code of an instruction
      *
      * @param scope     The scope
@@ -80,6 +80,8 @@ public:
         using namespace std;
 
         const auto texecution = chrono::steady_clock::now();
+        const auto phases = stat.phaseTimers();
+        stat.tracer->beginFlush();
 
         map<string, bool> kernel_config = {
                 {"strides_as_var", comp.config.defaultGet<bool>("strides_as_var", true)},
@@ -127,8 +129,9 @@ public:
             const bool kernel_is_computing = not kernel.isSystemOnly();
 
             // Find the parallel blocks
+            // NB: scatter-adds are offloaded to the CPU since GPU threads might add to the same element
             std::vector<uint64_t> thread_stack;
-            if (kernel._block_list.size() == 1 and kernel_is_computing) {
+            if (kernel._block_list.size() == 1 and kernel_is_computing and not hasScatterAdd(kernel)) {
                 uint64_t nranks = parallel_ranks(kernel._block_list[0].getLoop()).first;
                 if (num_threads > 0 and nranks > 0) {
                     uint64_t nthds = static_cast<uint64_t>(kernel.size);
@@ -163,7 +166,11 @@ public:
                 }
             }
         }
-        stat.time_total_execution += chrono::steady_clock::now() - texecution;
+        const auto texecution_end = chrono::steady_clock::now();
+        stat.time_total_execution += texecution_end - texecution;
+        stat.tracer->record("flush", "flush", texecution, texecution_end, 0, bhir->instr_list.size());
+        stat.observeFlush(phases);
+        publishMetrics();
     }
 
     void handleExtmethod(BhIR *bhir) override {
@@ -182,7 +189,9 @@ public:
                 if (ext != comp.extmethods.end()) {
                     const auto texecution = std::chrono::steady_clock::now();
                     ext->second.execute(&instr, &*this); // Execute the extension method
-                    stat.time_ext_method += std::chrono::steady_clock::now() - texecution;
+                    const auto texecution_end = std::chrono::steady_clock::now();
+                    stat.observeExtmethod(texecution_end - texecution);
+                    stat.tracer->record("extmethod", "extmethod", texecution, texecution_end);
                 } else if (childext != comp.child_extmethods.end()) {
                     // We let the child component execute the instruction
                     std::set<bh_base *> ext_bases = instr.get_bases();
@@ -202,6 +211,16 @@ public:
     }
 
 private:
+    // Return true when `kernel` contains a scatter-add
+    static bool hasScatterAdd(const LoopB &kernel) {
+        for (const InstrPtr &instr: iterator::allInstr(kernel)) {
+            if (instr->opcode == BH_SCATTER_ADD) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     void cpuOffload(component::ComponentImpl &comp,
                     BhIR *bhir,
                     const LoopB &kernel,
@@ -236,7 +255,9 @@ private:
         }
         BhIR tmp_bhir(std::move(child_instr_list), bhir->getSyncs());
         comp.child.execute(&tmp_bhir);
-        stat.time_offload += chrono::steady_clock::now() - toffload;
+        const auto toffload_end = chrono::steady_clock::now();
+        stat.time_offload += toffload_end - toffload;
+        stat.tracer->record("offload", "offload", toffload, toffload_end, 0, tmp_bhir.instr_list.size());
     }
 
     void executeKernel(const LoopB &kernel,
@@ -272,7 +293,9 @@ private:
             stringstream ss;
             writeKernel(kernel, symbols, thread_stack, lookup.second, ss);
             string source = ss.str();
-            stat.time_codegen += chrono::steady_clock::now() - tcodegen;
+            const auto tcodegen_end = chrono::steady_clock::now();
+            stat.time_codegen += tcodegen_end - tcodegen;
+            stat.tracer->record("codegen", "codegen", tcodegen, tcodegen_end, lookup.second, source.size());
             execute(symbols, source, lookup.second, thread_stack, constants);
             codegen_cache.insert(std::move(source), kernel, symbols);
         }
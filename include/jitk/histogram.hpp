@@ -0,0 +1,111 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace bohrium {
+namespace jitk {
+
+/** A histogram of durations with a fixed memory footprint in the style of HdrHistogram, which counts durations
+ * in nanoseconds using log-linear buckets: each power of two is split into 32 linear sub-buckets thus the
+ * relative error of a reported value is at most 1/32 (~3%). Durations above 2^40 ns (~18 minutes) are counted
+ * in the last bucket. Recording a duration costs a few integer operations.
+ */
+class Histogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr size_t NUM_BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    void observe(const std::chrono::duration<double> &value) {
+        const double ns = value.count() * 1e9;
+        const uint64_t v = ns <= 0 ? 0 : ns >= static_cast<double>(uint64_t{1} << MAX_EXPONENT) ?
+                                         (uint64_t{1} << MAX_EXPONENT) - 1 : static_cast<uint64_t>(ns);
+        ++_buckets[bucketIndex(v)];
+        ++_count;
+        _sum += value.count();
+        _max = std::max(_max, value.count());
+    }
+
+    uint64_t count() const {
+        return _count;
+    }
+
+    // The sum of the durations in seconds
+    double sum() const {
+        return _sum;
+    }
+
+    // The largest duration in seconds
+    double max() const {
+        return _max;
+    }
+
+    // Number of durations less than or equal to `seconds` (rounded down to the nearest bucket boundary)
+    uint64_t countLessOrEqual(double seconds) const;
+
+    // The duration in seconds that the fraction `quantile` of the durations are less than or equal to
+    // (e.g. 0.99 gives the 99th percentile), or zero when empty. The result is the upper bound of the bucket
+    // of the percentile, which is capped by the largest duration.
+    double percentile(double quantile) const;
+
+    Histogram& operator+= (const Histogram& rhs) {
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            _buckets[i] += rhs._buckets[i];
+        }
+        _count += rhs._count;
+        _sum += rhs._sum;
+        _max = std::max(_max, rhs._max);
+        return *this;
+    }
+
+private:
+    std::array<uint64_t, NUM_BUCKETS> _buckets{};
+    uint64_t _count = 0;
+    double _sum = 0;
+    double _max = 0;
+
+    // The bucket of the value `v` in nanoseconds, which must be below 2^MAX_EXPONENT
+    static size_t bucketIndex(uint64_t v) {
+        if (v < 2 * SUB_BUCKET_COUNT) {
+            return v;
+        }
+        const int shift = 63 - __builtin_clzll(v) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKET_COUNT + (v >> shift);
+    }
+
+    // The largest value in nanoseconds that goes into the bucket `index`
+    static uint64_t bucketUpperBound(size_t index) {
+        if (index < 2 * SUB_BUCKET_COUNT) {
+            return index;
+        }
+        const uint64_t shift = index / SUB_BUCKET_COUNT - 1;
+        const uint64_t top = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+        return ((top + 1) << shift) - 1;
+    }
+};
+
+}
+} // namespace bohrium::jitk
@@ -0,0 +1,98 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The sort-and-partition pre-pass of large scatters and scatter-adds.
+// The scatter loop writes the destination and value of each element to buffers, which `bh_scatter_partition()`
+// then sorts by destination block (stable counting sort) and splits into one partition of destination blocks per
+// thread. Thus, no two threads write the same element and writes to the same element keep their original order.
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Number of destination blocks per thread
+#define BH_SCATTER_BLOCKS_PER_THREAD 64
+
+// Sort the `n` destinations in `dst` by destination block. On return, `*perm` is the sorted order of the element
+// indexes and partition `p` (of `*nparts`) consists of `(*perm)[i]` for `(*part)[p] <= i < (*part)[p + 1]`.
+// The caller must free `*perm` and `*part`.
+static void bh_scatter_partition(const uint64_t *dst, uint64_t n, uint64_t **perm, uint64_t **part,
+                                 uint64_t *nparts) {
+#ifdef _OPENMP
+    const uint64_t nthds = (uint64_t) omp_get_max_threads();
+#else
+    const uint64_t nthds = 1;
+#endif
+    const uint64_t nblocks = nthds * BH_SCATTER_BLOCKS_PER_THREAD;
+    *perm = malloc((n > 0 ? n : 1) * sizeof(uint64_t));
+    *part = calloc(nthds + 1, sizeof(uint64_t));
+    *nparts = nthds;
+    if (n == 0) {
+        return;
+    }
+
+    // Find the range of destinations and the size of the destination blocks
+    uint64_t dst_min = dst[0], dst_max = dst[0];
+    #pragma omp parallel for reduction(min:dst_min) reduction(max:dst_max)
+    for (uint64_t i = 0; i < n; ++i) {
+        dst_min = dst[i] < dst_min ? dst[i] : dst_min;
+        dst_max = dst[i] > dst_max ? dst[i] : dst_max;
+    }
+    const uint64_t block_size = (dst_max - dst_min) / nblocks + 1;
+
+    // Count the number of destinations in each block per input chunk. NB: we iterate over input chunks
+    // (rather than threads), which makes the result independent of the number of threads OpenMP gives us
+    uint64_t *count = calloc(nthds * nblocks, sizeof(uint64_t)); // Layout: [chunk][block]
+    const uint64_t chunk_size = (n + nthds - 1) / nthds;
+    #pragma omp parallel for schedule(static)
+    for (uint64_t c = 0; c < nthds; ++c) {
+        const uint64_t end = (c + 1) * chunk_size < n ? (c + 1) * chunk_size : n;
+        for (uint64_t i = c * chunk_size; i < end; ++i) {
+            ++count[c * nblocks + (dst[i] - dst_min) / block_size];
+        }
+    }
+
+    // Exclusive prefix sum in block-major and chunk-minor order, which makes the sort stable
+    uint64_t sum = 0;
+    for (uint64_t b = 0; b < nblocks; ++b) {
+        if (b % BH_SCATTER_BLOCKS_PER_THREAD == 0) {
+            (*part)[b / BH_SCATTER_BLOCKS_PER_THREAD] = sum;
+        }
+        for (uint64_t c = 0; c < nthds; ++c) {
+            const uint64_t tmp = count[c * nblocks + b];
+            count[c * nblocks + b] = sum;
+            sum += tmp;
+        }
+    }
+    (*part)[nthds] = sum;
+
+    // Sort the element indexes by destination block
+    #pragma omp parallel for schedule(static)
+    for (uint64_t c = 0; c < nthds; ++c) {
+        const uint64_t end = (c + 1) * chunk_size < n ? (c + 1) * chunk_size : n;
+        for (uint64_t i = c * chunk_size; i < end; ++i) {
+            (*perm)[count[c * nblocks + (dst[i] - dst_min) / block_size]++] = i;
+        }
+    }
+    free(count);
+}
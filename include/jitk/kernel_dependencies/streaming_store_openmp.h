@@ -0,0 +1,65 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Non-temporal (streaming) stores, which write directly to memory without reading the cache line first.
+// `BH_STREAM_STORE(ptr, value)` writes `value` to `ptr` and `BH_STREAM_FENCE()` orders all previous
+// non-temporal stores of the calling thread. The innermost loop also gets a `#pragma omp simd nontemporal(...)`
+// clause, which compilers that implement it (e.g. Clang) use to emit vector non-temporal stores. Compilers
+// without `__builtin_nontemporal_store()`, such as GCC, get the scalar non-temporal stores of SSE2 on x86-64,
+// and platforms without non-temporal stores get regular stores and no fence, thus they cost nothing.
+#pragma once
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_nontemporal_store)
+#define BH_STREAM_BUILTIN
+#endif
+#endif
+
+#if defined(BH_STREAM_BUILTIN) || (defined(__SSE2__) && defined(__x86_64__))
+#include <emmintrin.h>
+#define BH_STREAM_FENCE() _mm_sfence()
+#else
+#define BH_STREAM_FENCE() ((void) 0)
+#endif
+
+#if defined(BH_STREAM_BUILTIN)
+
+#define BH_STREAM_STORE(ptr, value) __builtin_nontemporal_store((value), (ptr))
+
+#elif defined(__SSE2__) && defined(__x86_64__)
+
+// NB: the union reinterprets the bits of the value (e.g. a double) as the integer that `movnti` stores
+#define BH_STREAM_STORE(ptr, value) do {                                                \
+    union {__typeof__(*(ptr)) v; int i32; long long i64;} _bh_stream_bits;              \
+    _bh_stream_bits.v = (value);                                                        \
+    if (sizeof(*(ptr)) == 8) {                                                          \
+        _mm_stream_si64((long long *) (ptr), _bh_stream_bits.i64);                      \
+    } else if (sizeof(*(ptr)) == 4) {                                                   \
+        _mm_stream_si32((int *) (ptr), _bh_stream_bits.i32);                            \
+    } else {                                                                            \
+        *(ptr) = _bh_stream_bits.v;                                                     \
+    }                                                                                   \
+} while (0)
+
+#else
+
+#define BH_STREAM_STORE(ptr, value) (*(ptr) = (value))
+
+#endif
@@ -0,0 +1,72 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Declares the SIMD variants of the transcendental functions found in glibc's libmvec.
+// The declarations make the compiler call the vector version (e.g. `_ZGVdN4v_exp`) when it vectorizes
+// a loop, thus a single `exp()` no longer prevents the vectorization of the whole fused loop.
+// Notice, the function names are in parentheses in order to avoid the function-like macros of <tgmath.h>.
+// Compilers or platforms without libmvec simply get the scalar versions.
+#pragma once
+
+#include <math.h>
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__GLIBC__) && \
+    defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 22)
+
+#define BH_VECTOR_MATH_DECL(name) \
+    __attribute__((__simd__("notinbranch"))) double (name)(double); \
+    __attribute__((__simd__("notinbranch"))) float (name##f)(float);
+#define BH_VECTOR_MATH_DECL2(name) \
+    __attribute__((__simd__("notinbranch"))) double (name)(double, double); \
+    __attribute__((__simd__("notinbranch"))) float (name##f)(float, float);
+
+// Available since glibc 2.22
+BH_VECTOR_MATH_DECL(exp)
+BH_VECTOR_MATH_DECL(log)
+BH_VECTOR_MATH_DECL(sin)
+BH_VECTOR_MATH_DECL(cos)
+BH_VECTOR_MATH_DECL2(pow)
+
+// Available since glibc 2.35
+#if __GLIBC_PREREQ(2, 35)
+BH_VECTOR_MATH_DECL(exp2)
+BH_VECTOR_MATH_DECL(expm1)
+BH_VECTOR_MATH_DECL(log2)
+BH_VECTOR_MATH_DECL(log10)
+BH_VECTOR_MATH_DECL(log1p)
+BH_VECTOR_MATH_DECL(tan)
+BH_VECTOR_MATH_DECL(sinh)
+BH_VECTOR_MATH_DECL(cosh)
+BH_VECTOR_MATH_DECL(tanh)
+BH_VECTOR_MATH_DECL(asin)
+BH_VECTOR_MATH_DECL(acos)
+BH_VECTOR_MATH_DECL(atan)
+BH_VECTOR_MATH_DECL(asinh)
+BH_VECTOR_MATH_DECL(acosh)
+BH_VECTOR_MATH_DECL(atanh)
+BH_VECTOR_MATH_DECL2(atan2)
+#endif
+
+#undef BH_VECTOR_MATH_DECL
+#undef BH_VECTOR_MATH_DECL2
+
+#endif
+#endif
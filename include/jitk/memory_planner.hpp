@@ -0,0 +1,96 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <vector>
+#include <set>
+#include <map>
+
+#include <bh_base.hpp>
+#include <jitk/block.hpp>
+#include <jitk/statistics.hpp>
+
+namespace bohrium {
+namespace jitk {
+
+/** Memory planner that packs the base arrays, which are both created and freed within a kernel list, into one
+ * arena allocation. The live range of a base array spans from the first kernel that access it to the kernel that
+ * frees it, which for a kernel temporary that stays an array (e.g. the input of a gather) is that one kernel.
+ * Base arrays with non-overlapping live ranges share memory by getting overlapping offsets in the arena.
+ * NB: the granularity is a kernel since the kernel arguments are `restrict` pointers thus two base arrays in the same
+ * kernel must never alias.
+ */
+class MemoryPlanner {
+private:
+    // The live range and arena offset of a planned base array
+    struct Plan {
+        size_t first; // Index of the first kernel that access the base array
+        size_t last;  // Index of the kernel that frees the base array
+        uint64_t offset; // Offset into the arena (in bytes)
+    };
+    std::map<bh_base *, Plan> _plans;
+
+    // The base arrays that become live in each kernel (indexed by the kernel index)
+    std::vector<std::vector<bh_base *> > _live_in;
+
+    // The arena and its size in bytes
+    void *_arena = nullptr;
+    uint64_t _arena_nbytes = 0;
+
+    // Total number of bytes of the planned base arrays (including alignment)
+    uint64_t _total_nbytes = 0;
+
+public:
+    /** Plan the memory of `kernel_list`
+     *
+     * @param kernel_list The kernels in execution order
+     * @param syncs       The base arrays that are synchronized, which are never planned
+     * @param min_nbytes  Only plan base arrays of this size or larger (in bytes), use -1 to plan nothing
+     */
+    MemoryPlanner(const std::vector<LoopB> &kernel_list, const std::set<bh_base *> &syncs, int64_t min_nbytes);
+
+    MemoryPlanner(const MemoryPlanner &) = delete;
+    MemoryPlanner &operator=(const MemoryPlanner &) = delete;
+
+    /// Frees the arena
+    ~MemoryPlanner();
+
+    /// Allocate the arena and record the plan in `stat`
+    void allocate(Statistics &stat);
+
+    /// Set the data pointer of the base arrays that become live in the kernel at `kernel_index`
+    void assignDataPtrs(size_t kernel_index);
+
+    /// Is `base` placed in the arena?
+    bool isPlanned(bh_base *base) const {
+        return _plans.find(base) != _plans.end();
+    }
+
+    /// Free `base`, which calls `bh_data_free()` unless `base` is placed in the arena
+    void free(bh_base *base);
+
+    /// Return the size of the arena in bytes
+    uint64_t arenaSize() const {
+        return _arena_nbytes;
+    }
+};
+
+} // jitk
+} // bohrium
@@ -0,0 +1,62 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace bohrium {
+namespace jitk {
+
+/** A file-based metrics endpoint, which scrapers (e.g. the textfile collector of the Prometheus node exporter)
+ * read while the process runs. The file is replaced atomically thus readers never see a partially written file.
+ */
+class MetricsEndpoint {
+public:
+    /** Create a new endpoint
+     *
+     * @param filename  The metrics file (the empty string disables the endpoint)
+     * @param interval  Minimum number of seconds between two updates of the file
+     */
+    MetricsEndpoint(std::string filename, double interval) : _filename(std::move(filename)),
+                                                             _interval(interval) {}
+
+    bool enabled() const {
+        return not _filename.empty();
+    }
+
+    // Return true when enabled and `interval` seconds have passed since the last publish
+    bool due() const {
+        return enabled() and (_num_published == 0 or
+                              std::chrono::steady_clock::now() - _last_published >= _interval);
+    }
+
+    // Replace the content of the metrics file with `text`
+    void publish(const std::string &text);
+
+private:
+    const std::string _filename;
+    const std::chrono::duration<double> _interval;
+    std::chrono::steady_clock::time_point _last_published;
+    uint64_t _num_published = 0;
+};
+
+}
+} // namespace bohrium::jitk
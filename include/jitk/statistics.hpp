@@ -20,19 +20,26 @@ If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <chrono>
+#include <cmath>
 #include <string>
 #include <ostream>
 #include <sstream>
 #include <fstream>
 #include <iomanip>
 #include <vector>
+#include <memory>
+#include <map>
 
 #include <colors.hpp>
 #include <bh_ir.hpp>
 #include <bh_instruction.hpp>
 #include <bh_config_parser.hpp>
+#include <bh_source_location.hpp>
 #include <jitk/symbol_table.hpp>
 #include <jitk/codegen_util.hpp>
+#include <jitk/tracer.hpp>
+#include <jitk/metrics.hpp>
+#include <jitk/histogram.hpp>
 
 namespace bohrium {
 namespace jitk {
@@ -44,13 +51,65 @@ std::string pprint_ratio(uint64_t a, uint64_t b) {
     ss << a << "/" << b << " (" << 100.0 * a / b << "%)";
     return ss.str();
 }
+
+// Escape `value` as a label value of the Prometheus text format
+std::string prometheus_escape(const std::string &value) {
+    std::string ret;
+    for (char c: value) {
+        if (c == '\\' or c == '"') {
+            ret += '\\';
+            ret += c;
+        } else if (c == '\n') {
+            ret += "\\n";
+        } else {
+            ret += c;
+        }
+    }
+    return ret;
 }
+}
+
+// Hardware performance counters of kernel launches, a negative value means that the counter is unavailable
+struct CounterValues {
+  int64_t cycles = -1;
+  int64_t instructions = -1;
+  int64_t llc_misses = -1;
+  int64_t bytes_read = -1;
+  int64_t bytes_written = -1;
+
+  bool any() const {
+    return cycles >= 0 or instructions >= 0 or llc_misses >= 0 or bytes_read >= 0 or bytes_written >= 0;
+  }
+
+  CounterValues& operator+= (const CounterValues& rhs) {
+    add(cycles, rhs.cycles);
+    add(instructions, rhs.instructions);
+    add(llc_misses, rhs.llc_misses);
+    add(bytes_read, rhs.bytes_read);
+    add(bytes_written, rhs.bytes_written);
+    return *this;
+  }
+
+private:
+  static void add(int64_t &a, int64_t b) {
+    if (b >= 0) {
+      a = std::max(a, int64_t{0}) + b;
+    }
+  }
+};
 
 struct KernelStats {
   uint64_t num_calls = 0;
   std::chrono::duration<double> total_time{0};
   std::chrono::duration<double> max_time{0};
   std::chrono::duration<double> min_time{std::numeric_limits<double>::infinity()};
+  Histogram exec_times; // The distribution of the execution time of each call
+  CounterValues counters; // Summed over all calls
+  uint64_t bytes_moved = 0; // Estimated bytes moved to and from main memory summed over all calls
+  uint64_t num_ops = 0; // Operations summed over all calls
+  uint64_t source_bytes = 0; // Size of the kernel source
+  std::chrono::duration<double> compile_time{0}; // Time to compile the kernel or to load it from the kernel cache
+  uint64_t compiler_rss = 0; // Peak resident set size of the compiler in bytes (zero when not measured)
 
   bool operator< (const KernelStats& rhs) const {
     // default ordering: by total time
@@ -62,9 +121,66 @@ struct KernelStats {
     total_time += exec_time;
     max_time = max(max_time, exec_time);
     min_time = min(min_time, exec_time);
+    exec_times.observe(exec_time);
+  }
+
+  void register_counters(const CounterValues& values) {
+    counters += values;
+  }
+
+  void register_work(const SymbolTable& symbols) {
+    bytes_moved += symbols.numBytesMoved();
+    num_ops += symbols.numOperations();
+  }
+
+  void register_compile(uint64_t source_size, const std::chrono::duration<double>& time, uint64_t rss) {
+    source_bytes = source_size;
+    compile_time += time;
+    compiler_rss = std::max(compiler_rss, rss);
+  }
+
+  // Achieved bandwidth in bytes per second
+  double bandwidth() const {
+    return bytes_moved / total_time.count();
+  }
+
+  // Achieved operations per second
+  double throughput() const {
+    return num_ops / total_time.count();
+  }
+
+  // Return the achieved fraction of the roofline `min(peak_ops, intensity * peak_bandwidth)`
+  double roofline_efficiency(double peak_bandwidth, double peak_ops) const {
+    double roof = peak_ops;
+    if (bytes_moved > 0) {
+      roof = std::min(roof, static_cast<double>(num_ops) / bytes_moved * peak_bandwidth);
+    }
+    return roof > 0 ? throughput() / roof : 0;
   }
 };
 
+// The kernel time attributed to a source location of the user program
+struct SourceStats {
+  uint64_t num_kernels = 0;
+  std::chrono::duration<double> total_time{0};
+
+  bool operator< (const SourceStats& rhs) const {
+    return this->total_time.count() < rhs.total_time.count();
+  }
+};
+
+namespace {
+// Pretty print the counter `value` divided by `scale` or "n/a" when unavailable
+std::string pprint_counter(int64_t value, double scale = 1) {
+    if (value < 0) {
+        return "n/a";
+    }
+    std::stringstream ss;
+    ss << std::scientific << std::setprecision(2) << value / scale;
+    return ss.str();
+}
+}
+
 class Statistics {
   public:
     bool enabled;
@@ -86,11 +202,21 @@ class Statistics {
     uint64_t num_blocks_out_of_fuser   = 0;
     uint64_t malloc_cache_lookups      = 0;
     uint64_t malloc_cache_misses       = 0;
+    uint64_t arena_allocations         = 0;
+    uint64_t arena_base_arrays         = 0;
+    uint64_t arena_max_reduction       = 0;
+    uint64_t kernel_source_bytes       = 0; // Source bytes of the compiled kernels
+    uint64_t compiler_max_rss          = 0; // Peak resident set size of the compiler in bytes
+    double compiler_cpu_time           = 0; // User and system seconds of the compiler
     std::chrono::duration<double> time_total_execution{0};
     std::chrono::duration<double> time_pre_fusion{0};
     std::chrono::duration<double> time_fusion{0};
     std::chrono::duration<double> time_codegen{0};
     std::chrono::duration<double> time_compile{0};
+    std::chrono::duration<double> time_compile_hash{0};     // Hashing the kernel sources
+    std::chrono::duration<double> time_compile_compiler{0}; // The compiler of the kernel cache misses
+    std::chrono::duration<double> time_compile_io{0};       // Disk I/O of the kernel cache
+    std::chrono::duration<double> time_compile_load{0};     // Loading the kernel binaries
     std::chrono::duration<double> time_exec{0};
     std::chrono::duration<double> time_offload{0};
     std::chrono::duration<double> time_copy2dev{0};
@@ -100,15 +226,106 @@ class Statistics {
     // key: kernel source filename, value: kernel statistics
     std::map<std::string, KernelStats> time_per_kernel;
 
+    // key: source location ID (see `bh_source_location_id()`), value: the kernel time of the source location
+    std::map<int64_t, SourceStats> time_per_source;
+
     std::chrono::duration<double> wallclock{0};
     std::chrono::time_point<std::chrono::steady_clock> time_started{std::chrono::steady_clock::now()};
 
+    // The machine peaks of the roofline model, which the engine might measure (zero means unknown)
+    double peak_bandwidth = 0; // bytes/s
+    double peak_ops = 0; // operations/s
+    // Kernels achieving less than this fraction of the roofline are flagged
+    double roofline_threshold;
+
+    // Per-thread recording of the pipeline phases, which is exported as a Chrome trace
+    std::shared_ptr<Tracer> tracer;
+
+    // The name of the component, which labels the exported metrics
+    std::string component_name;
+    // The live metrics of the long-running process in the Prometheus text format
+    std::shared_ptr<MetricsEndpoint> metrics;
+    // key: phase name (see `phaseTimers()`), value: the distribution of the phase time of each flush
+    std::map<std::string, Histogram> phase_histograms;
+
     Statistics(const ConfigParser &config) : enabled(config.defaultGet("prof", false)),
                                              print_on_exit(config.defaultGet("prof", false)),
-                                             verbose(config.defaultGet("verbose", false)) {}
+                                             verbose(config.defaultGet("verbose", false)),
+                                             roofline_threshold(config.defaultGet("roofline_threshold", 0.1)),
+                                             tracer(createTracer(config)),
+                                             component_name(config.getName()),
+                                             metrics(createMetrics(config)) {}
     Statistics(bool enabled, const ConfigParser &config) : enabled(enabled),
                                                            print_on_exit(config.defaultGet("prof", false)),
-                                                           verbose(config.defaultGet("verbose", false)) {}
+                                                           verbose(config.defaultGet("verbose", false)),
+                                                           roofline_threshold(config.defaultGet("roofline_threshold",
+                                                                                                0.1)),
+                                                           tracer(createTracer(config)),
+                                                           component_name(config.getName()),
+                                                           metrics(createMetrics(config)) {}
+
+    static std::shared_ptr<Tracer> createTracer(const ConfigParser &config) {
+        return std::make_shared<Tracer>(config.defaultGet("chrome_trace", false),
+                                        config.defaultGet<uint64_t>("chrome_trace_events", 1000000));
+    }
+
+    static std::shared_ptr<MetricsEndpoint> createMetrics(const ConfigParser &config) {
+        return std::make_shared<MetricsEndpoint>(config.defaultGet<std::string>("metrics_file", ""),
+                                                 config.defaultGet("metrics_interval", 10.0));
+    }
+
+    // Return the timers of the phases of a flush, which `observeFlush()` uses to find the phase times of a flush
+    std::vector<std::pair<const char *, std::chrono::duration<double> > > phaseTimers() const {
+        return {{"total_execution", time_total_execution},
+                {"pre_fusion",      time_pre_fusion},
+                {"fusion",          time_fusion},
+                {"codegen",         time_codegen},
+                {"compile",         time_compile},
+                {"exec",            time_exec},
+                {"copy2dev",        time_copy2dev},
+                {"copy2host",       time_copy2host},
+                {"offload",         time_offload}};
+    }
+
+    // Record the phase times of a flush where `before` is the `phaseTimers()` at the beginning of the flush
+    void observeFlush(const std::vector<std::pair<const char *, std::chrono::duration<double> > > &before) {
+        const auto after = phaseTimers();
+        for (size_t i = 0; i < after.size(); ++i) {
+            phase_histograms[after[i].first].observe(after[i].second - before[i].second);
+        }
+    }
+
+    // Record the time of one extension method call
+    void observeExtmethod(const std::chrono::duration<double> &time) {
+        time_ext_method += time;
+        phase_histograms["ext_method"].observe(time);
+    }
+
+    // Record the execution of the kernel of `symbols` in the Chrome trace, the size is the bytes of its arrays
+    void traceKernel(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end,
+                     uint64_t codegen_hash, const SymbolTable &symbols) {
+        if (tracer->enabled()) {
+            uint64_t nbytes = 0;
+            for (const bh_base *base: symbols.getParams()) {
+                nbytes += base->nbytes();
+            }
+            tracer->record("kernel", "exec", begin, end, codegen_hash, nbytes);
+        }
+    }
+
+    // Write the Chrome trace into the file of the config option `chrome_trace_file` and return a note for the user
+    std::string writeChromeTrace(const std::string &backend_name, const ConfigParser &config) const {
+        std::stringstream ss;
+        if (tracer->enabled()) {
+            const auto filename = config.defaultGet<std::string>("chrome_trace_file",
+                                                                 "bh_chrome_trace_" + config.getName() + ".json");
+            tracer->writeChromeTrace(filename);
+            ss << "[" << backend_name << "] Chrome trace written to '" << filename << "'\n";
+        } else {
+            ss << "[" << backend_name << "] Chrome trace is disabled (set `chrome_trace = true`)\n";
+        }
+        return ss.str();
+    }
 
     void write(std::string backend_name, std::string filename, std::ostream &out) {
         if (filename == "") {
@@ -134,7 +351,12 @@ class Statistics {
             out << "Malloc cache hits:               " << GRN << MallocCacheHits()                   << "\n" << RST;
             out << "\n";
             out << "Max memory usage:                " << GRN << memoryUsage() << " MB"              << "\n" << RST;
+            out << "Arena base arrays:               " << GRN << arenaBaseArrays()                   << "\n" << RST;
+            out << "Arena max memory reduction:      " << GRN << arenaMemoryReduction() << " MB"     << "\n" << RST;
             out << "Syncs to NumPy:                  " << GRN << num_syncs                           << "\n" << RST;
+            out << "Kernel source compiled:          " << GRN << kernelSourceCompiled()              << "\n" << RST;
+            out << "Compiler peak memory:            " << GRN << compiler_max_rss / 1024.0 / 1024.0 << " MB"
+                                                                                                     << "\n" << RST;
             out << "Total Work:                      " << GRN << totalwork << " operations"          << "\n" << RST;
             out << "Throughput:                      " << GRN << throughput() << "ops"               << "\n" << RST;
             out << "Work below par-threshold (1000): " << GRN << workBelowThredshold() << "%"        << "\n" << RST;
@@ -145,6 +367,11 @@ class Statistics {
             out << "  Fusion:                        " << YEL << time_fusion.count() << "s"          << "\n" << RST;
             out << "  Codegen:                       " << YEL << time_codegen.count() << "s"         << "\n" << RST;
             out << "  Compilation:                   " << YEL << time_compile.count() << "s"         << "\n" << RST;
+            out << "    Hashing:                     " << YEL << time_compile_hash.count() << "s"    << "\n" << RST;
+            out << "    Compiler:                    " << YEL << time_compile_compiler.count() << "s"
+                                                 << " (" << compiler_cpu_time << "s CPU)"            << "\n" << RST;
+            out << "    Disk I/O:                    " << YEL << time_compile_io.count() << "s"      << "\n" << RST;
+            out << "    Loading:                     " << YEL << time_compile_load.count() << "s"    << "\n" << RST;
             out << "  Exec:                          " << YEL << time_exec.count() << "s"            << "\n" << RST;
             out << "  Copy2dev:                      " << YEL << time_copy2dev.count() << "s"        << "\n" << RST;
             out << "  Copy2host:                     " << YEL << time_copy2host.count() << "s"       << "\n" << RST;
@@ -152,16 +379,57 @@ class Statistics {
             out << "  Other:                         " << YEL << timeOther() << "s"                  << "\n" << RST;
             out << "Ext-method:                      " << YEL << time_ext_method.count() << "s"      << "\n" << RST;
             out << "\n";
+            const auto flags = out.flags();
+            const auto precision = out.precision();
+            out << "Latency per flush (calls for ext-method):"                                          << "\n";
+            out << "  " << std::left << std::setw(31) << "Phase"
+                                     << std::setw(14) << "Count"
+                                     << std::setw(12) << "p50"
+                                     << std::setw(12) << "p99"
+                                     << std::setw(12) << "p999"
+                                     << std::setw(12) << "Max"                                         << "\n";
+            for (const auto &phase: phaseHistograms()) {
+              const Histogram &hist = *phase.second;
+              out << "  " << std::left << std::setw(31) << phase.first
+                  << std::right << YEL << std::setw(10) << hist.count() << "    "
+                  << std::scientific   << std::setprecision(2)
+                                       << std::setw(8) << hist.percentile(0.5)   << "s   "
+                                       << std::setw(8) << hist.percentile(0.99)  << "s   "
+                                       << std::setw(8) << hist.percentile(0.999) << "s   "
+                                       << std::setw(8) << hist.max()             << "s   "        << "\n" << RST;
+            }
+            out.flags(flags);
+            out.precision(precision);
+            out << "\n";
             out << BOLD << RED << "Unaccounted for (wall - total):  " << unaccounted() << "s\n" << RST;
 
             if (verbose) {
               out << "\n";
               out << BLU << "Per-kernel Profiling:"                                                  << "\n" << RST;
+              const bool roofline = peak_bandwidth > 0 and peak_ops > 0;
+              if (roofline) {
+                out << "  Roofline peaks: " << peak_bandwidth / 1e9 << " GB/s, " << peak_ops / 1e9 << " GFLOP/s"
+                    << " (kernels below " << roofline_threshold * 100 << "% are marked with '*')\n";
+              }
               out << "  " << std::left << std::setw(39) << "Kernel filename"
                                        << std::setw(14) << "Calls"
                                        << std::setw(12) << "Total time"
                                        << std::setw(12) << "Max time"
-                                       << std::setw(12) << "Min time"                                << "\n" << RST;
+                                       << std::setw(12) << "Min time"
+                                       << std::setw(12) << "p50"
+                                       << std::setw(12) << "p99"
+                                       << std::setw(12) << "p999"
+                                       << std::setw(11) << "GB/s"
+                                       << std::setw(11) << "GFLOP/s";
+              if (roofline) {
+                out << std::setw(11) << "Roofline";
+              }
+              const bool counters = hasCounters();
+              if (counters) {
+                out << std::setw(11) << "Cycles" << std::setw(11) << "IPC" << std::setw(11) << "LLC misses"
+                    << std::setw(11) << "Read MB" << std::setw(11) << "Written MB";
+              }
+              out << "\n" << RST;
               auto cmp = [](std::pair<std::string, KernelStats> const & a, std::pair<std::string, KernelStats> const & b) {
                 // compare map by values (descending)
                 return !(a.second < b.second);
@@ -177,7 +445,53 @@ class Statistics {
                     << std::scientific   << std::setprecision(2)
                                          << std::setw(8) << kernel_data.total_time.count() << "s   "
                                          << std::setw(8) << kernel_data.max_time.count()   << "s   "
-                                         << std::setw(8) << kernel_data.min_time.count()   << "s   " << "\n" << RST;
+                                         << std::setw(8) << kernel_data.min_time.count()   << "s   "
+                                         << std::setw(8) << kernel_data.exec_times.percentile(0.5)   << "s   "
+                                         << std::setw(8) << kernel_data.exec_times.percentile(0.99)  << "s   "
+                                         << std::setw(8) << kernel_data.exec_times.percentile(0.999) << "s   "
+                                         << std::setw(9) << kernel_data.bandwidth() / 1e9  << "  "
+                                         << std::setw(9) << kernel_data.throughput() / 1e9 << "  ";
+                if (roofline) {
+                  const double efficiency = kernel_data.roofline_efficiency(peak_bandwidth, peak_ops);
+                  out << std::fixed << std::setprecision(1) << std::setw(8) << efficiency * 100 << "%"
+                      << (efficiency < roofline_threshold ? "* " : "  ") << std::scientific;
+                }
+                if (counters) {
+                  const CounterValues &c = kernel_data.counters;
+                  const std::string ipc = c.cycles > 0 and c.instructions >= 0 ?
+                                          pprint_counter(c.instructions, static_cast<double>(c.cycles)) : "n/a";
+                  out << std::setw(9) << pprint_counter(c.cycles)                << "  "
+                      << std::setw(9) << ipc                                     << "  "
+                      << std::setw(9) << pprint_counter(c.llc_misses)            << "  "
+                      << std::setw(9) << pprint_counter(c.bytes_read, 1e6)       << "  "
+                      << std::setw(9) << pprint_counter(c.bytes_written, 1e6)    << "  ";
+                }
+                out << "\n" << RST;
+              }
+              pprintCompileCost(out);
+            }
+            if (not time_per_source.empty()) {
+              out << "\n";
+              out << BLU << "Per-source-line Profiling:"                                       << "\n" << RST;
+              out << "  " << std::left << std::setw(59) << "Source line"
+                                       << std::setw(14) << "Kernels"
+                                       << std::setw(12) << "Total time"
+                                       << std::setw(12) << "Share"                               << "\n" << RST;
+              std::vector<std::pair<int64_t, SourceStats> > tps_sorted(time_per_source.begin(),
+                                                                       time_per_source.end());
+              std::sort(std::begin(tps_sorted), std::end(tps_sorted),
+                        [](const std::pair<int64_t, SourceStats> &a, const std::pair<int64_t, SourceStats> &b) {
+                            return b.second < a.second;
+                        });
+              for (auto const &x : tps_sorted) {
+                out << "  "
+                    << std::left         << std::setw(59) << bh_source_location_name(x.first)
+                    << std::right << YEL << std::setw(10) << x.second.num_kernels         << "    "
+                    << std::scientific   << std::setprecision(2)
+                                         << std::setw(8) << x.second.total_time.count() << "s   "
+                    << std::fixed        << std::setprecision(1)
+                                         << std::setw(8) << 100.0 * x.second.total_time.count() / time_exec.count()
+                                         << "%" << "\n" << RST;
               }
             }
             out << endl;
@@ -205,16 +519,31 @@ class Statistics {
             file << "  array_contractions: "    << arrayContractions()               << "\n";
             file << "  outer_fusion_ratio: "    << outerFusionRatio()                << "\n";
             file << "  memory_usage: "          << memoryUsage()                     << "\n"; // mb
+            file << "  arena_base_arrays: "     << arena_base_arrays                 << "\n";
+            file << "  arena_allocations: "     << arena_allocations                 << "\n";
+            file << "  arena_max_memory_reduction: " << arenaMemoryReduction()       << "\n"; // mb
             file << "  syncs: "                 << num_syncs                         << "\n";
             file << "  total_work: "            << totalwork                         << "\n"; // ops
             file << "  throughput: "            << throughput()                      << "\n"; // ops
             file << "  work_below_thredshold: " << workBelowThredshold()             << "\n"; // %
+            file << "  kernel_source_bytes: "   << kernel_source_bytes               << "\n";
+            file << "  compiler_max_rss: "      << compiler_max_rss                  << "\n"; // bytes
+            file << "  compiler_cpu_time: "     << compiler_cpu_time                 << "\n"; // s
+            if (peak_bandwidth > 0 and peak_ops > 0) {
+              file << "  roofline:"                                                  << "\n";
+              file << "    peak_bandwidth: "    << peak_bandwidth                    << "\n"; // bytes/s
+              file << "    peak_ops: "          << peak_ops                          << "\n"; // ops/s
+            }
             file << "  timing:"                                                      << "\n";
             file << "    wall_clock: "          << wallclock.count()                 << "\n"; // s
             file << "    total_execution: "     << time_total_execution.count()      << "\n"; // s
             file << "    pre_fusion: "          << time_pre_fusion.count()           << "\n"; // s
             file << "    fusion: "              << time_fusion.count()               << "\n"; // s
             file << "    compile: "             << time_compile.count()              << "\n"; // s
+            file << "    compile_hash: "        << time_compile_hash.count()         << "\n"; // s
+            file << "    compile_compiler: "    << time_compile_compiler.count()     << "\n"; // s
+            file << "    compile_io: "          << time_compile_io.count()           << "\n"; // s
+            file << "    compile_load: "        << time_compile_load.count()         << "\n"; // s
             file << "    exec: "                                                     << "\n";
             file << "      total: "             << time_exec.count()                 << "\n"; // s
             if (verbose) {
@@ -226,6 +555,36 @@ class Statistics {
                 file << "            total_time: " << kernel_data.total_time.count() << "\n"; // s
                 file << "            max_time: "   << kernel_data.max_time.count()   << "\n"; // s
                 file << "            min_time: "   << kernel_data.min_time.count()   << "\n"; // s
+                file << "            p50: "  << kernel_data.exec_times.percentile(0.5)   << "\n"; // s
+                file << "            p99: "  << kernel_data.exec_times.percentile(0.99)  << "\n"; // s
+                file << "            p999: " << kernel_data.exec_times.percentile(0.999) << "\n"; // s
+                file << "            bytes_moved: " << kernel_data.bytes_moved       << "\n";
+                file << "            operations: "  << kernel_data.num_ops           << "\n";
+                file << "            bandwidth: "   << kernel_data.bandwidth()       << "\n"; // bytes/s
+                file << "            throughput: "  << kernel_data.throughput()      << "\n"; // ops/s
+                file << "            source_bytes: " << kernel_data.source_bytes     << "\n";
+                file << "            compile_time: " << kernel_data.compile_time.count() << "\n"; // s
+                file << "            compiler_rss: " << kernel_data.compiler_rss     << "\n"; // bytes
+                if (peak_bandwidth > 0 and peak_ops > 0) {
+                  file << "            roofline_efficiency: "
+                       << kernel_data.roofline_efficiency(peak_bandwidth, peak_ops)  << "\n";
+                }
+                const CounterValues &c = kernel_data.counters;
+                if (c.any()) { // Unavailable counters are null
+                  file << "            cycles: "        << yamlCounter(c.cycles)        << "\n";
+                  file << "            instructions: "  << yamlCounter(c.instructions)  << "\n";
+                  file << "            llc_misses: "    << yamlCounter(c.llc_misses)    << "\n";
+                  file << "            bytes_read: "    << yamlCounter(c.bytes_read)    << "\n";
+                  file << "            bytes_written: " << yamlCounter(c.bytes_written) << "\n";
+                }
+              }
+            }
+            if (not time_per_source.empty()) {
+              file << "      per_source_line: "                                      << "\n";
+              for (auto const& x : time_per_source) {
+                file << "        - \"" << bh_source_location_name(x.first) << "\": "   << "\n";
+                file << "            num_kernels: " << x.second.num_kernels          << "\n";
+                file << "            total_time: "  << x.second.total_time.count()   << "\n"; // s
               }
             }
             file << "    copy2dev: "            << time_copy2dev.count()             << "\n"; // s
@@ -233,10 +592,105 @@ class Statistics {
             file << "    offload: "             << time_offload.count()              << "\n"; // s
             file << "    other: "               << timeOther()                       << "\n"; // s
             file << "    unaccounted: "         << unaccounted()                     << "\n"; // s
+            file << "  latency:"                                                     << "\n";
+            for (const auto &phase: phaseHistograms()) {
+              const Histogram &hist = *phase.second;
+              file << "    " << phase.first << ":"                                   << "\n";
+              file << "      count: "  << hist.count()                               << "\n";
+              file << "      p50: "    << hist.percentile(0.5)                       << "\n"; // s
+              file << "      p99: "    << hist.percentile(0.99)                      << "\n"; // s
+              file << "      p999: "   << hist.percentile(0.999)                     << "\n"; // s
+              file << "      max: "    << hist.max()                                 << "\n"; // s
+            }
             file.close();
         }
     }
 
+    // Export the statistics as metrics in the Prometheus text format <https://prometheus.io>, which are labeled
+    // with the component name. Notice, the per-kernel metrics are only recorded when profiling is enabled.
+    std::string exportPrometheus() {
+        using namespace std;
+        wallclock = chrono::steady_clock::now() - time_started;
+        const string label = "component=\"" + prometheus_escape(component_name) + "\"";
+
+        stringstream ss;
+        ss << std::setprecision(10);
+        auto metric = [&](const char *name, const char *type, const char *help, uint64_t value) {
+            ss << "# HELP bohrium_" << name << " " << help << "\n";
+            ss << "# TYPE bohrium_" << name << " " << type << "\n";
+            ss << "bohrium_" << name << "{" << label << "} " << value << "\n";
+        };
+        ss << "# HELP bohrium_uptime_seconds Seconds since the statistics were reset.\n";
+        ss << "# TYPE bohrium_uptime_seconds gauge\n";
+        ss << "bohrium_uptime_seconds{" << label << "} " << wallclock.count() << "\n";
+        metric("syncs_total", "counter", "Arrays synchronized to the bridge.", num_syncs);
+        metric("work_operations_total", "counter", "Element-wise operations executed.", totalwork);
+        metric("base_arrays_total", "counter", "Base arrays in the executed kernels.", num_base_arrays);
+        metric("temp_arrays_total", "counter", "Base arrays removed by array contraction.", num_temp_arrays);
+        metric("fuser_instructions_total", "counter", "Instructions given to the fuser.", num_instrs_into_fuser);
+        metric("fuser_blocks_total", "counter", "Blocks returned by the fuser.", num_blocks_out_of_fuser);
+        metric("fuser_cache_lookups_total", "counter", "Fuser cache lookups.", fuser_cache_lookups);
+        metric("fuser_cache_misses_total", "counter", "Fuser cache misses.", fuser_cache_misses);
+        metric("codegen_cache_lookups_total", "counter", "Codegen cache lookups.", codegen_cache_lookups);
+        metric("codegen_cache_misses_total", "counter", "Codegen cache misses.", codegen_cache_misses);
+        metric("kernel_cache_lookups_total", "counter", "Kernel cache lookups.", kernel_cache_lookups);
+        metric("kernel_cache_misses_total", "counter", "Kernel cache misses (JIT compilations).",
+               kernel_cache_misses);
+        metric("malloc_cache_lookups_total", "counter", "Malloc cache lookups.", malloc_cache_lookups);
+        metric("malloc_cache_misses_total", "counter", "Malloc cache misses.", malloc_cache_misses);
+        metric("memory_usage_max_bytes", "gauge", "Maximum memory usage of the array data.", max_memory_usage);
+        metric("arena_allocations_total", "counter", "Arenas allocated by the memory planner.", arena_allocations);
+        metric("arena_base_arrays_total", "counter", "Base arrays placed in arenas.", arena_base_arrays);
+        metric("kernel_source_bytes_total", "counter", "Source bytes of the compiled kernels.", kernel_source_bytes);
+        metric("compiler_max_rss_bytes", "gauge", "Peak resident set size of the kernel compiler.", compiler_max_rss);
+
+        ss << "# HELP bohrium_phase_seconds_total Seconds spent in each phase.\n";
+        ss << "# TYPE bohrium_phase_seconds_total counter\n";
+        for (const auto &phase: phaseTimers()) {
+            ss << "bohrium_phase_seconds_total{" << label << ",phase=\"" << phase.first << "\"} "
+               << phase.second.count() << "\n";
+        }
+        ss << "bohrium_phase_seconds_total{" << label << ",phase=\"ext_method\"} " << time_ext_method.count()
+           << "\n";
+        ss << "# HELP bohrium_compile_seconds_total Seconds spent in each part of the compile phase.\n";
+        ss << "# TYPE bohrium_compile_seconds_total counter\n";
+        for (const auto &part: compileTimers()) {
+            ss << "bohrium_compile_seconds_total{" << label << ",part=\"" << part.first << "\"} "
+               << part.second.count() << "\n";
+        }
+
+        ss << "# HELP bohrium_phase_seconds The phase time of each flush (and of each extension method call).\n";
+        ss << "# TYPE bohrium_phase_seconds histogram\n";
+        for (const auto &phase: phase_histograms) {
+            const Histogram &hist = phase.second;
+            const string labels = label + ",phase=\"" + phase.first + "\"";
+            for (int i = 0; i < 28; ++i) { // Power-of-two bounds from one microsecond to about two minutes
+                const double bound = std::ldexp(1e-6, i);
+                ss << "bohrium_phase_seconds_bucket{" << labels << ",le=\"" << bound << "\"} "
+                   << hist.countLessOrEqual(bound) << "\n";
+            }
+            ss << "bohrium_phase_seconds_bucket{" << labels << ",le=\"+Inf\"} " << hist.count() << "\n";
+            ss << "bohrium_phase_seconds_sum{" << labels << "} " << hist.sum() << "\n";
+            ss << "bohrium_phase_seconds_count{" << labels << "} " << hist.count() << "\n";
+        }
+
+        if (not time_per_kernel.empty()) {
+            ss << "# HELP bohrium_kernel_calls_total Launches of each kernel.\n";
+            ss << "# TYPE bohrium_kernel_calls_total counter\n";
+            for (const auto &kernel: time_per_kernel) {
+                ss << "bohrium_kernel_calls_total{" << label << ",kernel=\"" << prometheus_escape(kernel.first)
+                   << "\"} " << kernel.second.num_calls << "\n";
+            }
+            ss << "# HELP bohrium_kernel_seconds_total Execution time of each kernel.\n";
+            ss << "# TYPE bohrium_kernel_seconds_total counter\n";
+            for (const auto &kernel: time_per_kernel) {
+                ss << "bohrium_kernel_seconds_total{" << label << ",kernel=\"" << prometheus_escape(kernel.first)
+                   << "\"} " << kernel.second.total_time.count() << "\n";
+            }
+        }
+        return ss.str();
+    }
+
     // Record statistics based on the 'bhir'
     void record(const BhIR &bhir) {
         if (enabled) {
@@ -250,6 +704,21 @@ class Statistics {
         }
     }
 
+    // Attribute the execution time `exec_time` of the kernel of `symbols` to its source locations, which splits
+    // the time proportionally to the number of elements each source location contributes to the kernel
+    void recordSourceTime(const SymbolTable &symbols, const std::chrono::duration<double> &exec_time) {
+        uint64_t total = 0;
+        for (const auto &weight: symbols.sourceWeights()) {
+            total += weight.second;
+        }
+        for (const auto &weight: symbols.sourceWeights()) {
+            SourceStats &source = time_per_source[weight.first];
+            ++source.num_kernels;
+            source.total_time += total > 0 ? exec_time * (static_cast<double>(weight.second) / total) :
+                                 exec_time / symbols.sourceWeights().size();
+        }
+    }
+
     // Record statistics based on the 'symbols'
     void record(const SymbolTable& symbols) {
       num_base_arrays += symbols.getNumBaseArrays();
@@ -257,6 +726,93 @@ class Statistics {
     }
 
   private:
+    // Return the timers of the parts of the compile phase
+    std::vector<std::pair<const char *, std::chrono::duration<double> > > compileTimers() const {
+        return {{"hash",     time_compile_hash},
+                {"compiler", time_compile_compiler},
+                {"io",       time_compile_io},
+                {"load",     time_compile_load}};
+    }
+
+    // Pretty print the kernels with the largest compile time, which lists their execution time next to it such
+    // that kernels that are expensive to compile and cheap to execute stand out
+    void pprintCompileCost(std::ostream &out) const {
+        const size_t max_kernels = 10;
+        std::vector<std::pair<std::string, const KernelStats *> > kernels;
+        for (const auto &x: time_per_kernel) {
+            if (x.second.compile_time.count() > 0) {
+                kernels.emplace_back(x.first, &x.second);
+            }
+        }
+        if (kernels.empty()) {
+            return;
+        }
+        std::sort(kernels.begin(), kernels.end(),
+                  [](const std::pair<std::string, const KernelStats *> &a,
+                     const std::pair<std::string, const KernelStats *> &b) {
+                      return a.second->compile_time > b.second->compile_time;
+                  });
+        const auto flags = out.flags();
+        const auto precision = out.precision();
+        out << "\n";
+        out << BLU << "Kernels by compile cost (kernels compiling longer than they execute are marked with '*'):"
+            << "\n" << RST;
+        out << "  " << std::left << std::setw(39) << "Kernel filename"
+                                 << std::setw(12) << "Compile"
+                                 << std::setw(12) << "Source KB"
+                                 << std::setw(12) << "Compiler MB"
+                                 << std::setw(14) << "Calls"
+                                 << std::setw(12) << "Exec time"
+                                 << std::setw(12) << "Compile/call"                              << "\n" << RST;
+        for (size_t i = 0; i < std::min(max_kernels, kernels.size()); ++i) {
+            const KernelStats &k = *kernels[i].second;
+            out << "  "
+                << std::left         << std::setw(39) << kernels[i].first
+                << std::right << YEL << std::scientific << std::setprecision(2)
+                                     << std::setw(8) << k.compile_time.count() << "s   "
+                << std::fixed        << std::setprecision(1)
+                                     << std::setw(9) << k.source_bytes / 1024.0 << "   "
+                                     << std::setw(9) << k.compiler_rss / 1024.0 / 1024.0 << "   "
+                                     << std::setw(10) << k.num_calls << "    "
+                << std::scientific   << std::setprecision(2)
+                                     << std::setw(8) << k.total_time.count() << "s   "
+                                     << std::setw(8) << k.compile_time.count() / std::max(k.num_calls, uint64_t{1})
+                                     << "s" << (k.compile_time > k.total_time ? "*" : " ")          << "\n" << RST;
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    // Return the phase histograms that recorded any time in pipeline order
+    std::vector<std::pair<std::string, const Histogram *> > phaseHistograms() const {
+        std::vector<std::pair<std::string, const Histogram *> > ret;
+        auto add = [&](const std::string &name) {
+            const auto it = phase_histograms.find(name);
+            if (it != phase_histograms.end() and it->second.sum() > 0) {
+                ret.emplace_back(name, &it->second);
+            }
+        };
+        for (const auto &phase: phaseTimers()) {
+            add(phase.first);
+        }
+        add("ext_method");
+        return ret;
+    }
+
+    // Return true when any kernel has hardware performance counters
+    bool hasCounters() const {
+        for (const auto &x: time_per_kernel) {
+            if (x.second.counters.any()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static std::string yamlCounter(int64_t value) {
+        return value < 0 ? "null" : std::to_string(value);
+    }
+
     std::string fuseCacheHits() {
         return pprint_ratio(fuser_cache_lookups - fuser_cache_misses, fuser_cache_lookups);
     }
@@ -277,6 +833,12 @@ class Statistics {
         return pprint_ratio(num_blocks_out_of_fuser, num_instrs_into_fuser);
     }
 
+    std::string kernelSourceCompiled() {
+        std::stringstream ss;
+        ss << kernel_source_bytes / 1024.0 << " KB in " << kernel_cache_misses << " kernels";
+        return ss.str();
+    }
+
     std::string MallocCacheHits() {
         return pprint_ratio(malloc_cache_lookups - malloc_cache_misses, malloc_cache_lookups);
     }
@@ -285,6 +847,16 @@ class Statistics {
         return max_memory_usage / 1024 / 1024;
     }
 
+    std::string arenaBaseArrays() {
+        std::stringstream ss;
+        ss << arena_base_arrays << " in " << arena_allocations << " arenas";
+        return ss.str();
+    }
+
+    double arenaMemoryReduction() {
+        return arena_max_reduction / 1024.0 / 1024.0;
+    }
+
     double throughput() {
         return (double) totalwork / (double) wallclock.count();
     }
@@ -114,6 +114,9 @@ struct IgnoreOneDim_less {
     }
 };
 
+/** Return the base array that `instr` accesses arbitrarily (e.g. the input of a gather), which must therefore
+ *  always be an array even when it is a kernel temporary, or nullptr when there is none */
+bh_base *array_always_base(const bh_instruction &instr);
 
 // The SymbolTable class contains all array meta date needed for a JIT kernel.
 class SymbolTable {
@@ -126,7 +129,21 @@ private:
     std::set<InstrPtr, Constant_less> _constant_set; // Set of instructions to a constant ID (Order by `origin_id`)
     std::set<bh_base*> _array_always; // Set of base arrays that should always be arrays
     std::vector<bh_base*> _params; // Vector of non-temporary arrays, which are the in-/out-puts of the JIT kernel
+    std::set<bh_base*> _streaming_stores; // Set of base arrays that should be written using non-temporal stores
+    std::vector<const bh_base*> _privatized; // Vector of scatter-add outputs small enough for a private copy per thread
     bool _useRandom; // Flag: is any instructions using random?
+    const LoopB *_kernel; // The kernel, which the work is estimated from on demand
+    mutable bool _work_estimated = false; // Flag: are the three members below up-to-date?
+    mutable uint64_t _num_bytes_moved = 0; // Estimated bytes that the kernel reads and writes in main memory
+    mutable uint64_t _num_operations = 0; // Number of element-wise operations that the kernel performs
+    mutable std::map<int64_t, uint64_t> _source_weights; // Mapping a source location ID to its share of the kernel
+
+    // Estimate the work of the kernel (`_num_bytes_moved`, `_num_operations`, and `_source_weights`) unless done.
+    // NB: only the profiling needs the work, thus we don't estimate it when the symbol table is created
+    void estimateWork() const;
+
+    // Find the outputs that are contiguous, write-only, and larger than `threshold` bytes
+    void findStreamingStores(const LoopB &kernel, int64_t threshold);
 
 public:
     // Should we declare scalar variables using the volatile keyword?
@@ -138,7 +155,20 @@ public:
     // Should we use constants as variables?
     const bool const_as_var;
 
-    SymbolTable(const LoopB &kernel, bool use_volatile, bool strides_as_var, bool index_as_var, bool const_as_var);
+    /** Create the symbol table of `kernel`
+     *
+     * @param kernel                     The kernel, which must outlive the symbol table when its work is queried
+     * @param use_volatile               Should we declare scalar variables using the volatile keyword?
+     * @param strides_as_var             Should we use start and strides as variables?
+     * @param index_as_var               Should we save index calculations in variables?
+     * @param const_as_var               Should we use constants as variables?
+     * @param streaming_store_threshold  Write outputs larger than this number of bytes using non-temporal stores
+     *                                   (use -1 to disable non-temporal stores)
+     * @param privatize_threshold        Give scatter-add outputs of this number of elements or fewer a private copy
+     *                                   per thread (use -1 to disable privatization)
+     */
+    SymbolTable(const LoopB &kernel, bool use_volatile, bool strides_as_var, bool index_as_var, bool const_as_var,
+                int64_t streaming_store_threshold = -1, int64_t privatize_threshold = -1);
 
     // Get the ID of 'base', throws exception if 'base' doesn't exist
     size_t baseID(const bh_base *base) const {
@@ -191,10 +221,44 @@ public:
     bool isAlwaysArray(const bh_base *base) const {
         return util::exist_nconst(_array_always, base);
     }
+    // Return true when 'base' should be written using non-temporal stores
+    bool isStreamingStore(const bh_base *base) const {
+        return util::exist_nconst(_streaming_stores, base);
+    }
+    // Is any array written using non-temporal stores?
+    bool useStreamingStores() const {
+        return not _streaming_stores.empty();
+    }
+    // Return true when the scatter-add output 'base' should get a private copy per thread
+    bool isPrivatized(const bh_base *base) const {
+        return util::exist_linearly(_privatized, base);
+    }
+    // Return the privatized scatter-add outputs in the order of their IDs. The kernel gets the number of elements
+    // of each as an argument, which makes the source independent of the output size
+    const std::vector<const bh_base*> &privatizedScatterAdds() const {
+        return _privatized;
+    }
     // Return non-temporary arrays, which are the in-/out-puts of the JIT kernel, in the order of their IDs
     const std::vector<bh_base*> &getParams() const {
         return _params;
     }
+    // Return the estimated number of bytes that the kernel moves to and from main memory, which is the
+    // read and the written part of each parameter. NB: temporaries that are contracted into scalars move nothing
+    uint64_t numBytesMoved() const {
+        estimateWork();
+        return _num_bytes_moved;
+    }
+    // Return the number of operations that the kernel performs (one per element of each computing instruction)
+    uint64_t numOperations() const {
+        estimateWork();
+        return _num_operations;
+    }
+    // Return the source locations (`bh_instruction::source_id`) of the kernel mapped to their share of the kernel,
+    // which is the number of elements their instructions process
+    const std::map<int64_t, uint64_t> &sourceWeights() const {
+        estimateWork();
+        return _source_weights;
+    }
     // Is any instructions use the random library?
     bool useRandom() const {
         return _useRandom;
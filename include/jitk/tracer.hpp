@@ -0,0 +1,125 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <ostream>
+
+namespace bohrium {
+namespace jitk {
+
+/** A low-overhead tracer of the phases of each flush, the kernel launches, and the extension methods.
+ * Each thread records its events into a ring buffer of its own, which grows until it keeps the latest `capacity`
+ * events, and the events are exported in the Chrome trace format (chrome://tracing or https://ui.perfetto.dev).
+ * NB: when disabled, recording an event only costs a branch.
+ */
+class Tracer {
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    struct Event {
+        const char *name;     // Must be a string literal
+        const char *category; // Must be a string literal
+        TimePoint begin;
+        TimePoint end;
+        uint64_t flush;       // The flush that the event belongs to
+        uint64_t hash;        // The kernel hash (zero when not a kernel)
+        int64_t size;         // E.g. number of instructions or bytes (negative when unknown)
+    };
+
+    /** Measures the lifetime of the object as an event, which is recorded on destruction */
+    class Scope {
+    private:
+        Tracer &_tracer;
+        const char *_name;
+        const char *_category;
+        TimePoint _begin;
+    public:
+        uint64_t hash = 0;
+        int64_t size = -1;
+
+        Scope(Tracer &tracer, const char *name, const char *category) : _tracer(tracer), _name(name),
+                                                                           _category(category) {
+            if (_tracer.enabled()) {
+                _begin = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Scope() {
+            if (_tracer.enabled()) {
+                _tracer.record(_name, _category, _begin, std::chrono::steady_clock::now(), hash, size);
+            }
+        }
+    };
+
+    /** Create a new tracer
+     *
+     * @param enabled   Whether to record events
+     * @param capacity  Number of events each thread keeps
+     */
+    Tracer(bool enabled, uint64_t capacity);
+
+    bool enabled() const {
+        return _enabled;
+    }
+
+    // Begin a new flush in the calling thread, which the following events of the thread belong to
+    void beginFlush();
+
+    // Record an event in the calling thread
+    void record(const char *name, const char *category, TimePoint begin, TimePoint end, uint64_t hash = 0,
+                int64_t size = -1);
+
+    // Write the recorded events as Chrome trace JSON
+    void writeChromeTrace(std::ostream &out) const;
+
+    // Write the recorded events as Chrome trace JSON into the file `filename`
+    void writeChromeTrace(const std::string &filename) const;
+
+private:
+    struct Ring {
+        mutable std::mutex mutex;
+        std::vector<Event> events;
+        uint64_t next = 0;  // Total number of events recorded
+        uint64_t flush = 0; // The current flush of the thread
+        uint64_t tid;
+        std::thread::id thread; // The thread that records into the ring
+    };
+
+    const bool _enabled;
+    const uint64_t _capacity;
+    const uint64_t _id; // Unique ID, which identifies the tracer in the thread local cache of rings
+    const TimePoint _start;
+    std::atomic<uint64_t> _num_flushes{0};
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<Ring> > _rings;
+
+    // The ring of the calling thread
+    Ring &ring();
+};
+
+}
+} // namespace bohrium::jitk
@@ -0,0 +1,30 @@
+import re
+import util
+
+
+class test_arena:
+    """ Test that the memory planner packs the base arrays that live and die within a flush into one arena, where
+        the arrays of non-overlapping live ranges share memory, including the kernel temporaries that stay arrays
+        (the outputs of the accumulations) """
+    def init(self):
+        code = "import bohrium as bh; from bohrium import backend_messaging as msg\n" \
+               "n = 100000; a = bh.arange(n, dtype=bh.float64)\n" \
+               "bh.flush(); msg.statistic_enable_and_reset(); res = bh.zeros(n)\n" \
+               "for i in range(4):\n" \
+               "    res += bh.add.accumulate(a * (i + 1)) * 2; res = res[::-1].copy()\n" \
+               "print('result: %r' % float(res.sum())); print(msg.statistic())\n"
+        for min_nbytes in [0, 1024]:
+            yield (code, min_nbytes)
+
+    def test_packing(self, args):
+        (code, min_nbytes) = args
+        out = util.openmp_output(code, arena_min_nbytes=min_nbytes)
+        planned = re.search(r"Arena base arrays:\s*(\d+) in (\d+) arenas", out)
+        reduction = re.search(r"Arena max memory reduction:\s*([0-9.e+-]+) MB", out)
+        # Besides the four reversed copies, the four accumulation outputs are kernel temporaries, which must be
+        # planned as well
+        found = planned is not None and int(planned.group(1)) >= 8 and int(planned.group(2)) == 1
+        # Reuse means that the arena is smaller than the sum of the arrays it holds
+        found = found and reduction is not None and float(reduction.group(1)) > 0
+        found = found and "result: %r" % 3333333333000000.0 in out
+        return ("res = True", "res = %s" % found)
@@ -0,0 +1,23 @@
+import util
+
+
+class test_fusion_graph:
+    """ Test programs whose fusion graph shrinks by many vertex removals, which must keep the edges of the remaining
+        vertices intact: a chain of temporaries with a reduction every `reduce_every` operation """
+    def init(self):
+        for shape in [(100, 100), (10, 10, 10)]:
+            for reduce_every in [4, 8]:
+                cmd = "R = bh.random.RandomState(42); a = R.random(%s, dtype=np.float64, bohrium=BH); " % (shape,)
+                cmd += "b = R.random(%s, dtype=np.float64, bohrium=BH); " % (shape,)
+                yield (cmd, reduce_every)
+
+    def test_chain_of_temporaries(self, args):
+        (cmd, reduce_every) = args
+        cmd += "ops = [M.add, M.multiply, M.subtract, M.maximum]; prev = a; res = 0\n"
+        cmd += "for i in range(16):\n"
+        cmd += "    out = ops[i % 4](prev, b)\n"
+        cmd += "    if (i + 1) %% %d == 0:\n" % reduce_every
+        cmd += "        res = res + M.add.reduce(out, axis=-1)\n"
+        cmd += "    prev = out\n"
+        cmd += "res = res + M.add.reduce(prev, axis=-1)\n"
+        return cmd
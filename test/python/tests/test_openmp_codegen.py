@@ -0,0 +1,40 @@
+import re
+import util
+
+
+class test_openmp_prefetch:
+    """ Test that the software prefetch of a gather looks ahead in the flattened index stream: an ELLPACK-like gather
+        of 8 indexes per row steps the row loop when the distance is not shorter than a row """
+    def init(self):
+        code = "import bohrium as bh; x = bh.arange(1000, dtype=bh.float64); " \
+               "idx = (bh.arange(8000, dtype=bh.uint64) * 7 % 1000).reshape(1000, 8); " \
+               "y = bh.add.reduce(x[idx], axis=1); print(y.sum())"
+        yield (code, 4, "i1 + 4 < 8")
+        yield (code, 8, "i0 + 1 < 1000")
+        yield (code, 20, "i0 + 3 < 1000")
+
+    def test_gather(self, args):
+        (code, distance, guard) = args
+        sources = util.openmp_kernel_sources(code, gather_prefetch_distance=distance)
+        prefetches = re.findall(r"if \(i(\d+) \+ (\d+) < (\d+)\) __builtin_prefetch", "".join(sources))
+        # The prefetch must be emitted with the expected guard, which the loop can satisfy
+        found = len(prefetches) > 0 and all(int(ahead) < int(size) for (_, ahead, size) in prefetches)
+        found = found and any("if (%s) __builtin_prefetch" % guard in src for src in sources)
+        return ("res = True", "res = %s" % found)
+
+
+class test_openmp_streaming_store:
+    """ Test that write-only outputs are written using non-temporal stores, which each thread fences at the end of
+        the parallel region of the loop rather than in a parallel region of its own """
+    def init(self):
+        code = "import bohrium as bh; a = bh.arange(100000, dtype=bh.float64); bh.flush(); " \
+               "b = a * 3 + 1; bh.flush(); assert b.sum() == 3 * 99999 * 100000 / 2 + 100000"
+        yield code
+
+    def test_fence(self, code):
+        sources = util.openmp_kernel_sources(code, streaming_store_threshold=0, compiler_openmp="true")
+        streamed = [src for src in sources if "BH_STREAM_STORE(" in src]
+        region = r"#pragma omp parallel\s*\{\s*#pragma omp for.*?BH_STREAM_FENCE\(\);\s*\}"
+        found = len(streamed) > 0 and all(re.search(region, src, re.DOTALL) is not None and
+                                          src.count("#pragma omp parallel") == 1 for src in streamed)
+        return ("res = True", "res = %s" % found)
@@ -0,0 +1,17 @@
+import util
+
+
+class test_prof_source_lines:
+    """ Test the attribution of the kernel time to the Python source lines of the array operations """
+    def init(self):
+        yield "R = bh.random.RandomState(42); a = R.random(1000, dtype=np.float64, bohrium=BH)\n"
+
+    def test_attribution(self, cmd):
+        # The Bohrium command runs as the file "<string>" and the array operation is on its third line
+        cmd_np = cmd + "res = True"
+        cmd_bh = cmd + "from bohrium import _bh, backend_messaging as msg; " \
+                       "msg.statistic_enable_and_reset(); prev = _bh.prof_source_lines(enable=True)\n"
+        cmd_bh += "b = a * 2 + 1\n"
+        cmd_bh += "bh.flush(); _bh.prof_source_lines(prev); stat = msg.statistic(); " \
+                  "res = '<string>:3' in stat and '<string>:4' not in stat"
+        return (cmd_np, cmd_bh)
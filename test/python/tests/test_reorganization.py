@@ -66,6 +66,25 @@ class test_scatter:
         return (np_cmd, bh_cmd)
 
 
+class test_scatter_add:
+    def init(self):
+        for ary, shape in util.gen_random_arrays("R", 3, max_dim=50, dtype="np.float64"):
+            nelem = functools.reduce(operator.mul, shape)
+            if nelem == 0:
+                continue
+            cmd = "R = bh.random.RandomState(42); res = %s; " % ary
+            cmd += "ind = M.arange(%d, dtype=np.int64).reshape(%s) %% %d; " % (nelem, shape, min(7, nelem))
+            cmd += "val = R.random(ind.shape, np.float64, bohrium=BH); "
+            yield cmd
+            yield cmd + "ind = ind[::2]; val = val[::2]; "
+
+    def test_scatter_add(self, cmd):
+        cmd += "res = res.flatten(); "
+        np_cmd = cmd + "np.add.at(res, ind, val)"
+        bh_cmd = cmd + "M.scatter_add(res, ind, val)"
+        return (np_cmd, bh_cmd)
+
+
 class test_nonzero:
     def init(self):
         for ary, shape in util.gen_random_arrays("R", 3, max_dim=50, dtype="np.float64"):
@@ -0,0 +1,25 @@
+import util
+
+
+class test_row_blocks:
+    """ Test arrays large enough for the cluster VEM (e.g. the `cluster_openmp` stack) to partition them into blocks
+        of rows across its workers: the row blocks, the halo rows of shifted views, the broadcasted rows, and the
+        combine of the reductions of the leading axis """
+    def init(self):
+        for shape in [(1000, 100), (301, 3, 100)]:
+            cmd = "R = bh.random.RandomState(42); a = R.random(%s, dtype=np.float64, bohrium=BH); " % (shape,)
+            cmd += "b = R.random(%s, dtype=np.float64, bohrium=BH); " % (shape[1:],)
+            yield cmd
+
+    def test_elementwise(self, cmd):
+        return cmd + "res = a * 2 + a; res += 1"
+
+    def test_halo(self, cmd):
+        return cmd + "res = a[2:] + a[1:-1] - a[:-2]"
+
+    def test_broadcast(self, cmd):
+        # The workers keep their copies of `b`, which must be renewed when `b` changes
+        return cmd + "res = a + b; b += 1; res += b"
+
+    def test_reduce(self, cmd):
+        return cmd + "res = M.add.reduce(a[1:], axis=0) + M.maximum.reduce(a * 2, axis=0)"
@@ -3,6 +3,12 @@ import numpy as np
 import random
 import operator
 import functools
+import os
+import sys
+import glob
+import shutil
+import tempfile
+import subprocess
 
 
 class TYPES:
@@ -142,3 +148,26 @@ def gen_random_arrays(random_state_name, max_ndim, max_dim=30, min_ndim=1, sampl
 def prod(a):
     """Returns the product of the elements in `a`"""
     return functools.reduce(operator.mul, a)
+
+
+def openmp_output(code, **options):
+    """Run the Python `code` in a new process on the OpenMP stack with the [openmp] config `options` and return
+       its output"""
+    env = dict(os.environ, BH_STACK="openmp")
+    for (name, value) in options.items():
+        env["BH_OPENMP_%s" % name.upper()] = str(value)
+    return subprocess.check_output([sys.executable, "-W", "ignore", "-c", code], env=env).decode()
+
+
+def openmp_kernel_sources(code, **options):
+    """Run the Python `code` like `openmp_output()` and return the source of the kernels it compiled"""
+    tmp_dir = tempfile.mkdtemp()
+    try:
+        openmp_output(code, verbose="true", tmp_dir=tmp_dir, **options)
+        ret = []
+        for filename in sorted(glob.glob(os.path.join(tmp_dir, "*", "src", "*.c"))):
+            with open(filename) as f:
+                ret.append(f.read())
+        return ret
+    finally:
+        shutil.rmtree(tmp_dir)
@@ -181,8 +181,11 @@ EngineCUDA::NDRanges(const vector<uint64_t> &thread_stack) const {
 }
 
 CUfunction EngineCUDA::getFunction(const string &source, const std::string &func_name) {
+    auto thash = chrono::steady_clock::now();
     uint64_t hash = util::hash(source);
     ++stat.kernel_cache_lookups;
+    const auto tstart = chrono::steady_clock::now();
+    stat.time_compile_hash += tstart - thash;
 
     // Do we have the program already?
     if (_functions.find(hash) != _functions.end()) {
@@ -192,8 +195,11 @@ CUfunction EngineCUDA::getFunction(const string &source, const std::string &func
     fs::path binfile = cache_bin_dir / jitk::hash_filename(compilation_hash, hash, ".cubin");
 
     // If the binary file of the kernel doesn't exist we create it
+    jitk::CompilerUsage usage;
+    auto tio = chrono::steady_clock::now();
     if (verbose or cache_bin_dir.empty() or not fs::exists(binfile)) {
         ++stat.kernel_cache_misses;
+        stat.kernel_source_bytes += source.size();
 
         // We create the binary file in the tmp dir
         binfile = tmp_bin_dir / jitk::hash_filename(compilation_hash, hash, ".cubin");
@@ -204,14 +210,22 @@ CUfunction EngineCUDA::getFunction(const string &source, const std::string &func
             std::string kernel_filename = jitk::hash_filename(compilation_hash, hash, ".cu");
             fs::path srcfile = jitk::write_source2file(source, tmp_src_dir,
                                                        kernel_filename, verbose);
-            compiler.compile(binfile.string(), srcfile.string());
+            const auto tcompiler = chrono::steady_clock::now();
+            stat.time_compile_io += tcompiler - tio;
+            usage = compiler.compile(binfile.string(), srcfile.string());
+            tio = chrono::steady_clock::now();
+            stat.time_compile_compiler += tio - tcompiler;
         }
         /* else {
             // Pipe the source directly into the compiler thus no source file is written
             compiler.compile(binfile.string(), source.c_str(), source.size());
         }
        */
+        stat.compiler_cpu_time += usage.cpu_time;
+        stat.compiler_max_rss = std::max(stat.compiler_max_rss, usage.max_rss);
     }
+    const auto tload = chrono::steady_clock::now();
+    stat.time_compile_io += tload - tio;
 
     CUmodule module;
     CUresult err = cuModuleLoad(&module, binfile.string().c_str());
@@ -236,6 +250,11 @@ CUfunction EngineCUDA::getFunction(const string &source, const std::string &func
         throw runtime_error("cuModuleGetFunction() failed");
     }
     _functions[hash] = program;
+    const auto tend = chrono::steady_clock::now();
+    stat.time_compile_load += tend - tload;
+    stat.time_per_kernel[jitk::hash_filename(compilation_hash, hash, ".cu")].register_compile(source.size(),
+                                                                                             tend - tstart,
+                                                                                             usage.max_rss);
     return program;
 }
 
@@ -288,7 +307,9 @@ void EngineCUDA::execute(const jitk::SymbolTable &symbols,
         func_name = t.str();
     }
     CUfunction program = getFunction(source, func_name);
-    stat.time_compile += chrono::steady_clock::now() - tcompile;
+    const auto tcompile_end = chrono::steady_clock::now();
+    stat.time_compile += tcompile_end - tcompile;
+    stat.tracer->record("compile", "compile", tcompile, tcompile_end, codegen_hash, source.size());
 
     // Let's execute the CUDA kernel
     vector<void *> args;
@@ -319,9 +340,15 @@ void EngineCUDA::execute(const jitk::SymbolTable &symbols,
                                      0, 0, &args[0], 0));
     check_cuda_errors(cuCtxSynchronize());
 
-    auto texec = chrono::steady_clock::now() - exec_start;
+    const auto end_exec = chrono::steady_clock::now();
+    auto texec = end_exec - exec_start;
     stat.time_exec += texec;
     stat.time_per_kernel[source_filename].register_exec_time(texec);
+    if (stat.enabled) { // Estimating the work is only worth it when profiling
+        stat.time_per_kernel[source_filename].register_work(symbols);
+        stat.recordSourceTime(symbols, texec);
+    }
+    stat.traceKernel(exec_start, end_exec, codegen_hash, symbols);
 }
 
 void EngineCUDA::setConstructorFlag(std::vector<bh_instruction *> &instr_list) {
@@ -133,17 +133,21 @@ public:
     // Copy 'bases' to the host (ignoring bases that isn't on the device)
     void copyToHost(const std::set<bh_base*> &bases) override {
         auto tcopy = std::chrono::steady_clock::now();
+        uint64_t nbytes = 0;
         // Let's copy sync'ed arrays back to the host
         for(bh_base *base: bases) {
             if (buffers.find(base) != buffers.end()) {
                 bh_data_malloc(base);
                 check_cuda_errors(cuMemcpyDtoH(base->getDataPtr(), buffers.at(base), base->nbytes()));
+                nbytes += base->nbytes();
                 // When syncing we assume that the host writes to the data and invalidate the device data thus
                 // we have to remove its data buffer
                 delBuffer(base);
             }
         }
-        stat.time_copy2host += std::chrono::steady_clock::now() - tcopy;
+        const auto tcopy_end = std::chrono::steady_clock::now();
+        stat.time_copy2host += tcopy_end - tcopy;
+        stat.tracer->record("copy2host", "copy", tcopy, tcopy_end, 0, nbytes);
     }
 
     // Copy 'base_list' to the device (ignoring bases that is already on the device)
@@ -159,6 +163,7 @@ public:
         }
 
         auto tcopy = std::chrono::steady_clock::now();
+        uint64_t nbytes = 0;
         for(bh_base *base: base_list) {
             if (buffers.find(base) == buffers.end()) { // We shouldn't overwrite existing buffers
                 auto new_buf = reinterpret_cast<CUdeviceptr>(malloc_cache.alloc(base->nbytes()));
@@ -167,10 +172,13 @@ public:
                 // If the host data is non-null we should copy it to the device
                 if (base->getDataPtr() != nullptr) {
                     check_cuda_errors(cuMemcpyHtoD(new_buf, base->getDataPtr(), base->nbytes()));
+                    nbytes += base->nbytes();
                 }
             }
         }
-        stat.time_copy2dev += std::chrono::steady_clock::now() - tcopy;
+        const auto tcopy_end = std::chrono::steady_clock::now();
+        stat.time_copy2dev += tcopy_end - tcopy;
+        stat.tracer->record("copy2dev", "copy", tcopy, tcopy_end, 0, nbytes);
     }
 
     // Copy all bases to the host (ignoring bases that isn't on the device)
@@ -266,7 +274,7 @@ public:
     }
 
     // Update statistics with final aggregated values of the engine
-    void updateFinalStatistics() override {
+    void updateStatisticCounters() override {
         stat.malloc_cache_lookups = malloc_cache.getTotalNumLookups();
         stat.malloc_cache_misses = malloc_cache.getTotalNumMisses();
     }
@@ -74,6 +74,8 @@ class Impl : public ComponentVE {
         } else if (msg == "statistic") {
             engine.updateFinalStatistics();
             stat.write("CUDA", "", ss);
+        } else if (msg == "chrome_trace") {
+            ss << stat.writeChromeTrace("CUDA", config);
         } else if (msg == "GPU: disable") {
             engine.copyAllBasesToHost();
             disabled = true;
@@ -121,6 +123,13 @@ Impl::~Impl() {
         engine.updateFinalStatistics();
         stat.write("CUDA", config.defaultGet<std::string>("prof_filename", ""), cout);
     }
+    if (stat.tracer->enabled()) {
+        try { // A destructor must not throw
+            stat.writeChromeTrace("CUDA", config);
+        } catch (const std::exception &e) {
+            cerr << "[CUDA] " << e.what() << endl;
+        }
+    }
 }
 
 void Impl::execute(BhIR *bhir) {
@@ -212,8 +212,11 @@ pair<cl::NDRange, cl::NDRange> EngineOpenCL::NDRanges(const vector<uint64_t> &th
 }
 
 cl::Program EngineOpenCL::getFunction(const string &source) {
+    auto thash = chrono::steady_clock::now();
     uint64_t hash = util::hash(source);
     ++stat.kernel_cache_lookups;
+    const auto tstart = chrono::steady_clock::now();
+    stat.time_compile_hash += tstart - thash;
 
     // Do we have the program already?
     if (_programs.find(hash) != _programs.end()) {
@@ -224,8 +227,12 @@ cl::Program EngineOpenCL::getFunction(const string &source) {
     cl::Program program;
 
     // If the binary file of the kernel doesn't exist we compile the source
-    if (verbose or cache_bin_dir.empty() or not fs::exists(binfile)) {
+    // NB: the OpenCL driver compiles within this process thus the compiler has no separate memory usage
+    const bool compile = verbose or cache_bin_dir.empty() or not fs::exists(binfile);
+    auto tio_end = chrono::steady_clock::now();
+    if (compile) {
         ++stat.kernel_cache_misses;
+        stat.kernel_source_bytes += source.size();
         std::string source_filename = jitk::hash_filename(compilation_hash, hash, ".cl");
         program = cl::Program(context, source);
         if (verbose) {
@@ -254,6 +261,7 @@ cl::Program EngineOpenCL::getFunction(const string &source) {
         }
 
         // And then we load the binary into a program
+        tio_end = chrono::steady_clock::now();
         const vector<cl::Device> dev_list = {device};
         const cl::Program::Binaries bin_list = {make_pair(&bin[0], bin.size())};
         program = cl::Program(context, dev_list, bin_list);
@@ -267,6 +275,15 @@ cl::Program EngineOpenCL::getFunction(const string &source) {
         throw;
     }
     _programs[hash] = program;
+    const auto tend = chrono::steady_clock::now();
+    stat.time_compile_io += tio_end - tstart;
+    if (compile) { // Building from source is the compilation
+        stat.time_compile_compiler += tend - tio_end;
+    } else { // Building from the binary is the loading
+        stat.time_compile_load += tend - tio_end;
+    }
+    stat.time_per_kernel[jitk::hash_filename(compilation_hash, hash, ".cl")].register_compile(source.size(),
+                                                                                             tend - tstart, 0);
     return program;
 }
 
@@ -288,7 +305,9 @@ void EngineOpenCL::execute(const jitk::SymbolTable &symbols,
         func_name = t.str();
     }
     cl::Program program = getFunction(source);
-    stat.time_compile += chrono::steady_clock::now() - tcompile;
+    const auto tcompile_end = chrono::steady_clock::now();
+    stat.time_compile += tcompile_end - tcompile;
+    stat.tracer->record("compile", "compile", tcompile, tcompile_end, codegen_hash, source.size());
 
     // Let's execute the OpenCL kernel
     cl::Kernel opencl_kernel = cl::Kernel(program, func_name.c_str());
@@ -361,26 +380,36 @@ void EngineOpenCL::execute(const jitk::SymbolTable &symbols,
     auto start_exec = chrono::steady_clock::now();
     queue.enqueueNDRangeKernel(opencl_kernel, cl::NullRange, ranges.first, ranges.second);
     queue.finish();
-    auto texec = chrono::steady_clock::now() - start_exec;
+    const auto end_exec = chrono::steady_clock::now();
+    auto texec = end_exec - start_exec;
     stat.time_exec += texec;
     stat.time_per_kernel[source_filename].register_exec_time(texec);
+    if (stat.enabled) { // Estimating the work is only worth it when profiling
+        stat.time_per_kernel[source_filename].register_work(symbols);
+        stat.recordSourceTime(symbols, texec);
+    }
+    stat.traceKernel(start_exec, end_exec, codegen_hash, symbols);
 }
 
 // Copy 'bases' to the host (ignoring bases that isn't on the device)
 void EngineOpenCL::copyToHost(const std::set<bh_base *> &bases) {
     auto tcopy = std::chrono::steady_clock::now();
+    uint64_t nbytes = 0;
     // Let's copy sync'ed arrays back to the host
     for (bh_base *base: bases) {
         if (util::exist(buffers, base)) {
             bh_data_malloc(base);
             queue.enqueueReadBuffer(*buffers.at(base), CL_FALSE, 0, (cl_ulong) base->nbytes(), base->getDataPtr());
+            nbytes += base->nbytes();
             // When syncing we assume that the host writes to the data and invalidate the device data thus
             // we have to remove its data buffer
             delBuffer(base);
         }
     }
     queue.finish();
-    stat.time_copy2host += std::chrono::steady_clock::now() - tcopy;
+    const auto tcopy_end = std::chrono::steady_clock::now();
+    stat.time_copy2host += tcopy_end - tcopy;
+    stat.tracer->record("copy2host", "copy", tcopy, tcopy_end, 0, nbytes);
 }
 
 // Copy 'base_list' to the device (ignoring bases that is already on the device)
@@ -395,6 +424,7 @@ void EngineOpenCL::copyToDevice(const std::set<bh_base *> &base_list) {
     }
 
     auto tcopy = std::chrono::steady_clock::now();
+    uint64_t nbytes = 0;
     for (bh_base *base: base_list) {
         if (not util::exist(buffers, base)) { // We shouldn't overwrite existing buffers
             cl::Buffer *buf = createBuffer(base);
@@ -402,11 +432,14 @@ void EngineOpenCL::copyToDevice(const std::set<bh_base *> &base_list) {
             // If the host data is non-null we should copy it to the device
             if (base->getDataPtr() != nullptr) {
                 queue.enqueueWriteBuffer(*buf, CL_FALSE, 0, (cl_ulong) base->nbytes(), base->getDataPtr());
+                nbytes += base->nbytes();
             }
         }
     }
     queue.finish();
-    stat.time_copy2dev += std::chrono::steady_clock::now() - tcopy;
+    const auto tcopy_end = std::chrono::steady_clock::now();
+    stat.time_copy2dev += tcopy_end - tcopy;
+    stat.tracer->record("copy2dev", "copy", tcopy, tcopy_end, 0, nbytes);
 }
 
 void EngineOpenCL::setConstructorFlag(std::vector<bh_instruction *> &instr_list) {
@@ -73,6 +73,8 @@ class Impl : public ComponentVE {
         } else if (msg == "statistic") {
             engine.updateFinalStatistics();
             stat.write("OpenCL", "", ss);
+        } else if (msg == "chrome_trace") {
+            ss << stat.writeChromeTrace("OpenCL", config);
         } else if (msg == "GPU: disable") {
             engine.copyAllBasesToHost();
             disabled = true;
@@ -136,6 +138,13 @@ Impl::~Impl() {
         engine.updateFinalStatistics();
         stat.write("OpenCL", config.defaultGet<std::string>("prof_filename", ""), cout);
     }
+    if (stat.tracer->enabled()) {
+        try { // A destructor must not throw
+            stat.writeChromeTrace("OpenCL", config);
+        } catch (const std::exception &e) {
+            cerr << "[OpenCL] " << e.what() << endl;
+        }
+    }
 }
 
 void Impl::execute(BhIR *bhir) {
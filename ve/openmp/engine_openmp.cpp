@@ -42,9 +42,25 @@ namespace fs = boost::filesystem;
 
 namespace bohrium {
 
+namespace {
+// Return the compile command of `config` including the flags of the vector math and the fast math options
+string compiler_command(const ConfigParser &config) {
+    stringstream ss;
+    ss << config.get<string>("compiler_cmd");
+    if (config.defaultGet<bool>("compiler_fast_math", false)) {
+        ss << " -ffast-math";
+    }
+    if (config.defaultGet<bool>("compiler_vector_math", false)) {
+        ss << " -lmvec -lm";
+    }
+    return ss.str();
+}
+}
+
 EngineOpenMP::EngineOpenMP(component::ComponentVE &comp, jitk::Statistics &stat) :
-        EngineCPU(comp, stat), compiler(comp.config.get<string>("compiler_cmd"),
-                                        comp.config.file_dir.string(), verbose) {
+        EngineCPU(comp, stat), compiler(compiler_command(comp.config),
+                                        comp.config.file_dir.string(), verbose),
+        _counters(comp.config.defaultGet<bool>("prof_counters", false)) {
 
     compilation_hash = util::hash(compiler.cmd_template);
 
@@ -111,8 +127,11 @@ EngineOpenMP::~EngineOpenMP() {
 }
 
 KernelFunction EngineOpenMP::getFunction(const string &source, const std::string &func_name) {
+    auto thash = chrono::steady_clock::now();
     uint64_t hash = util::hash(source);
     ++stat.kernel_cache_lookups;
+    const auto tstart = chrono::steady_clock::now();
+    stat.time_compile_hash += tstart - thash;
 
     // Do we have the function compiled and ready already?
     if (_functions.find(hash) != _functions.end()) {
@@ -122,23 +141,37 @@ KernelFunction EngineOpenMP::getFunction(const string &source, const std::string
     fs::path binfile = cache_bin_dir / jitk::hash_filename(compilation_hash, hash, ".so");
 
     // If the binary file of the kernel doesn't exist we create it
+    jitk::CompilerUsage usage;
+    auto tio = chrono::steady_clock::now();
     if (verbose or cache_bin_dir.empty() or not fs::exists(binfile)) {
         ++stat.kernel_cache_misses;
+        stat.kernel_source_bytes += source.size();
 
         // We create the binary file in the tmp dir
         binfile = tmp_bin_dir / jitk::hash_filename(compilation_hash, hash, ".so");
 
         // Write the source file and compile it (reading from disk)
         // NB: this is a nice debug option, but will hurt performance
+        fs::path srcfile;
         if (verbose) {
             std::string source_filename = jitk::hash_filename(compilation_hash, hash, ".c");
-            fs::path srcfile = jitk::write_source2file(source, tmp_src_dir, source_filename, true);
-            compiler.compile(binfile.string(), srcfile.string());
+            srcfile = jitk::write_source2file(source, tmp_src_dir, source_filename, true);
+        }
+        const auto tcompiler = chrono::steady_clock::now();
+        stat.time_compile_io += tcompiler - tio;
+        if (verbose) {
+            usage = compiler.compile(binfile.string(), srcfile.string());
         } else {
             // Pipe the source directly into the compiler thus no source file is written
-            compiler.compile(binfile.string(), source.c_str(), source.size());
+            usage = compiler.compile(binfile.string(), source.c_str(), source.size());
         }
+        tio = chrono::steady_clock::now();
+        stat.time_compile_compiler += tio - tcompiler;
+        stat.compiler_cpu_time += usage.cpu_time;
+        stat.compiler_max_rss = std::max(stat.compiler_max_rss, usage.max_rss);
     }
+    const auto tload = chrono::steady_clock::now();
+    stat.time_compile_io += tload - tio;
 
     // Load the shared library
     void *lib_handle = dlopen(binfile.string().c_str(), RTLD_NOW);
@@ -158,6 +191,11 @@ KernelFunction EngineOpenMP::getFunction(const string &source, const std::string
         cerr << "Cannot load function launcher(): " << dlsym_error << endl;
         throw runtime_error("VE-OPENMP: Cannot load function launcher()");
     }
+    const auto tend = chrono::steady_clock::now();
+    stat.time_compile_load += tend - tload;
+    stat.time_per_kernel[jitk::hash_filename(compilation_hash, hash, ".c")].register_compile(source.size(),
+                                                                                            tend - tstart,
+                                                                                            usage.max_rss);
     return _functions.at(hash);
 }
 
@@ -186,7 +224,9 @@ void EngineOpenMP::execute(const jitk::SymbolTable &symbols,
     }
     KernelFunction func = getFunction(source, func_name);
     assert(func != nullptr);
-    stat.time_compile += chrono::steady_clock::now() - tbuild;
+    const auto tbuild_end = chrono::steady_clock::now();
+    stat.time_compile += tbuild_end - tbuild;
+    stat.tracer->record("compile", "compile", tbuild, tbuild_end, codegen_hash, source.size());
 
     // Create a 'data_list' of data pointers
     vector<void *> data_list;
@@ -207,6 +247,10 @@ void EngineOpenMP::execute(const jitk::SymbolTable &symbols,
             offset_and_strides.push_back(s);
         }
     }
+    // Followed by the number of elements of the privatized scatter-add outputs
+    for (const bh_base *base: symbols.privatizedScatterAdds()) {
+        offset_and_strides.push_back(static_cast<uint64_t>(base->nelem()));
+    }
 
     // And the constants
     vector<bh_constant_value> constant_arg;
@@ -215,12 +259,24 @@ void EngineOpenMP::execute(const jitk::SymbolTable &symbols,
         constant_arg.push_back(instr->constant.value);
     }
 
+    if (_counters.available()) {
+        _counters.start();
+    }
     auto start_exec = chrono::steady_clock::now();
     // Call the launcher function, which will execute the kernel
     func(&data_list[0], &offset_and_strides[0], &constant_arg[0]);
-    auto texec = chrono::steady_clock::now() - start_exec;
+    const auto end_exec = chrono::steady_clock::now();
+    auto texec = end_exec - start_exec;
     stat.time_exec += texec;
     stat.time_per_kernel[source_filename].register_exec_time(texec);
+    if (stat.enabled) { // Estimating the work is only worth it when profiling
+        stat.time_per_kernel[source_filename].register_work(symbols);
+        stat.recordSourceTime(symbols, texec);
+    }
+    if (_counters.available()) {
+        stat.time_per_kernel[source_filename].register_counters(_counters.stop());
+    }
+    stat.traceKernel(start_exec, end_exec, codegen_hash, symbols);
 
 }
 
@@ -230,6 +286,20 @@ void EngineOpenMP::loopHeadWriter(const jitk::SymbolTable &symbols,
                                   const jitk::LoopB &block,
                                   const vector<uint64_t> &thread_stack,
                                   stringstream &out) {
+    // Large 1-D scatters write their destinations and values to buffers, which `loopTailWriter()` then
+    // sorts by destination and writes in parallel without atomics
+    if (block.rank == 0) {
+        for (const jitk::InstrPtr &instr: partitioned_scatters(block, scatterPartitionThreshold())) {
+            const size_t id = _partitioned_scatters.size();
+            const string type = writeType(instr->operand[0].base->dtype());
+            out << "uint64_t *sd" << id << " = malloc(" << block.size << " * sizeof(uint64_t));\n";
+            util::spaces(out, 4);
+            out << type << " *sv" << id << " = malloc(" << block.size << " * sizeof(" << type << "));\n";
+            util::spaces(out, 4);
+            _partitioned_scatters[instr.get()] = id;
+        }
+    }
+
     // Let's write the OpenMP loop header
     int64_t for_loop_size = block.size;
     // No need to parallel one-sized loops
@@ -247,6 +317,126 @@ void EngineOpenMP::loopHeadWriter(const jitk::SymbolTable &symbols,
     out << itername << " < " << block.size << "; ++" << itername << ") {\n";
 }
 
+// Writes the fence of the non-temporal stores of the loop and the sort-and-partition pre-pass of the scatters
+// buffered in the loop followed by the parallel write, where each thread writes (or adds) the values of its own
+// partition of destinations
+void EngineOpenMP::loopTailWriter(const jitk::SymbolTable &symbols,
+                                  jitk::Scope &scope,
+                                  const jitk::LoopB &block,
+                                  std::stringstream &out) {
+    if (block.rank != 0) {
+        return;
+    }
+    // Fence the non-temporal stores of the loop in its parallel region (if any) before the region ends
+    if (use_streaming_stores(block, symbols)) {
+        util::spaces(out, _fence_region ? 8 : 4);
+        out << "BH_STREAM_FENCE();\n";
+        if (_fence_region) {
+            util::spaces(out, 4);
+            out << "}\n";
+        }
+    }
+    _fence_region = false;
+    for (const jitk::InstrPtr &instr: jitk::iterator::allLocalInstr(block)) {
+        auto it = _partitioned_scatters.find(instr.get());
+        if (it == _partitioned_scatters.end()) {
+            continue;
+        }
+        const size_t id = it->second;
+        const string n = std::to_string(id);
+        util::spaces(out, 4);
+        out << "uint64_t *sp" << n << ", *sb" << n << ", np" << n << ";\n";
+        util::spaces(out, 4);
+        out << "bh_scatter_partition(sd" << n << ", " << block.size << ", &sp" << n << ", &sb" << n << ", &np"
+            << n << ");\n";
+        util::spaces(out, 4);
+        out << "#pragma omp parallel for schedule(static)\n";
+        util::spaces(out, 4);
+        out << "for (uint64_t p = 0; p < np" << n << "; ++p) {\n";
+        util::spaces(out, 8);
+        out << "for (uint64_t i = sb" << n << "[p]; i < sb" << n << "[p + 1]; ++i) {\n";
+        util::spaces(out, 12);
+        out << "a" << symbols.baseID(instr->operand[0].base) << "[sd" << n << "[sp" << n << "[i]]] "
+            << (instr->opcode == BH_SCATTER_ADD ? "+=" : "=") << " sv" << n << "[sp" << n << "[i]];\n";
+        util::spaces(out, 8);
+        out << "}\n";
+        util::spaces(out, 4);
+        out << "}\n";
+        util::spaces(out, 4);
+        out << "free(sd" << n << "); free(sv" << n << "); free(sp" << n << "); free(sb" << n << ");\n";
+    }
+}
+
+void EngineOpenMP::writeInstr(jitk::Scope &scope, const bh_instruction &instr, int indent, bool opencl,
+                              std::stringstream &out) {
+    // A partitioned scatter writes its destination and value to the buffers of the pre-pass
+    if (_partitioned_scatters.count(&instr) > 0) {
+        const size_t id = _partitioned_scatters.at(&instr);
+        out << "sd" << id << "[i0] = " << instr.operand[0].start << " + ";
+        scope.getName(instr.operand[2], out);
+        if (scope.isArray(instr.operand[2])) {
+            write_array_subscription(scope, instr.operand[2], out);
+        }
+        out << ";\n";
+        util::spaces(out, indent);
+        out << "sv" << id << "[i0] = ";
+        scope.getName(instr.operand[1], out);
+        if (scope.isArray(instr.operand[1])) {
+            write_array_subscription(scope, instr.operand[1], out);
+        }
+        out << ";\n";
+        return;
+    }
+
+    const int64_t distance = comp.config.defaultGet<int64_t>("gather_prefetch_distance", 0);
+    if (distance > 0 and (instr.opcode == BH_GATHER or instr.opcode == BH_SCATTER or
+                          instr.opcode == BH_COND_SCATTER or instr.opcode == BH_SCATTER_ADD) and
+        _guarded_scatter_adds.count(&instr) == 0) {
+        stringstream ss;
+        writePrefetch(scope, instr, distance, ss);
+        if (not ss.str().empty()) {
+            out << ss.str();
+            util::spaces(out, indent);
+        }
+    }
+    Engine::writeInstr(scope, instr, indent, opencl, out);
+}
+
+void EngineOpenMP::writePrefetch(const jitk::Scope &scope, const bh_instruction &instr, int64_t distance,
+                                 std::stringstream &out) {
+    const bh_view &index = instr.operand[2];
+    const bh_view &table = instr.opcode == BH_GATHER ? instr.operand[1] : instr.operand[0];
+    // We read ahead in the index array itself, which must therefore be a kernel parameter
+    if (table.isConstant() or index.isConstant() or index.ndim == 0 or
+        not util::exist_linearly(scope.symbols.getParams(), index.base)) {
+        return;
+    }
+    // We look `distance` iterations ahead in the flattened index stream. Since an inner loop may be shorter than
+    // `distance` (e.g. the 8 non-zeros per row of an ELLPACK gather), we step the outermost dimension needed, which
+    // looks ahead `ahead * inner >= distance` iterations, e.g. the same column of the next row.
+    int64_t dim = index.ndim - 1;
+    int64_t inner = 1; // Number of iterations per step of dimension `dim`
+    while (dim >= 0 and (distance + inner - 1) / inner >= index.shape[dim]) {
+        inner *= index.shape[dim];
+        --dim;
+    }
+    if (dim < 0) {
+        return; // The whole index stream is shorter than `distance`
+    }
+    const int64_t ahead = (distance + inner - 1) / inner;
+    stringstream stride;
+    if (scope.symbols.strides_as_var and scope.symbols.existOffsetStridesID(index)) {
+        stride << "vs" << scope.symbols.offsetStridesID(index) << "_" << dim;
+    } else {
+        stride << index.stride[dim];
+    }
+    out << "if (i" << dim << " + " << ahead << " < " << index.shape[dim] << ") __builtin_prefetch(&";
+    scope.getName(table, out);
+    out << "[" << table.start << " + a" << scope.symbols.baseID(index.base) << "[(";
+    write_array_index(scope, index, out);
+    out << ") + " << ahead << " * " << stride.str() << "]], " << (instr.opcode == BH_GATHER ? 0 : 1) << ");\n";
+}
+
 // Writing the OpenMP header, which include "parallel for" and "simd"
 void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
                                jitk::Scope &scope,
@@ -267,7 +457,10 @@ void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
     stringstream ss;
     // "OpenMP for" goes to the outermost loop
     if (block.rank == 0 and openmp_compatible(block)) {
-        ss << " parallel for";
+        // Non-temporal stores are weakly ordered, thus each thread must fence its stores before the parallel
+        // region ends. In this case, the loop gets its own parallel region (see `loopTailWriter()`).
+        _fence_region = use_streaming_stores(block, symbols);
+        ss << (_fence_region ? " for" : " parallel for");
         // Since we are doing parallel for, we should either do OpenMP reductions or protect the sweep instructions
         for (const jitk::InstrPtr &instr: ordered_block_sweeps) {
             assert(instr->operand.size() == 3);
@@ -280,11 +473,49 @@ void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
                 scope.insertOpenmpCritical(instr);
             }
         }
+        // Scatter-adds may add to the same element from different threads, thus small outputs get a private
+        // copy per thread, which OpenMP sums at the end, and larger outputs are guarded by atomic or critical
+        std::set<const bh_base *> privatized;
+        for (const jitk::InstrPtr &instr: jitk::iterator::allInstr(block)) {
+            if (instr->opcode != BH_SCATTER_ADD or _partitioned_scatters.count(instr.get()) > 0) {
+                continue;
+            }
+            const bh_base *base = instr->operand[0].base;
+            if (symbols.isPrivatized(base)) {
+                if (privatized.insert(base).second) {
+                    ss << " reduction(+:a" << symbols.baseID(base) << "[0:n" << symbols.baseID(base) << "])";
+                }
+            } else {
+                if (bh_type_is_complex(base->dtype())) {
+                    scope.insertOpenmpCritical(instr);
+                } else {
+                    scope.insertOpenmpAtomic(instr);
+                }
+                _guarded_scatter_adds.insert(instr.get());
+            }
+        }
     }
 
     // "OpenMP SIMD" goes to the innermost loop (which might also be the outermost loop)
     if (enable_simd and block.isInnermost() and simd_compatible(block, scope)) {
         ss << " simd";
+        // Outputs written using non-temporal stores, which the compiler may then write using vector stores
+        std::set<int64_t> nontemporal;
+        for (const jitk::InstrPtr &instr: jitk::iterator::allInstr(block)) {
+            if (not instr->operand.empty() and symbols.isStreamingStore(instr->operand[0].base)) {
+                nontemporal.insert(symbols.baseID(instr->operand[0].base));
+            }
+        }
+        if (not nontemporal.empty()) {
+            ss << " nontemporal(";
+            for (auto it = nontemporal.begin(); it != nontemporal.end(); ++it) {
+                if (it != nontemporal.begin()) {
+                    ss << ", ";
+                }
+                ss << "a" << *it;
+            }
+            ss << ")";
+        }
         if (block.rank > 0) { // NB: avoid multiple reduction declarations
             for (const jitk::InstrPtr &instr: ordered_block_sweeps) {
                 openmp_reductions.push_back(instr);
@@ -300,6 +531,12 @@ void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
         ss << ")";
     }
     const string ss_str = ss.str();
+    if (block.rank == 0 and _fence_region) {
+        out << "#pragma omp parallel\n";
+        util::spaces(out, 4);
+        out << "{\n";
+        util::spaces(out, 4);
+    }
     if (not ss_str.empty()) {
         out << "#pragma omp" << ss_str << "\n";
         util::spaces(out, 4 + block.rank * 4);
@@ -313,6 +550,9 @@ void EngineOpenMP::writeKernel(const LoopB &kernel,
                                std::stringstream &ss) {
 
     assert(kernel.rank == -1);
+    _partitioned_scatters.clear();
+    _guarded_scatter_adds.clear();
+    _fence_region = false;
 
     // Write the need includes
     ss << "#include <stdint.h>\n";
@@ -324,6 +564,15 @@ void EngineOpenMP::writeKernel(const LoopB &kernel,
     if (symbols.useRandom()) { // Write the random function
         ss << "#include <kernel_dependencies/random123_openmp.h>\n";
     }
+    if (comp.config.defaultGet<bool>("compiler_vector_math", false) and use_vector_math(kernel)) {
+        ss << "#include <kernel_dependencies/vector_math_openmp.h>\n";
+    }
+    if (symbols.useStreamingStores()) {
+        ss << "#include <kernel_dependencies/streaming_store_openmp.h>\n";
+    }
+    if (use_scatter_partition(kernel, scatterPartitionThreshold())) {
+        ss << "#include <kernel_dependencies/scatter_openmp.h>\n";
+    }
     writeUnionType(ss); // We always need to declare the union of all constant data types
     ss << "\n";
 
@@ -380,6 +629,9 @@ void EngineOpenMP::writeKernel(const LoopB &kernel,
                 stmp << "offset_strides[" << count++ << "], ";
             }
         }
+        for (size_t i = 0; i < symbols.privatizedScatterAdds().size(); ++i) {
+            stmp << "offset_strides[" << count++ << "], ";
+        }
 
         if (not symbols.constIDs().empty()) {
             uint64_t i = 0;
@@ -399,6 +651,83 @@ void EngineOpenMP::writeKernel(const LoopB &kernel,
     }
 }
 
+namespace {
+// The roofline probes: a STREAM triad and a loop of independent multiply-adds held in registers
+// NB: the probes must be separate sources since `getFunction()` identifies a function by the hash of its source
+const char *roofline_triad_source = R"(
+#include <stdint.h>
+
+void roofline_triad(void *data_list[], uint64_t offset_strides[], void *constants) {
+    double *a = data_list[0];
+    const double *b = data_list[1];
+    const double *c = data_list[2];
+    const int64_t n = offset_strides[0];
+    #pragma omp parallel for
+    for (int64_t i = 0; i < n; ++i) {
+        a[i] = b[i] + 3.0 * c[i];
+    }
+}
+)";
+
+const char *roofline_madd_source = R"(
+#include <stdint.h>
+
+void roofline_madd(void *data_list[], uint64_t offset_strides[], void *constants) {
+    double *out = data_list[0];
+    const int64_t n = offset_strides[0];
+    #pragma omp parallel
+    {
+        double x[32];
+        for (int j = 0; j < 32; ++j) {
+            x[j] = j * 1e-3;
+        }
+        for (int64_t i = 0; i < n; ++i) {
+            #pragma omp simd
+            for (int j = 0; j < 32; ++j) {
+                x[j] = x[j] * 0.999999 + 1e-6;
+            }
+        }
+        double sum = 0;
+        for (int j = 0; j < 32; ++j) {
+            sum += x[j];
+        }
+        #pragma omp critical
+        {
+            out[0] += sum;
+            out[1] += 1; // Number of threads
+        }
+    }
+}
+)";
+}
+
+void EngineOpenMP::probeRoofline() {
+    const KernelFunction triad = getFunction(roofline_triad_source, "roofline_triad");
+    const KernelFunction madd = getFunction(roofline_madd_source, "roofline_madd");
+    const int repeats = 5;
+
+    // The arrays must be much larger than the last-level cache
+    uint64_t n = 1 << 23;
+    vector<double> a(n, 0), b(n, 1), c(n, 2);
+    void *triad_data[] = {&a[0], &b[0], &c[0]};
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = chrono::steady_clock::now();
+        triad(triad_data, &n, nullptr);
+        const chrono::duration<double> t = chrono::steady_clock::now() - start;
+        _peak_bandwidth = std::max(_peak_bandwidth, 3 * sizeof(double) * n / t.count());
+    }
+
+    uint64_t niters = 1 << 22;
+    for (int i = 0; i < repeats; ++i) {
+        double out[2] = {0, 0};
+        void *madd_data[] = {out};
+        const auto start = chrono::steady_clock::now();
+        madd(madd_data, &niters, nullptr);
+        const chrono::duration<double> t = chrono::steady_clock::now() - start;
+        _peak_ops = std::max(_peak_ops, 2 * 32 * niters * out[1] / t.count());
+    }
+}
+
 std::string EngineOpenMP::info() const {
     stringstream ss;
     ss << std::boolalpha; // Printing true/false instead of 1/0
@@ -414,10 +743,20 @@ std::string EngineOpenMP::info() const {
     ss << "  Codegen flags:\n";
     ss << "    OpenMP: " << comp.config.defaultGet<bool>("compiler_openmp", false) << "\n";
     ss << "    OpenMP+SIMD: " << comp.config.defaultGet<bool>("compiler_openmp_simd", false) << "\n";
+    ss << "    Vector math: " << comp.config.defaultGet<bool>("compiler_vector_math", false) << "\n";
+    ss << "    Fast math: " << comp.config.defaultGet<bool>("compiler_fast_math", false) << "\n";
+    ss << "    Streaming-store threshold: " << comp.config.defaultGet<int64_t>("streaming_store_threshold", -1) << "\n";
+    ss << "    Gather prefetch distance: " << comp.config.defaultGet<int64_t>("gather_prefetch_distance", 0) << "\n";
+    ss << "    Scatter partition threshold: " << comp.config.defaultGet<int64_t>("scatter_partition_threshold", -1)
+       << "\n";
+    ss << "    Arena min size: " << comp.config.defaultGet<int64_t>("arena_min_nbytes", -1) << " bytes\n";
+    ss << "    Scatter-add privatize threshold: "
+       << comp.config.defaultGet<int64_t>("scatter_add_privatize_threshold", 16384) << "\n";
     ss << "    Index-as-var: " << comp.config.defaultGet<bool>("index_as_var", true) << "\n";
     ss << "    Strides-as-var: " << comp.config.defaultGet<bool>("strides_as_var", true) << "\n";
     ss << "    Const-as-var: " << comp.config.defaultGet<bool>("const_as_var", true) << "\n";
 
+    ss << "  Hardware counters:\n" << _counters.info();
     ss << "  JIT Command: \"" << compiler.cmd_template << "\"\n";
     return ss.str();
 }
@@ -23,6 +23,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <iostream>
 #include <string>
 #include <map>
+#include <set>
 #include <boost/filesystem.hpp>
 
 #include <bh_config_parser.hpp>
@@ -35,6 +36,8 @@ If not, see <http://www.gnu.org/licenses/>.
 
 #include <jitk/engines/engine_cpu.hpp>
 
+#include "perf_counters.hpp"
+
 namespace bohrium {
 
 typedef void (*KernelFunction)(void* data_list[], uint64_t offset_strides[], bh_constant_value constants[]);
@@ -47,6 +50,24 @@ private:
     // The compiler to use when function doesn't exist
     const jitk::Compiler compiler;
 
+    // Scatters that write through the sort-and-partition pre-pass of the current kernel mapped to the number
+    // that names their buffers (see `loopHeadWriter()`)
+    std::map<const bh_instruction*, size_t> _partitioned_scatters;
+
+    // Scatter-adds of the current kernel guarded by OpenMP atomic or critical, which must not be prefetched
+    std::set<const bh_instruction*> _guarded_scatter_adds;
+
+    // Whether the current outermost loop is a work-sharing loop in its own parallel region, which ends with the
+    // fence of its non-temporal stores (see `writeHeader()` and `loopTailWriter()`)
+    bool _fence_region = false;
+
+    // Hardware performance counters read around each kernel launch (config option `prof_counters`)
+    PerfCounters _counters;
+
+    // The machine peaks measured by `probeRoofline()` (zero until measured)
+    double _peak_bandwidth = 0;
+    double _peak_ops = 0;
+
     // Return a kernel function based on the given 'source' and the name of the kernel function
     KernelFunction getFunction(const std::string &source, const std::string &func_name);
 
@@ -78,6 +99,15 @@ public:
                         const std::vector<uint64_t> &thread_stack,
                         std::stringstream &out) override;
 
+    void loopTailWriter(const jitk::SymbolTable &symbols,
+                        jitk::Scope &scope,
+                        const jitk::LoopB &block,
+                        std::stringstream &out) override;
+
+    // Writes the source of an instruction including software prefetching of gather and scatter indexes
+    void writeInstr(jitk::Scope &scope, const bh_instruction &instr, int indent, bool opencl,
+                    std::stringstream &out) override;
+
     // Return a YAML string describing this component
     std::string info() const override;
 
@@ -85,11 +115,39 @@ public:
     const std::string writeType(bh_type dtype) override;
 
     // Update statistics with final aggregated values of the engine
-    void updateFinalStatistics() override {
+    void updateStatisticCounters() override {
         bh_get_malloc_cache_stat(stat.malloc_cache_lookups, stat.malloc_cache_misses, stat.max_memory_usage);
     }
 
+    void updateFinalStatistics() override {
+        updateStatisticCounters();
+        if (stat.enabled and stat.verbose and comp.config.defaultGet<bool>("prof_roofline", false)) {
+            if (_peak_bandwidth == 0) {
+                probeRoofline();
+            }
+            stat.peak_bandwidth = _peak_bandwidth;
+            stat.peak_ops = _peak_ops;
+        }
+    }
+
 private:
+    // Measure the peak memory bandwidth and the peak operations per second of the machine using a STREAM-like
+    // probe, which is compiled using the same compiler and flags as the kernels
+    void probeRoofline();
+
+    // Writes a software prefetch of the array element that the gather or scatter `instr` accesses
+    // `distance` iterations ahead of the current iteration
+    void writePrefetch(const jitk::Scope &scope, const bh_instruction &instr, int64_t distance,
+                       std::stringstream &out);
+
+    // Return the loop size threshold of the scatter sort-and-partition pre-pass (-1 means disabled)
+    int64_t scatterPartitionThreshold() const {
+        if (not comp.config.defaultGet<bool>("compiler_openmp", false)) {
+            return -1;
+        }
+        return comp.config.defaultGet<int64_t>("scatter_partition_threshold", -1);
+    }
+
     // Writes the union of C99 types that can make up a constant
     inline void writeUnionType(std::stringstream& out) {
         out << "\ntypedef struct { uint64_t x, y; } r123_t" << ";\n";
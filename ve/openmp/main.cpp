@@ -77,6 +77,8 @@ class Impl : public ComponentVE {
             engine.updateFinalStatistics();
             stat.write("OpenMP", "", ss);
             return ss.str();
+        } else if (msg == "chrome_trace") {
+            ss << stat.writeChromeTrace("OpenMP", config);
         } else if (msg == "info") {
             ss << engine.info();
         }
@@ -131,6 +133,13 @@ Impl::~Impl() {
         engine.updateFinalStatistics();
         stat.write("OpenMP", config.defaultGet<std::string>("prof_filename", ""), cout);
     }
+    if (stat.tracer->enabled()) {
+        try { // A destructor must not throw
+            stat.writeChromeTrace("OpenMP", config);
+        } catch (const std::exception &e) {
+            cerr << "[OpenMP] " << e.what() << endl;
+        }
+    }
 }
 
 void Impl::execute(BhIR *bhir) {
@@ -71,9 +71,9 @@ bool simd_compatible(const bohrium::jitk::LoopB &block,
             return false;
     }
 
-    // An OpenMP SIMD loop does not support ANY OpenMP pragmas
+    // An OpenMP SIMD loop does not support ANY OpenMP pragmas and SIMD lanes might scatter-add to the same element
     for (const bohrium::jitk::InstrPtr &instr: bohrium::jitk::iterator::allInstr(block)) {
-        if (scope.isOpenmpAtomic(instr) or scope.isOpenmpCritical(instr))
+        if (scope.isOpenmpAtomic(instr) or scope.isOpenmpCritical(instr) or instr->opcode == BH_SCATTER_ADD)
             return false;
     }
     return true;
@@ -92,3 +92,85 @@ bool openmp_atomic_compatible(bh_opcode opcode) {
             return false;
     }
 }
+
+// Does 'instr' call a transcendental function that has a SIMD variant in the vector math library (libmvec)?
+bool vector_math_compatible(const bh_instruction &instr) {
+    if (instr.operand.empty()) {
+        return false;
+    }
+    const bh_type t0 = instr.operand_type(0);
+    if (t0 != bh_type::FLOAT32 and t0 != bh_type::FLOAT64) {
+        return false;
+    }
+    switch (instr.opcode) {
+        case BH_EXP:
+        case BH_EXP2:
+        case BH_EXPM1:
+        case BH_LOG:
+        case BH_LOG2:
+        case BH_LOG10:
+        case BH_LOG1P:
+        case BH_POWER:
+        case BH_SIN:
+        case BH_COS:
+        case BH_TAN:
+        case BH_SINH:
+        case BH_COSH:
+        case BH_TANH:
+        case BH_ARCSIN:
+        case BH_ARCCOS:
+        case BH_ARCTAN:
+        case BH_ARCSINH:
+        case BH_ARCCOSH:
+        case BH_ARCTANH:
+        case BH_ARCTAN2:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Does any instruction in 'block' benefit from the vector math library?
+bool use_vector_math(const bohrium::jitk::LoopB &block) {
+    for (const bohrium::jitk::InstrPtr &instr: bohrium::jitk::iterator::allInstr(block)) {
+        if (vector_math_compatible(*instr)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Does any instruction in 'block' write its output using non-temporal stores?
+bool use_streaming_stores(const bohrium::jitk::LoopB &block, const bohrium::jitk::SymbolTable &symbols) {
+    for (const bohrium::jitk::InstrPtr &instr: bohrium::jitk::iterator::allInstr(block)) {
+        if (not instr->operand.empty() and symbols.isStreamingStore(instr->operand[0].base)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Return the scatters in the outermost loop 'block' that should write through the sort-and-partition pre-pass,
+// which are 1-D scatters and scatter-adds in loops of at least 'threshold' iterations (use -1 to disable the pre-pass)
+std::vector<bohrium::jitk::InstrPtr> partitioned_scatters(const bohrium::jitk::LoopB &block, int64_t threshold) {
+    std::vector<bohrium::jitk::InstrPtr> ret;
+    if (block.rank != 0 or threshold < 0 or block.size < threshold) {
+        return ret;
+    }
+    for (const bohrium::jitk::InstrPtr &instr: bohrium::jitk::iterator::allLocalInstr(block)) {
+        if ((instr->opcode == BH_SCATTER or instr->opcode == BH_SCATTER_ADD) and instr->operand[1].ndim == 1) {
+            ret.push_back(instr);
+        }
+    }
+    return ret;
+}
+
+// Does any outermost loop in 'kernel' use the sort-and-partition pre-pass of scatters?
+bool use_scatter_partition(const bohrium::jitk::LoopB &kernel, int64_t threshold) {
+    for (const bohrium::jitk::Block &b: kernel._block_list) {
+        if (not b.isInstr() and not partitioned_scatters(b.getLoop(), threshold).empty()) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,233 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <boost/filesystem.hpp>
+
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "perf_counters.hpp"
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+namespace bohrium {
+
+namespace {
+const char *counter_names[] = {"cycles", "instructions", "LLC misses", "bytes read", "bytes written"};
+
+#ifdef __linux__
+// Open a counting event, which returns -1 and sets `errno` on failure
+int perf_event_open(uint32_t type, uint64_t config, bool inherit, int pid, int cpu) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.inherit = inherit ? 1 : 0;
+    attr.exclude_kernel = pid == 0 ? 1 : 0; // Uncore events cannot exclude the kernel
+    attr.exclude_hv = pid == 0 ? 1 : 0;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, pid, cpu, -1, 0));
+}
+#endif
+
+// Read the first line of `path` or return the empty string
+string read_line(const fs::path &path) {
+    ifstream file(path.string());
+    string ret;
+    getline(file, ret);
+    return ret;
+}
+
+// Translate the sysfs event `event` of the PMU at `pmu` (e.g. "event=0x04,umask=0x03") into the `config` of
+// `perf_event_attr` using the bit ranges in the "format" directory of the PMU (e.g. "config:0-7")
+bool parse_sysfs_event(const fs::path &pmu, const string &event, uint64_t &config) {
+    config = 0;
+    stringstream terms(event);
+    string term;
+    while (getline(terms, term, ',')) {
+        const size_t eq = term.find('=');
+        const string name = term.substr(0, eq);
+        uint64_t value = eq == string::npos ? 1 : stoull(term.substr(eq + 1), nullptr, 0);
+        const string format = read_line(pmu / "format" / name);
+        if (format.compare(0, 7, "config:") != 0) {
+            return false; // Only the `config` field is supported
+        }
+        stringstream ranges(format.substr(7));
+        string range;
+        while (getline(ranges, range, ',')) {
+            const size_t dash = range.find('-');
+            const int lo = stoi(range.substr(0, dash));
+            const int hi = dash == string::npos ? lo : stoi(range.substr(dash + 1));
+            for (int bit = lo; bit <= hi; ++bit, value >>= 1) {
+                config |= (value & 1) << bit;
+            }
+        }
+    }
+    return true;
+}
+}
+
+PerfCounters::PerfCounters(bool enabled) {
+    if (not enabled) {
+        return;
+    }
+#ifdef __linux__
+    const uint64_t configs[] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = CYCLES; i <= LLC_MISSES; ++i) {
+        const int fd = perf_event_open(PERF_TYPE_HARDWARE, configs[i], true, 0, -1);
+        if (fd < 0) {
+            _errors[i] = strerror(errno);
+        } else {
+            _events[i].push_back(Event{fd, 1, 0, 0, 0});
+        }
+    }
+    openUncore();
+#else
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        _errors[i] = "requires Linux";
+    }
+#endif
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        _available = _available or not _events[i].empty();
+    }
+}
+
+void PerfCounters::openUncore() {
+#ifdef __linux__
+    const fs::path devices("/sys/bus/event_source/devices");
+    const Counter counters[] = {BYTES_READ, BYTES_WRITTEN};
+    const char *event_names[] = {"cas_count_read", "cas_count_write"};
+    try {
+        if (fs::exists(devices)) {
+            for (fs::directory_iterator it(devices), end; it != end; ++it) {
+                const fs::path pmu = it->path();
+                if (pmu.filename().string().compare(0, 10, "uncore_imc") != 0) {
+                    continue;
+                }
+                const uint32_t type = static_cast<uint32_t>(stoul(read_line(pmu / "type")));
+                const int cpu = stoi(read_line(pmu / "cpumask")); // We use the first CPU of the mask
+                for (int i = 0; i < 2; ++i) {
+                    uint64_t config;
+                    const fs::path event = pmu / "events" / event_names[i];
+                    if (not fs::exists(event) or not parse_sysfs_event(pmu, read_line(event), config)) {
+                        continue;
+                    }
+                    const string scale = read_line(event.string() + ".scale");
+                    const string unit = read_line(event.string() + ".unit");
+                    double s = scale.empty() ? 1 : stod(scale);
+                    if (unit == "MiB") {
+                        s *= 1024 * 1024;
+                    }
+                    const int fd = perf_event_open(type, config, false, -1, cpu);
+                    if (fd < 0) {
+                        _errors[counters[i]] = strerror(errno);
+                    } else {
+                        _events[counters[i]].push_back(Event{fd, s, 0, 0, 0});
+                    }
+                }
+            }
+        }
+    } catch (const exception &e) { // E.g. an unexpected sysfs format
+        _errors[BYTES_READ] = _errors[BYTES_WRITTEN] = e.what();
+    }
+    for (int i = 0; i < 2; ++i) {
+        if (_errors[counters[i]].empty() and _events[counters[i]].empty()) {
+            _errors[counters[i]] = "no memory controller PMU (uncore_imc)";
+        }
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+    for (const auto &events: _events) {
+        for (const Event &event: events) {
+            close(event.fd);
+        }
+    }
+}
+
+bool PerfCounters::read(const Event &event, uint64_t &value, uint64_t &enabled, uint64_t &running) {
+    uint64_t buf[3];
+    if (::read(event.fd, buf, sizeof(buf)) != sizeof(buf)) {
+        return false;
+    }
+    value = buf[0];
+    enabled = buf[1];
+    running = buf[2];
+    return true;
+}
+
+void PerfCounters::start() {
+    for (auto &events: _events) {
+        for (Event &event: events) {
+            read(event, event.value, event.enabled, event.running);
+        }
+    }
+}
+
+jitk::CounterValues PerfCounters::stop() {
+    int64_t values[NUM_COUNTERS];
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        values[i] = _events[i].empty() ? -1 : 0;
+        for (const Event &event: _events[i]) {
+            uint64_t value, enabled, running;
+            if (not read(event, value, enabled, running) or running == event.running) {
+                // The read failed or the event was never scheduled, which happens if the PMU is overcommitted
+                values[i] = -1;
+                break;
+            }
+            // Scale the count when the kernel multiplexed the PMU between events
+            const double multiplexing = static_cast<double>(enabled - event.enabled) / (running - event.running);
+            values[i] += static_cast<int64_t>((value - event.value) * multiplexing * event.scale);
+        }
+    }
+    jitk::CounterValues ret;
+    ret.cycles = values[CYCLES];
+    ret.instructions = values[INSTRUCTIONS];
+    ret.llc_misses = values[LLC_MISSES];
+    ret.bytes_read = values[BYTES_READ];
+    ret.bytes_written = values[BYTES_WRITTEN];
+    return ret;
+}
+
+string PerfCounters::info() const {
+    stringstream ss;
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        ss << "    " << counter_names[i] << ": ";
+        if (_events[i].empty()) {
+            ss << "unavailable (" << (_errors[i].empty() ? "disabled" : _errors[i]) << ")\n";
+        } else {
+            ss << "available\n";
+        }
+    }
+    return ss.str();
+}
+
+} // bohrium
@@ -0,0 +1,84 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <jitk/statistics.hpp>
+
+namespace bohrium {
+
+/** Hardware performance counters of the calling process (incl. the threads it spawns later) read through
+ * `perf_event_open(2)`: cycles, instructions, and last-level cache misses from the core PMU and, when the
+ * integrated memory controllers (uncore_imc) are accessible, the bytes read and written to DRAM.
+ * Counters that cannot be opened (no PMU, `perf_event_paranoid`, seccomp, etc.) are reported as unavailable.
+ *
+ * NB: the counters must be opened before the OpenMP thread pool is created since only new threads inherit them.
+ */
+class PerfCounters {
+public:
+    // Open the counters when `enabled` is true
+    explicit PerfCounters(bool enabled);
+
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    // Return true when at least one counter is available
+    bool available() const {
+        return _available;
+    }
+
+    // Start measuring
+    void start();
+
+    // Return the counts since the last call to `start()`
+    jitk::CounterValues stop();
+
+    // Return a description of the available counters
+    std::string info() const;
+
+private:
+    enum Counter {CYCLES = 0, INSTRUCTIONS, LLC_MISSES, BYTES_READ, BYTES_WRITTEN, NUM_COUNTERS};
+
+    struct Event {
+        int fd;
+        double scale;     // Multiplier that converts a count into the unit of the counter
+        uint64_t value;   // The raw values at `start()`
+        uint64_t enabled;
+        uint64_t running;
+    };
+
+    // Each counter might consist of several events, e.g. one for each memory controller
+    std::vector<Event> _events[NUM_COUNTERS];
+    bool _available = false;
+    std::string _errors[NUM_COUNTERS]; // Why a counter is unavailable
+
+    // Read the current value of `event` into `value`, `enabled`, and `running`
+    static bool read(const Event &event, uint64_t &value, uint64_t &enabled, uint64_t &running);
+
+    // Open the uncore memory controller counters
+    void openUncore();
+};
+
+} // bohrium
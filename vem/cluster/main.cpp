@@ -0,0 +1,733 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <bh_component.hpp>
+#include <bh_main_memory.hpp>
+#include <bh_util.hpp>
+
+#include "partition.hpp"
+
+using namespace bohrium;
+using namespace component;
+using namespace cluster;
+using namespace std;
+
+namespace {
+
+// A range of rows of a partitioned input that a worker fetches from another worker (the halo)
+struct Halo {
+    size_t src;        // The worker that owns the rows
+    bh_base *piece;    // The rows, which the master relays from `src` to the destination worker
+    int64_t offset;    // The first row of the piece within the destination's gathered rows
+    int64_t nrows;
+};
+
+/** The cluster VEM partitions large base arrays along their leading axis across a number of workers, which are
+ * proxy backends (`bh_proxy_backend`) each running the rest of the stack. Instructions that map rows to rows
+ * (elementwise operations, and sweeps that does not sweep the leading axis) run on the workers in parallel,
+ * reductions of the leading axis reduce locally on the workers and combine on the master, and everything else runs
+ * on the master (our child), which gathers the partitioned arrays it needs.
+ * The workers are reached through the proxy VEM, thus the data goes over its comm layer, including the halo rows of
+ * shifted views, which the master relays from one worker to another.
+ */
+class Impl : public ComponentImpl {
+private:
+    // The workers, their addresses, and the worker processes that we started
+    vector<unique_ptr<ComponentFace> > workers;
+    vector<string> addresses;
+    vector<pid_t> worker_pids;
+
+    // Base arrays smaller than this are not partitioned
+    int64_t min_nelem;
+
+    // The partitioned base arrays
+    map<bh_base *, Partition> partitions;
+
+    // The copies of broadcasted base arrays that the workers hold (one per worker), which are sent to the workers
+    // once and stay valid until the master's data changes
+    map<bh_base *, vector<unique_ptr<bh_base> > > replicas;
+
+    // The instructions and syncs of the master and the workers that have not been executed yet
+    vector<bh_instruction> master_instrs;
+    set<bh_base *> master_syncs;
+    vector<vector<bh_instruction> > worker_instrs;
+    vector<set<bh_base *> > worker_syncs;
+
+    // Temporary base arrays, which must live until the pending instructions have been executed
+    vector<unique_ptr<bh_base> > temps;
+
+    bool stat_print_on_exit;
+    uint64_t num_distributed{0};
+    uint64_t num_reduced{0};
+    uint64_t num_on_master{0};
+    uint64_t nbytes_scattered{0};
+    uint64_t nbytes_gathered{0};
+    uint64_t nbytes_halo{0};
+
+    // Start a local worker that listens on `address`
+    pid_t spawnWorker(const string &backend, const string &address, unsigned int nthreads);
+
+    // Execute the pending instructions of the master or the workers
+    void flushMaster();
+    void flushWorkers();
+    void flush() {
+        flushMaster();
+        flushWorkers();
+        temps.clear();
+    }
+
+    // A new temporary base array
+    bh_base *temp(int64_t nelem, bh_type type) {
+        temps.emplace_back(new bh_base(nelem, type));
+        return temps.back().get();
+    }
+
+    // Returns the partition of `base`, which is created with `row` elements per row if it doesn't exist
+    Partition &partition(bh_base *base, int64_t row) {
+        auto it = partitions.find(base);
+        if (it == partitions.end()) {
+            it = partitions.insert(make_pair(base, Partition(*base, row, workers.size()))).first;
+        }
+        return it->second;
+    }
+
+    // Make the data of `base` up-to-date on the workers (scatter). When not `copy`, the data is overwritten anyway.
+    void toWorkers(bh_base *base, Partition &p, bool copy = true);
+
+    // Make the data of `base` up-to-date on the master (gather)
+    void toMaster(bh_base *base);
+
+    // The workers' data becomes outdated
+    void invalidateWorkers(Partition &p);
+
+    // The master's data becomes outdated, which the child frees (through its malloc cache)
+    void invalidateMaster(bh_base *base, Partition &p) {
+        master_instrs.emplace_back(BH_FREE, vector<bh_view>{bh_view(base)});
+        flushMaster();
+        p.on_master = false;
+    }
+
+    // Returns the copies of the broadcasted `base` that the workers hold, which they get if they don't have them
+    const vector<unique_ptr<bh_base> > &replicate(bh_base *base);
+
+    // The workers' copies of `base` become outdated (call this when the data of `base` changes)
+    void dropReplicas(bh_base *base) {
+        auto it = replicas.find(base);
+        if (it != replicas.end()) {
+            for (size_t k = 0; k < workers.size(); ++k) {
+                worker_instrs[k].emplace_back(BH_FREE, vector<bh_view>{bh_view(it->second[k].get())});
+                temps.push_back(std::move(it->second[k]));
+            }
+            replicas.erase(it);
+        }
+    }
+
+    // The master takes over `base`, which isn't partitioned anymore
+    void unpartition(bh_base *base) {
+        auto it = partitions.find(base);
+        if (it != partitions.end()) {
+            toMaster(base);
+            invalidateWorkers(it->second);
+            partitions.erase(it);
+        }
+    }
+
+    // Returns the number of elements per row of each operand of `instr` (zero for constants and -1 for broadcasted
+    // operands) when the workers can run `instr` row by row, or an empty vector when they cannot
+    vector<int64_t> rowPlan(const bh_instruction &instr) const;
+
+    // Returns true when the workers can run the reduction `instr` locally, which the master combines
+    bool reducePlan(const bh_instruction &instr) const;
+
+    // Run the instruction on the workers, the master, or both
+    void runRows(const bh_instruction &instr, const vector<int64_t> &rows);
+    void runReduce(const bh_instruction &instr);
+    void runMaster(const bh_instruction &instr);
+
+public:
+    Impl(int stack_level);
+    ~Impl() override;
+    void execute(BhIR *bhir) override;
+    string message(const string &msg) override;
+    void *getMemoryPointer(bh_base &base, bool copy2host, bool force_alloc, bool nullify) override;
+    void setMemoryPointer(bh_base *base, bool host_ptr, void *mem) override;
+    void memCopy(bh_view &src, bh_view &dst, const std::string &param) override;
+};
+} //Unnamed namespace
+
+extern "C" ComponentImpl *create(int stack_level) {
+    return new Impl(stack_level);
+}
+extern "C" void destroy(ComponentImpl *self) {
+    delete self;
+}
+
+Impl::Impl(int stack_level) : ComponentImpl(stack_level),
+                              min_nelem(config.defaultGet<int64_t>("min_nelem", 65536)),
+                              stat_print_on_exit(config.defaultGet("prof", false)) {
+    // The workers are either the running backends in `hosts` or local backends that we start
+    string hosts = config.defaultGet<string>("hosts", "");
+    boost::trim(hosts);
+    if (hosts.empty()) {
+        const auto nworkers = config.defaultGet<unsigned int>("workers", 2);
+        if (nworkers == 0) {
+            throw runtime_error("[CLUSTER-VEM] the number of workers must be positive");
+        }
+        const string backend = config.defaultGet<string>("backend", "bh_proxy_backend");
+        const unsigned int nthreads = max(1u, thread::hardware_concurrency() / nworkers);
+        const auto dir = boost::filesystem::temp_directory_path();
+        for (unsigned int k = 0; k < nworkers; ++k) {
+            stringstream ss;
+            ss << "unix:" << (dir / "bh_cluster_").string() << getpid() << "_" << k;
+            addresses.push_back(ss.str());
+            worker_pids.push_back(spawnWorker(backend, addresses.back(), nthreads));
+        }
+    } else {
+        boost::split(addresses, hosts, boost::is_any_of(","));
+        for (string &address: addresses) {
+            boost::trim(address);
+        }
+    }
+
+    // The proxy VEM reads its options from the section of its stack level, which is ours. Thus, we give it the address
+    // of each worker through the environment.
+    const string proxy_impl = config.get<string>("proxy_impl");
+    const string env_address = "BH_" + boost::to_upper_copy(config.getName()) + "_ADDRESS";
+    const string env_port = "BH_" + boost::to_upper_copy(config.getName()) + "_PORT";
+    for (const string &address: addresses) {
+        string host = address;
+        string port = config.defaultGet<string>("port", "4200");
+        const size_t colon = address.rfind(':');
+        if (address.compare(0, 5, "unix:") != 0 and colon != string::npos) {
+            host = address.substr(0, colon);
+            port = address.substr(colon + 1);
+        }
+        setenv(env_address.c_str(), host.c_str(), 1);
+        setenv(env_port.c_str(), port.c_str(), 1);
+        workers.emplace_back(new ComponentFace(proxy_impl, stack_level));
+    }
+    unsetenv(env_address.c_str());
+    unsetenv(env_port.c_str());
+    worker_instrs.resize(workers.size());
+    worker_syncs.resize(workers.size());
+}
+
+Impl::~Impl() {
+    try {
+        flush();
+        partitions.clear();
+        replicas.clear();
+        workers.clear(); // Shuts down the workers
+    } catch (const std::exception &e) {
+        cerr << "[CLUSTER-VEM] " << e.what() << endl;
+    }
+    for (pid_t pid: worker_pids) {
+        int status;
+        waitpid(pid, &status, 0);
+    }
+    if (stat_print_on_exit) {
+        cout << "Cluster:\n";
+        cout << "  Workers:      " << addresses.size() << "\n";
+        cout << "  Distributed:  " << num_distributed << " instructions\n";
+        cout << "  Reduced:      " << num_reduced << " instructions\n";
+        cout << "  On master:    " << num_on_master << " instructions\n";
+        cout << "  Scattered:    " << nbytes_scattered / 1024.0 / 1024.0 << "MB\n";
+        cout << "  Gathered:     " << nbytes_gathered / 1024.0 / 1024.0 << "MB\n";
+        cout << "  Halo:         " << nbytes_halo / 1024.0 / 1024.0 << "MB" << endl;
+    }
+}
+
+pid_t Impl::spawnWorker(const string &backend, const string &address, unsigned int nthreads) {
+    const pid_t pid = fork();
+    if (pid < 0) {
+        throw runtime_error("[CLUSTER-VEM] fork() failed");
+    }
+    if (pid == 0) {
+        // The workers share the cores of this machine
+        setenv("OMP_NUM_THREADS", to_string(nthreads).c_str(), 0);
+        execl(backend.c_str(), backend.c_str(), "-a", address.c_str(), "-p", "0", "-n", "1",
+              static_cast<char *>(nullptr));
+        cerr << "[CLUSTER-VEM] cannot execute " << backend << ": " << strerror(errno) << endl;
+        _exit(1);
+    }
+    // Wait for the worker to listen
+    const string path = address.substr(string("unix:").size());
+    for (int i = 0; not boost::filesystem::exists(path); ++i) {
+        int status;
+        if (i == 1000 or waitpid(pid, &status, WNOHANG) == pid) {
+            throw runtime_error("[CLUSTER-VEM] the worker at " + address + " did not start");
+        }
+        usleep(10 * 1000);
+    }
+    return pid;
+}
+
+void Impl::flushMaster() {
+    if (master_instrs.empty() and master_syncs.empty()) {
+        return;
+    }
+    BhIR bhir(std::move(master_instrs), std::move(master_syncs));
+    master_instrs.clear();
+    master_syncs.clear();
+    child.execute(&bhir);
+}
+
+void Impl::flushWorkers() {
+    for (size_t k = 0; k < workers.size(); ++k) {
+        if (worker_instrs[k].empty() and worker_syncs[k].empty()) {
+            continue;
+        }
+        BhIR bhir(std::move(worker_instrs[k]), std::move(worker_syncs[k]));
+        worker_instrs[k].clear();
+        worker_syncs[k].clear();
+        workers[k]->execute(&bhir); // Returns as soon as the EXEC message is queued, thus the workers run in parallel
+    }
+}
+
+void Impl::toWorkers(bh_base *base, Partition &p, bool copy) {
+    if (p.on_workers) {
+        return;
+    }
+    flushMaster();
+    const char *data = nullptr;
+    if (copy and p.on_master) {
+        data = static_cast<const char *>(child.getMemoryPointer(*base, true, false, false));
+    }
+    if (data != nullptr) {
+        const int64_t row_nbytes = p.row * bh_type_size(base->dtype());
+        for (size_t k = 0; k < workers.size(); ++k) {
+            bh_base *part = p.parts[k].get();
+            if (part != nullptr) { // The proxy sends the data along with the next EXEC message
+                bh_data_malloc(part);
+                memcpy(part->getDataPtr(), data + p.bounds[k] * row_nbytes, static_cast<size_t>(part->nbytes()));
+                nbytes_scattered += part->nbytes();
+            }
+        }
+    }
+    p.on_workers = true;
+}
+
+void Impl::toMaster(bh_base *base) {
+    auto it = partitions.find(base);
+    if (it == partitions.end() or it->second.on_master) {
+        return;
+    }
+    Partition &p = it->second;
+    flushWorkers();
+    flushMaster();
+    char *dst = static_cast<char *>(child.getMemoryPointer(*base, true, true, false));
+    const int64_t row_nbytes = p.row * bh_type_size(base->dtype());
+    for (size_t k = 0; k < workers.size(); ++k) {
+        bh_base *part = p.parts[k].get();
+        if (part == nullptr) {
+            continue;
+        }
+        // The worker keeps its copy, thus we only free our copy of the data
+        const void *data = workers[k]->getMemoryPointer(*part, true, false, false);
+        if (data != nullptr) {
+            memcpy(dst + p.bounds[k] * row_nbytes, data,
+                   static_cast<size_t>(part->nbytes()));
+            nbytes_gathered += part->nbytes();
+        }
+        bh_data_free(part);
+    }
+    p.on_master = true;
+}
+
+void Impl::invalidateWorkers(Partition &p) {
+    for (size_t k = 0; k < workers.size(); ++k) {
+        unique_ptr<bh_base> old = p.renew(k);
+        if (old) {
+            worker_instrs[k].emplace_back(BH_FREE, vector<bh_view>{bh_view(old.get())});
+            temps.push_back(std::move(old));
+        }
+    }
+    p.on_workers = false;
+}
+
+const vector<unique_ptr<bh_base> > &Impl::replicate(bh_base *base) {
+    auto it = replicas.find(base);
+    if (it != replicas.end()) {
+        return it->second;
+    }
+    toMaster(base);
+    flushMaster();
+    const void *data = child.getMemoryPointer(*base, true, false, false);
+    vector<unique_ptr<bh_base> > &ret = replicas[base];
+    for (size_t k = 0; k < workers.size(); ++k) {
+        ret.emplace_back(new bh_base(base->nelem(), base->dtype()));
+        if (data != nullptr) { // The proxy sends the data along with the next EXEC message
+            bh_data_malloc(ret.back().get());
+            memcpy(ret.back()->getDataPtr(), data, static_cast<size_t>(base->nbytes()));
+            nbytes_scattered += base->nbytes();
+        }
+    }
+    return ret;
+}
+
+vector<int64_t> Impl::rowPlan(const bh_instruction &instr) const {
+    const bool sweep = bh_opcode_is_reduction(instr.opcode) or bh_opcode_is_accumulate(instr.opcode);
+    if (not ((bh_opcode_is_elementwise(instr.opcode) and instr.opcode != BH_NONE) or
+             (sweep and instr.sweep_axis() > 0)) or instr.operand.empty()) {
+        return {};
+    }
+    const bh_view &out = instr.operand[0];
+    if (out.isConstant() or out.ndim < 1) {
+        return {};
+    }
+    vector<int64_t> ret;
+    map<bh_base *, int64_t> new_rows; // The operands must agree on the rows of a new partition
+    for (size_t i = 0; i < instr.operand.size(); ++i) {
+        const bh_view &view = instr.operand[i];
+        if (view.isConstant()) {
+            ret.push_back(0);
+            continue;
+        }
+        if (view.shape[0] != out.shape[0] or view.hasSlide()) {
+            return {};
+        }
+        if (i > 0 and broadcasted(view)) {
+            ret.push_back(-1);
+            continue;
+        }
+        auto it = partitions.find(view.base);
+        int64_t row;
+        if (it != partitions.end()) {
+            row = it->second.row;
+        } else if (i == 0 and view.base->nelem() < min_nelem) { // We only partition large outputs
+            return {};
+        } else {
+            row = view_row(view);
+            if (new_rows.insert(make_pair(view.base, row)).first->second != row) {
+                return {};
+            }
+        }
+        int64_t first;
+        if (row <= 0 or not row_mapped(view, row, first)) {
+            return {};
+        }
+        ret.push_back(row);
+    }
+    return ret;
+}
+
+bool Impl::reducePlan(const bh_instruction &instr) const {
+    if (not bh_opcode_is_reduction(instr.opcode) or instr.sweep_axis() != 0 or instr.operand.size() != 3) {
+        return false;
+    }
+    const bh_view &in = instr.operand[1];
+    if (in.isConstant() or instr.operand[0].isConstant()) {
+        return false;
+    }
+    auto it = partitions.find(in.base);
+    int64_t row;
+    if (it != partitions.end()) {
+        row = it->second.row;
+    } else if (in.base->nelem() < min_nelem) {
+        return false;
+    } else {
+        row = view_row(in);
+    }
+    int64_t first;
+    return row > 0 and row_mapped(in, row, first) and in.shape[0] > 0;
+}
+
+void Impl::runRows(const bh_instruction &instr, const vector<int64_t> &rows) {
+    const size_t nworkers = workers.size();
+    const bh_view &out = instr.operand[0];
+
+    // Bring the inputs to the workers, which keep copies of the broadcasted inputs
+    for (size_t i = 1; i < instr.operand.size(); ++i) {
+        const bh_view &view = instr.operand[i];
+        if (rows[i] > 0) {
+            toWorkers(view.base, partition(view.base, rows[i]));
+        } else if (rows[i] < 0) {
+            replicate(view.base);
+        }
+    }
+
+    // The output is only copied to the workers when the instruction doesn't overwrite all of it
+    Partition &p_out = partition(out.base, rows[0]);
+    bool overwrite = out.start == 0 and out.shape.prod() == out.base->nelem();
+    for (size_t i = 1; i < instr.operand.size(); ++i) {
+        overwrite = overwrite and instr.operand[i].base != out.base;
+    }
+    toWorkers(out.base, p_out, not overwrite);
+    if (p_out.on_master) {
+        invalidateMaster(out.base, p_out);
+    }
+
+    // Worker `k` runs the leading indices [begin[k], end[k]), which are the rows of the output that it owns
+    int64_t out_first;
+    row_mapped(out, p_out.row, out_first);
+    vector<int64_t> begin(nworkers), end(nworkers);
+    for (size_t k = 0; k < nworkers; ++k) {
+        begin[k] = max(p_out.bounds[k], out_first) - out_first;
+        end[k] = min(p_out.bounds[k + 1], out_first + out.shape[0]) - out_first;
+    }
+
+    // Fetch the rows of the inputs that a worker doesn't own from the workers that own them
+    map<pair<size_t, size_t>, vector<Halo> > halos; // (worker, operand) -> the halo of the operand
+    for (size_t i = 1; i < instr.operand.size(); ++i) {
+        if (rows[i] <= 0) {
+            continue;
+        }
+        const bh_view &view = instr.operand[i];
+        const Partition &p = partitions.at(view.base);
+        int64_t first;
+        row_mapped(view, p.row, first);
+        for (size_t k = 0; k < nworkers; ++k) {
+            const int64_t lo = first + begin[k], hi = first + end[k];
+            if (lo >= hi or (p.bounds[k] <= lo and hi <= p.bounds[k + 1])) {
+                continue;
+            }
+            vector<Halo> &halo = halos[make_pair(k, i)];
+            for (size_t src = 0; src < nworkers; ++src) {
+                const int64_t src_lo = max(lo, p.bounds[src]), src_hi = min(hi, p.bounds[src + 1]);
+                if (src == k or src_lo >= src_hi) {
+                    continue;
+                }
+                bh_base *piece = temp((src_hi - src_lo) * p.row, view.base->dtype());
+                worker_instrs[src].emplace_back(BH_IDENTITY, vector<bh_view>{
+                        rows_view(piece, p.row, 0, src_hi - src_lo),
+                        rows_view(p.parts[src].get(), p.row, src_lo - p.bounds[src], src_hi - src_lo)});
+                worker_syncs[src].insert(piece);
+                halo.push_back(Halo{src, piece, src_lo - lo, src_hi - src_lo});
+            }
+        }
+    }
+    if (not halos.empty()) {
+        flushWorkers();
+        for (auto &h: halos) {
+            for (Halo &halo: h.second) {
+                halo.piece->resetDataPtr(workers[halo.src]->getMemoryPointer(*halo.piece, true, false, true));
+                nbytes_halo += halo.piece->nbytes();
+            }
+        }
+    }
+
+    // Each worker runs its part of the instruction
+    for (size_t k = 0; k < nworkers; ++k) {
+        const int64_t count = end[k] - begin[k];
+        if (count <= 0) {
+            continue;
+        }
+        vector<bh_instruction> &instrs = worker_instrs[k];
+        bh_instruction local(instr);
+        vector<bh_base *> frees;
+        local.operand[0] = localize(out, p_out.parts[k].get(), p_out.row, out_first + begin[k] - p_out.bounds[k],
+                                    count);
+        for (size_t i = 1; i < instr.operand.size(); ++i) {
+            const bh_view &view = instr.operand[i];
+            if (rows[i] < 0) {
+                local.operand[i].base = replicas.at(view.base)[k].get();
+                local.operand[i].shape[0] = count;
+                continue;
+            } else if (rows[i] == 0) {
+                continue;
+            }
+            const Partition &p = partitions.at(view.base);
+            int64_t first;
+            row_mapped(view, p.row, first);
+            auto halo = halos.find(make_pair(k, i));
+            if (halo == halos.end()) {
+                local.operand[i] = localize(view, p.parts[k].get(), p.row, first + begin[k] - p.bounds[k], count);
+                continue;
+            }
+            // Gather the rows into a temporary base array: our own rows and the halo rows from the other workers
+            const int64_t lo = first + begin[k];
+            bh_base *gathered = temp(count * p.row, view.base->dtype());
+            const int64_t own_lo = max(lo, p.bounds[k]), own_hi = min(lo + count, p.bounds[k + 1]);
+            if (own_lo < own_hi) {
+                instrs.emplace_back(BH_IDENTITY, vector<bh_view>{
+                        rows_view(gathered, p.row, own_lo - lo, own_hi - own_lo),
+                        rows_view(p.parts[k].get(), p.row, own_lo - p.bounds[k], own_hi - own_lo)});
+            }
+            for (const Halo &h: halo->second) {
+                instrs.emplace_back(BH_IDENTITY, vector<bh_view>{rows_view(gathered, p.row, h.offset, h.nrows),
+                                                                 rows_view(h.piece, p.row, 0, h.nrows)});
+                frees.push_back(h.piece);
+            }
+            local.operand[i] = localize(view, gathered, p.row, 0, count);
+            frees.push_back(gathered);
+        }
+        instrs.push_back(local);
+        for (bh_base *base: frees) {
+            instrs.emplace_back(BH_FREE, vector<bh_view>{bh_view(base)});
+        }
+    }
+    dropReplicas(out.base); // After the workers' instructions that might read the replicas
+    ++num_distributed;
+}
+
+void Impl::runReduce(const bh_instruction &instr) {
+    const size_t nworkers = workers.size();
+    const bh_view &out = instr.operand[0];
+    const bh_view &in = instr.operand[1];
+    Partition &p = partition(in.base, partitions.count(in.base) > 0 ? partitions.at(in.base).row : view_row(in));
+    toWorkers(in.base, p);
+    int64_t first;
+    row_mapped(in, p.row, first);
+
+    // Each worker reduces its rows into a partial result
+    vector<pair<size_t, bh_base *> > partials;
+    for (size_t k = 0; k < nworkers; ++k) {
+        const int64_t lo = max(first, p.bounds[k]), hi = min(first + in.shape[0], p.bounds[k + 1]);
+        if (lo >= hi) {
+            continue;
+        }
+        bh_base *partial = temp(out.shape.prod(), out.base->dtype());
+        bh_instruction local(instr);
+        local.operand[0] = contiguous_view(partial, out.shape);
+        local.operand[1] = localize(in, p.parts[k].get(), p.row, lo - p.bounds[k], hi - lo);
+        worker_instrs[k].push_back(local);
+        worker_syncs[k].insert(partial);
+        partials.push_back(make_pair(k, partial));
+    }
+    flushWorkers();
+
+    // The master combines the partial results
+    unpartition(out.base);
+    dropReplicas(out.base);
+    const bh_opcode combine = reduce_combine_opcode(instr.opcode);
+    for (size_t i = 0; i < partials.size(); ++i) {
+        bh_base *partial = partials[i].second;
+        partial->resetDataPtr(workers[partials[i].first]->getMemoryPointer(*partial, true, false, true));
+        nbytes_gathered += partial->nbytes();
+        const bh_view view = contiguous_view(partial, out.shape);
+        if (i == 0) {
+            master_instrs.emplace_back(BH_IDENTITY, vector<bh_view>{out, view});
+        } else {
+            master_instrs.emplace_back(combine, vector<bh_view>{out, out, view});
+        }
+        master_instrs.emplace_back(BH_FREE, vector<bh_view>{bh_view(partial)});
+    }
+    ++num_reduced;
+}
+
+void Impl::runMaster(const bh_instruction &instr) {
+    if (not instr.operand.empty() and not instr.operand[0].isConstant()) {
+        dropReplicas(instr.operand[0].base);
+    }
+    if (instr.opcode == BH_FREE) {
+        auto it = partitions.find(instr.operand[0].base);
+        if (it != partitions.end()) {
+            invalidateWorkers(it->second);
+            partitions.erase(it);
+        }
+    } else {
+        for (const bh_view &view: instr.getViews()) {
+            toMaster(view.base);
+        }
+        if (not instr.operand.empty() and not instr.operand[0].isConstant()) {
+            unpartition(instr.operand[0].base);
+        }
+        ++num_on_master;
+    }
+    master_instrs.push_back(instr);
+}
+
+void Impl::execute(BhIR *bhir) {
+    // The master runs repeated BhIRs as a whole
+    if (bhir->getNRepeats() != 1 or bhir->getRepeatCondition() != nullptr) {
+        for (const bh_instruction &instr: bhir->instr_list) {
+            for (const bh_view &view: instr.getViews()) {
+                unpartition(view.base);
+                dropReplicas(view.base);
+            }
+        }
+        flush();
+        child.execute(bhir);
+        return;
+    }
+
+    for (const bh_instruction &instr: bhir->instr_list) {
+        if (instr.opcode == BH_NONE) {
+            continue;
+        }
+        const vector<int64_t> rows = rowPlan(instr);
+        if (not rows.empty()) {
+            runRows(instr, rows);
+        } else if (reducePlan(instr)) {
+            runReduce(instr);
+        } else {
+            runMaster(instr);
+        }
+    }
+
+    // The synced arrays are gathered by the master
+    for (bh_base *base: bhir->getSyncs()) {
+        toMaster(base);
+        master_syncs.insert(base);
+    }
+    flush();
+}
+
+string Impl::message(const string &msg) {
+    flush();
+    stringstream ss;
+    if (msg == "info") {
+        ss << "----" << "\n";
+        ss << "Cluster:" << "\n";
+        ss << "  Workers: " << boost::algorithm::join(addresses, ", ") << "\n";
+        ss << "  Partitioned arrays: " << partitions.size() << "\n";
+    }
+    ss << child.message(msg);
+    return ss.str();
+}
+
+void *Impl::getMemoryPointer(bh_base &base, bool copy2host, bool force_alloc, bool nullify) {
+    flush();
+    // The host might write to the data, thus the master takes over the base array
+    unpartition(&base);
+    dropReplicas(&base);
+    flush();
+    return child.getMemoryPointer(base, copy2host, force_alloc, nullify);
+}
+
+void Impl::setMemoryPointer(bh_base *base, bool host_ptr, void *mem) {
+    flush();
+    auto it = partitions.find(base);
+    if (it != partitions.end()) {
+        invalidateWorkers(it->second);
+        partitions.erase(it);
+    }
+    dropReplicas(base);
+    flush();
+    child.setMemoryPointer(base, host_ptr, mem);
+}
+
+void Impl::memCopy(bh_view &src, bh_view &dst, const std::string &param) {
+    flush();
+    toMaster(src.base);
+    unpartition(dst.base);
+    dropReplicas(dst.base);
+    flush();
+    child.memCopy(src, dst, param);
+}
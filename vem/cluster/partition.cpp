@@ -0,0 +1,143 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cassert>
+#include <stdexcept>
+
+#include "partition.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace cluster {
+
+Partition::Partition(const bh_base &base, int64_t row, size_t nworkers) : row(row) {
+    assert(row > 0 and base.nelem() % row == 0);
+    const int64_t total = base.nelem() / row;
+    for (size_t k = 0; k <= nworkers; ++k) {
+        bounds.push_back(total * static_cast<int64_t>(k) / static_cast<int64_t>(nworkers));
+    }
+    for (size_t k = 0; k < nworkers; ++k) {
+        parts.emplace_back(nrows(k) > 0 ? new bh_base(nrows(k) * row, base.dtype()) : nullptr);
+    }
+}
+
+unique_ptr<bh_base> Partition::renew(size_t k) {
+    unique_ptr<bh_base> ret = std::move(parts[k]);
+    if (ret) {
+        parts[k].reset(new bh_base(ret->nelem(), ret->dtype()));
+    }
+    return ret;
+}
+
+int64_t view_row(const bh_view &view) {
+    if (view.isConstant() or view.ndim < 1 or view.hasSlide()) {
+        return 0;
+    }
+    int64_t ret = 1;
+    for (int64_t dim = 1; dim < view.ndim; ++dim) {
+        ret *= view.shape[dim];
+    }
+    if (ret == 0 or view.base->nelem() % ret != 0) {
+        return 0;
+    }
+    return ret;
+}
+
+bool row_mapped(const bh_view &view, int64_t row, int64_t &first) {
+    if (view.isConstant() or view.ndim < 1 or view.hasSlide() or view.start % row != 0) {
+        return false;
+    }
+    if (view.shape[0] > 1 and view.stride[0] != row) {
+        return false;
+    }
+    int64_t weight = 1;
+    for (int64_t dim = view.ndim - 1; dim > 0; --dim) {
+        if (view.shape[dim] > 1 and view.stride[dim] != weight) {
+            return false;
+        }
+        weight *= view.shape[dim];
+    }
+    if (weight != row) {
+        return false;
+    }
+    first = view.start / row;
+    return first + view.shape[0] <= view.base->nelem() / row;
+}
+
+bh_view rows_view(bh_base *base, int64_t row, int64_t first, int64_t count) {
+    bh_view ret(base);
+    ret.start = first * row;
+    ret.shape[0] = count * row;
+    return ret;
+}
+
+bh_view contiguous_view(bh_base *base, const BhIntVec &shape) {
+    bh_view ret;
+    ret.base = base;
+    ret.start = 0;
+    ret.ndim = static_cast<int64_t>(shape.size());
+    ret.shape = shape;
+    ret.stride.resize(shape.size());
+    int64_t weight = 1;
+    for (int64_t dim = ret.ndim - 1; dim >= 0; --dim) {
+        ret.stride[dim] = weight;
+        weight *= shape[dim];
+    }
+    return ret;
+}
+
+bh_view localize(const bh_view &view, bh_base *base, int64_t row, int64_t first, int64_t count) {
+    bh_view ret(view);
+    ret.base = base;
+    ret.start = first * row;
+    ret.shape[0] = count;
+    return ret;
+}
+
+bh_opcode reduce_combine_opcode(bh_opcode opcode) {
+    switch (opcode) {
+        case BH_ADD_REDUCE:
+            return BH_ADD;
+        case BH_MULTIPLY_REDUCE:
+            return BH_MULTIPLY;
+        case BH_MINIMUM_REDUCE:
+            return BH_MINIMUM;
+        case BH_MAXIMUM_REDUCE:
+            return BH_MAXIMUM;
+        case BH_LOGICAL_AND_REDUCE:
+            return BH_LOGICAL_AND;
+        case BH_BITWISE_AND_REDUCE:
+            return BH_BITWISE_AND;
+        case BH_LOGICAL_OR_REDUCE:
+            return BH_LOGICAL_OR;
+        case BH_BITWISE_OR_REDUCE:
+            return BH_BITWISE_OR;
+        case BH_LOGICAL_XOR_REDUCE:
+            return BH_LOGICAL_XOR;
+        case BH_BITWISE_XOR_REDUCE:
+            return BH_BITWISE_XOR;
+        default:
+            throw runtime_error("[CLUSTER-VEM] not a reduction: " + string(bh_opcode_text(opcode)));
+    }
+}
+
+}
+} // namespace bohrium::cluster
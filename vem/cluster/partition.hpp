@@ -0,0 +1,97 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <bh_view.hpp>
+#include <bh_opcode.h>
+
+namespace bohrium {
+namespace cluster {
+
+/** A base array that is block-partitioned along its leading axis across the workers.
+ * The rows of the base array, which are `row` elements each, are split evenly between the workers and each worker
+ * holds its rows in a local base array of its own.
+ */
+struct Partition {
+    // Number of elements per row
+    int64_t row;
+    // Worker `k` owns the rows [bounds[k], bounds[k+1])
+    std::vector<int64_t> bounds;
+    // The local base arrays of the workers (nullptr when a worker has no rows)
+    std::vector<std::unique_ptr<bh_base> > parts;
+    // Whether the data of the workers and the data of the master (i.e. the global base array) are up-to-date
+    bool on_workers = false;
+    bool on_master = true;
+
+    /** Partition `base` into rows of `row` elements across `nworkers` workers
+     *
+     * @param base      The global base array, which must consist of whole rows
+     * @param row       Number of elements per row
+     * @param nworkers  Number of workers
+     */
+    Partition(const bh_base &base, int64_t row, size_t nworkers);
+
+    // Number of rows of worker `k`
+    int64_t nrows(size_t k) const {
+        return bounds[k + 1] - bounds[k];
+    }
+
+    // Replace the local base array of worker `k` with a new one without data and return the old one
+    std::unique_ptr<bh_base> renew(size_t k);
+};
+
+/** Returns the number of elements per row of `view` i.e. the product of its shape except the leading axis,
+ * or zero when `view` cannot partition `base` along its leading axis
+ */
+int64_t view_row(const bh_view &view);
+
+/** Returns true when the leading axis of `view` maps to consecutive rows of `row` elements and the remaining axes
+ * span whole rows, in which case `first` is set to the row of the first leading index.
+ */
+bool row_mapped(const bh_view &view, int64_t row, int64_t &first);
+
+// Returns true when the leading axis of `view` is broadcasted (zero stride)
+inline bool broadcasted(const bh_view &view) {
+    return view.ndim > 0 and view.stride[0] == 0 and not view.hasSlide();
+}
+
+// Returns a flat view of `count` rows starting at row `first` of `base`
+bh_view rows_view(bh_base *base, int64_t row, int64_t first, int64_t count);
+
+// Returns a row-major contiguous view of `base` with the shape `shape`
+bh_view contiguous_view(bh_base *base, const BhIntVec &shape);
+
+/** Returns a copy of the row mapped `view` that points to `count` rows of `base` starting at row `first`
+ *
+ * @param view   The row mapped view
+ * @param base   The local base array, which holds the rows
+ * @param row    Number of elements per row
+ * @param first  The local row of the first leading index
+ * @param count  The size of the leading axis
+ */
+bh_view localize(const bh_view &view, bh_base *base, int64_t row, int64_t first, int64_t count);
+
+// Returns the elementwise opcode that combines the partial results of the reduction `opcode`
+bh_opcode reduce_combine_opcode(bh_opcode opcode);
+
+}
+} // namespace bohrium::cluster
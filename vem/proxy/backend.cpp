@@ -18,30 +18,283 @@ GNU Lesser General Public License along with Bohrium.
 If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <limits>
+#include <condition_variable>
 #include <bh_component.hpp>
 #include <bh_util.hpp>
 #include <bh_main_memory.hpp>
 
 #include "comm.hpp"
 #include "compression.hpp"
+#include "pipeline.hpp"
+#include "delta.hpp"
 
 using namespace std;
 using namespace bohrium;
 using namespace component;
 
-static void service(const std::string &address, int port) {
-    CommBackend comm_backend(address, port);
-    unique_ptr<ConfigParser> config;
+namespace {
+// A received EXEC message ready for the child
+struct ExecJob {
+    unique_ptr<BhIR> bhir;
+    vector<shared_ptr<bh_base> > bases; // Keeps the base arrays of `bhir` alive
+    vector<shared_ptr<bh_base> > freed; // The base arrays to free after the execution
+    vector<pair<const bh_base *, shared_ptr<bh_base> > > push; // The synced arrays to push (remote and local)
+
+    // Frees the data of `freed`, which also happens when the job is skipped because an earlier job failed
+    ~ExecJob() {
+        for (const shared_ptr<bh_base> &base: freed) {
+            bh_data_free(base.get());
+        }
+    }
+};
+
+// The copies of the synced arrays that a session pushes after an EXEC message
+struct PushJob {
+    vector<pair<const bh_base *, bh_base> > arrays; // The remote base arrays and the copies of their data
+    std::atomic<uint64_t> &buffered; // The number of bytes of the session's copies
+
+    explicit PushJob(std::atomic<uint64_t> &buffered) : buffered(buffered) {}
+
+    // Frees the copies, which also happens when the job is skipped because an earlier send failed
+    ~PushJob() {
+        for (auto &a: arrays) {
+            buffered -= static_cast<uint64_t>(a.second.nbytes());
+            bh_data_free(&a.second);
+        }
+    }
+};
+
+// The child, which all sessions share thus a new session starts with the compiled kernels and caches of the child.
+// The child runs in the pipeline's worker thread while the sessions receive and uncompress their next messages.
+// NB: all calls to the child goes through the pipeline since a child might use thread-local device contexts
+struct Engine {
+    std::mutex mutex;
+    unique_ptr<ConfigParser> config; // The configuration of the session that created the child
     unique_ptr<ComponentFace> child;
+    unique_ptr<Pipeline> pipeline;
+
+    // Create the child at the first INIT message
+    void init(int stack_level) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (config.get() != nullptr) {
+            if (config->stack_level != stack_level) {
+                throw runtime_error("[VEM-PROXY] the sessions of a backend must use the same stack level");
+            }
+            return;
+        }
+        config.reset(new ConfigParser(stack_level));
+        // The sessions call the child concurrently, thus we always need the worker thread
+        pipeline.reset(new Pipeline(std::max<uint64_t>(config->defaultGet<uint64_t>("pipeline_depth", 4), 1)));
+        pipeline->push([this]() {
+            child.reset(new ComponentFace(config->getChildLibraryPath(), config->stack_level + 1));
+        });
+        pipeline->wait();
+    }
+
+    ~Engine() {
+        if (pipeline) {
+            pipeline->push([this]() { child.reset(); });
+            pipeline->wait();
+        }
+    }
+};
+
+// The jobs of a session in the pipeline of the engine. An exception thrown by a job is re-thrown by the next call
+// to `push()` or `wait()` of the session it belongs to, and `wait()` only waits for the jobs of the session.
+// After a failed job, the remaining queued jobs of the session are skipped.
+// NB: the jobs should only call the child since the jobs of all sessions run in the same worker thread, thus the
+//     sessions do their own communication.
+class SessionJobs {
+private:
+    Pipeline &_pipeline;
+    uint64_t _pending = 0;
+    std::exception_ptr _error;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+
+    // NB: the caller must hold the lock of `_mutex`
+    void rethrow() {
+        if (_error) {
+            std::exception_ptr e = _error;
+            _error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+public:
+    explicit SessionJobs(Pipeline &pipeline) : _pipeline(pipeline) {}
+
+    ~SessionJobs() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cond.wait(lock, [this]() { return _pending == 0; });
+    }
+
+    void push(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            rethrow();
+            ++_pending;
+        }
+        _pipeline.push([this, job]() {
+            bool failed;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                failed = static_cast<bool>(_error);
+            }
+            std::exception_ptr error;
+            if (not failed) {
+                try {
+                    job();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (error and not _error) {
+                _error = error;
+            }
+            --_pending;
+            _cond.notify_all();
+        });
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cond.wait(lock, [this]() { return _pending == 0; });
+        rethrow();
+    }
+};
+}
+
+// Serve a frontend until it sends SHUTDOWN or disconnects
+static void session(Engine &engine, CommBackend &comm_backend) {
+    unique_ptr<ConfigParser> config;
+    unique_ptr<SessionJobs> jobs;
     Compression compression;
     string compress_param;
     std::map<const bh_base *, bh_base> remote2local;
 
+    // The memory of the base arrays in this session, which must stay below `memory_limit` bytes (if not zero)
+    uint64_t memory_used = 0;
+    uint64_t memory_limit = 0;
+
+    // The de-serialized BhIRs point to the nodes of `remote2local`, which we replace with these local base arrays.
+    // Thus, we can remove a freed base array from `remote2local` (the frontend might reuse its address for a new
+    // base array) while the child is still executing an earlier BhIR that uses it.
+    std::map<const bh_base *, shared_ptr<bh_base> > node2local;
+
+    // Return the local base array of the remote base array `remote` or NULL
+    auto find_local = [&](const bh_base *remote) -> bh_base * {
+        auto it = remote2local.find(remote);
+        return it == remote2local.end() ? nullptr : node2local.at(&it->second).get();
+    };
+
+    // Remove the remote base array `remote` from `remote2local`
+    auto forget = [&](const bh_base *remote) {
+        auto it = remote2local.find(remote);
+        if (it != remote2local.end()) {
+            auto local = node2local.find(&it->second);
+            if (local != node2local.end()) {
+                memory_used -= static_cast<uint64_t>(local->second->nbytes());
+                node2local.erase(local);
+            }
+            remote2local.erase(it);
+        }
+    };
+
+    // Delta transfer: the data of base arrays that the frontend's host got (GET_DATA with nullify) is retained here
+    // until the base array becomes known again, which makes the frontend send a patch against the retained data.
+    bool delta_transfer = false;
+    double delta_max_dirty = 0.5;
+    std::map<const bh_base *, shared_ptr<bh_base> > retained;
+
+    // Drop the data of the local base array of `remote` since the frontend's host got it
+    auto drop_data = [&](const bh_base *remote, bh_base *local_base) {
+        if (delta_transfer and local_base->getDataPtr() != nullptr) { // Let's retain the data the host got
+            shared_ptr<bh_base> &r = retained[remote];
+            if (r) {
+                memory_used -= static_cast<uint64_t>(r->nbytes());
+                bh_data_free(r.get());
+            }
+            r = make_shared<bh_base>(*local_base);
+            memory_used += static_cast<uint64_t>(r->nbytes());
+        } else {
+            bh_data_free(local_base);
+        }
+        local_base->resetDataPtr();
+    };
+
+    // Push the synced arrays after each EXEC message, thus the frontend doesn't have to get them one at a time.
+    // The shared worker copies the arrays, which our own sender thread compresses and sends. Thus, the worker never
+    // blocks on our socket when the frontend doesn't read the pushes, e.g. while it sends more EXEC messages.
+    // The copies use at most `push_buffer_limit` bytes, the frontend gets the arrays that don't fit using GET_DATA.
+    bool push_syncs = false;
+    uint64_t push_buffer_limit = 0;
+    std::atomic<uint64_t> push_buffered{0};
+    Compression push_compression;
+    unique_ptr<Pipeline> sender;
+
+    // Wait for the jobs of the session and the pushes, which must precede any reply
+    auto drain = [&]() {
+        jobs->wait();
+        sender->wait();
+    };
+
     // Some statistics
     std::chrono::duration<double> time_mem_copy_total{0};
     std::chrono::duration<double> time_mem_copy_zip{0};
     uint64_t nbytes_send{0};
 
+    // Free the base arrays that the frontend didn't free (e.g. when it disconnects) since the child outlives us
+    auto release = [&]() {
+        for (auto &r: retained) {
+            bh_data_free(r.second.get());
+        }
+        retained.clear();
+        if (jobs.get() == nullptr) {
+            return;
+        }
+        try {
+            drain();
+        } catch (...) {} // The session ends anyway
+        if (node2local.empty()) {
+            return;
+        }
+        auto job = make_shared<ExecJob>();
+        vector<bh_instruction> instr_list;
+        for (auto &n: node2local) {
+            instr_list.emplace_back(BH_FREE, vector<bh_view>{bh_view(n.second.get())});
+            job->freed.push_back(n.second);
+        }
+        job->bhir.reset(new BhIR(std::move(instr_list), set<bh_base *>()));
+        node2local.clear();
+        remote2local.clear();
+        memory_used = 0;
+        jobs->push([&engine, job]() { engine.child->execute(job->bhir.get()); });
+        jobs->wait();
+    };
+    // Make sure we call `release()` when leaving the session even through an exception
+    struct Release {
+        std::function<void()> func;
+        CommBackend &comm_backend;
+        ~Release() {
+            // When the session fails, the frontend might not read the pending pushes
+            if (std::uncaught_exception()) {
+                comm_backend.shutdown();
+            }
+            try {
+                func();
+            } catch (const std::exception &e) {
+                cerr << "[VEM-PROXY] failed to release the base arrays of a session: " << e.what() << endl;
+            }
+        }
+    } release_guard{release, comm_backend};
+
     while (true) {
         // Let's read the head of the message
         vector<char> buf_head(msg::HeaderSize);
@@ -53,15 +306,27 @@ static void service(const std::string &address, int port) {
                 std::vector<char> buffer(head.body_size);
                 comm_backend.read(buffer);
                 msg::Init body(buffer);
-                if (child.get() != nullptr) {
+                if (config.get() != nullptr) {
                     throw runtime_error("[VEM-PROXY] Received INIT messages multiple times!");
                 }
+                engine.init(body.stack_level);
+                push_syncs = body.push_syncs;
                 config.reset(new ConfigParser(body.stack_level));
-                child.reset(new ComponentFace(config->getChildLibraryPath(), config->stack_level + 1));
+                memory_limit = config->defaultGet<uint64_t>("session_memory_limit", 0) * 1024 * 1024;
                 compress_param = config->defaultGet<string>("compress_param", "zlib");
+                delta_transfer = config->defaultGet("delta_transfer", false) and not comm_backend.single_copy();
+                delta_max_dirty = config->defaultGet<double>("delta_max_dirty", 0.5);
+                compression = Compression(config->defaultGet<uint64_t>("compress_chunk_size", 1024 * 1024),
+                                          config->defaultGet<unsigned int>("compress_threads", 0),
+                                          config->defaultGet<double>("link_bandwidth", 1.25e9));
+                push_compression = compression;
+                push_buffer_limit = config->defaultGet<uint64_t>("push_buffer_limit", 256) * 1024 * 1024;
+                sender.reset(new Pipeline(std::numeric_limits<size_t>::max()));
+                jobs.reset(new SessionJobs(*engine.pipeline));
                 break;
             }
             case msg::Type::SHUTDOWN: {
+                drain();
                 if (config->defaultGet("prof", false)) {
                     cout << "Backend:\n";
                     cout << "  MemCopy: " << time_mem_copy_total.count() << "s" << endl;
@@ -75,26 +340,133 @@ static void service(const std::string &address, int port) {
                 comm_backend.read(buffer);
                 vector<bh_base *> data_recv;
                 set<bh_base *> freed;
-                BhIR bhir(buffer, remote2local, data_recv, freed);
+                auto job = make_shared<ExecJob>();
+                job->bhir.reset(new BhIR(buffer, remote2local, data_recv, freed));
+
+                // Replace the nodes of `remote2local` with the local base arrays
+                auto local = [&](bh_base *node) -> bh_base * {
+                    auto it = node2local.find(node);
+                    if (it == node2local.end()) {
+                        it = node2local.insert(make_pair(node, make_shared<bh_base>(*node))).first;
+                        memory_used += static_cast<uint64_t>(node->nbytes());
+                    }
+                    job->bases.push_back(it->second);
+                    return it->second.get();
+                };
+                for (bh_instruction &instr: job->bhir->instr_list) {
+                    for (bh_view &v: instr.getViews()) {
+                        v.base = local(v.base);
+                    }
+                }
+                set<bh_base *> syncs;
+                for (bh_base *base: job->bhir->_syncs) {
+                    syncs.insert(local(base));
+                }
+                if (push_syncs and not job->bhir->_syncs.empty()) {
+                    for (const auto &r: remote2local) {
+                        if (job->bhir->_syncs.count(const_cast<bh_base *>(&r.second)) > 0) {
+                            job->push.push_back(make_pair(r.first, node2local.at(&r.second)));
+                        }
+                    }
+                }
+                job->bhir->_syncs = std::move(syncs);
+                if (job->bhir->_repeat_condition != nullptr) {
+                    job->bhir->_repeat_condition = local(job->bhir->_repeat_condition);
+                }
+                if (memory_limit > 0 and memory_used > memory_limit) {
+                    throw runtime_error("[VEM-PROXY] the session exceeds its memory limit (session_memory_limit)");
+                }
+
+                // The retained data of base arrays that become known again (the frontend drops its shadows likewise)
+                std::map<const bh_base *, shared_ptr<bh_base> > retained_nodes;
+                for (auto it = retained.begin(); it != retained.end();) {
+                    auto node = remote2local.find(it->first);
+                    if (node != remote2local.end()) {
+                        memory_used -= static_cast<uint64_t>(it->second->nbytes());
+                        retained_nodes[&node->second] = it->second;
+                        it = retained.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
 
                 // Receive new base array data
-                for (bh_base *base: data_recv) {
+                for (bh_base *node: data_recv) {
+                    bh_base *base = local(node);
                     base->resetDataPtr();
-                    auto data = comm_backend.recv_data();
-                    if (not data.empty()) {
-                        bh_data_malloc(base);
-                        compression.uncompress(data, *base, compress_param);
+                    auto shadow = retained_nodes.find(node);
+                    if (shadow != retained_nodes.end() and comm_backend.recv_data().at(0) != 0) {
+                        // Patch the retained data, which becomes the data of `base`
+                        const auto patch = compression.uncompress(comm_backend.recv_data(), compress_param);
+                        if (shadow->second->nbytes() != base->nbytes()) {
+                            throw runtime_error("[VEM-PROXY] the size of the retained data doesn't match");
+                        }
+                        base->resetDataPtr(shadow->second->getDataPtr());
+                        shadow->second->resetDataPtr();
+                        delta_apply_patch(patch, base->getDataPtr(), static_cast<uint64_t>(base->nbytes()));
+                    } else if (comm_backend.single_copy()) {
+                        comm_backend.recv_memfd(*base);
+                    } else {
+                        // Uncompress the data while receiving it
+                        const uint64_t nbytes = comm_backend.recv_data_size();
+                        if (nbytes > 0) {
+                            auto read = [&](void *dest, uint64_t n) { comm_backend.recv_data_bytes(dest, n); };
+                            compression.uncompress(nbytes, read, *base, compress_param);
+                        }
                     }
                 }
 
-                // Send the bhir down to the child
-                child->execute(&bhir);
+                for (auto &r: retained_nodes) {
+                    bh_data_free(r.second.get());
+                }
 
-                // Let's remove the freed base arrays
-                for (const bh_base *base: freed) {
-                    bh_data_free(&remote2local[base]);
-                    remote2local.erase(base);
+                // Let's remove the freed base arrays, which the job frees after the execution
+                for (const bh_base *remote: freed) {
+                    auto it = remote2local.find(remote);
+                    if (it != remote2local.end()) {
+                        job->freed.push_back(node2local.at(&it->second));
+                        forget(remote);
+                    }
                 }
+
+                // Send the bhir down to the child and push the synced arrays as soon as the execution finishes
+                jobs->push([&, job]() {
+                    engine.child->execute(job->bhir.get());
+                    if (job->push.empty()) {
+                        return;
+                    }
+                    // Copy the arrays that fit in the push buffer, the frontend gets the others using GET_DATA
+                    auto push = make_shared<PushJob>(push_buffered);
+                    for (const auto &p: job->push) {
+                        bh_base &base = *p.second;
+                        engine.child->getMemoryPointer(base, true, false, false);
+                        const uint64_t nbytes = static_cast<uint64_t>(base.nbytes());
+                        if (base.getDataPtr() == nullptr or push_buffered + nbytes > push_buffer_limit) {
+                            continue;
+                        }
+                        bh_base copy(base);
+                        copy.resetDataPtr();
+                        bh_data_malloc(&copy);
+                        memcpy(copy.getDataPtr(), base.getDataPtr(), static_cast<size_t>(nbytes));
+                        push_buffered += nbytes;
+                        push->arrays.push_back(make_pair(p.first, copy));
+                    }
+                    sender->push([&, push]() {
+                        vector<unsigned char> ids(push->arrays.size() * sizeof(uint64_t));
+                        for (size_t i = 0; i < push->arrays.size(); ++i) {
+                            const auto id = reinterpret_cast<uint64_t>(push->arrays[i].first);
+                            memcpy(&ids[i * sizeof(uint64_t)], &id, sizeof(uint64_t));
+                        }
+                        comm_backend.send_data(ids);
+                        for (const auto &a: push->arrays) {
+                            if (comm_backend.single_copy()) {
+                                comm_backend.send_memfd(a.second);
+                            } else {
+                                comm_backend.send_data(push_compression.compress(a.second, compress_param));
+                            }
+                        }
+                    });
+                });
                 break;
             }
             case msg::Type::GET_DATA: {
@@ -102,24 +474,49 @@ static void service(const std::string &address, int port) {
                 comm_backend.read(buffer);
                 msg::GetData body(buffer);
 
-                if (util::exist(remote2local, body.base)) {
-                    bh_base &local_base = remote2local.at(body.base);
-                    child->getMemoryPointer(local_base, true, false, false); // Note, we delay nullify to after comm.
-                    if (local_base.getDataPtr() != nullptr) {
-                        auto data = compression.compress(local_base, compress_param);
+                // Only the child runs in the shared worker thread, we compress and send the data ourselves.
+                // Note, we delay nullify to after comm.
+                bh_base *local_base = find_local(body.base);
+                if (local_base != nullptr) {
+                    jobs->push([&]() { engine.child->getMemoryPointer(*local_base, true, false, false); });
+                }
+                drain();
+                if (local_base != nullptr) {
+                    const bool has_data = local_base->getDataPtr() != nullptr;
+                    if (comm_backend.single_copy()) {
+                        comm_backend.send_memfd(*local_base);
+                    } else if (has_data and not body.page_hashes.empty()) {
+                        // The frontend holds a copy, thus we send a patch of the differing pages when few differ
+                        vector<unsigned char> patch;
+                        const bool use_patch = delta_make_patch(local_base->getDataPtr(),
+                                                                static_cast<uint64_t>(local_base->nbytes()),
+                                                                body.page_hashes, delta_max_dirty, patch);
+                        comm_backend.send_data({static_cast<unsigned char>(use_patch)});
+                        if (use_patch) {
+                            comm_backend.send_data(compression.compress(patch, compress_param));
+                        } else {
+                            comm_backend.send_data(compression.compress(*local_base, compress_param));
+                        }
+                    } else if (has_data) {
+                        auto data = compression.compress(*local_base, compress_param);
                         comm_backend.send_data(data);
                     } else {
+                        if (not body.page_hashes.empty()) {
+                            comm_backend.send_data({0});
+                        }
                         comm_backend.send_data({});
                     }
                     if (body.nullify) {
-                        bh_data_free(&local_base);
-                        local_base.resetDataPtr();
+                        drop_data(body.base, local_base);
                     }
                 } else {
+                    if (not body.page_hashes.empty()) {
+                        comm_backend.send_data({0});
+                    }
                     comm_backend.send_data({});
                 }
                 if (body.nullify) {
-                    remote2local.erase(body.base);
+                    forget(body.base);
                 }
                 break;
             }
@@ -128,25 +525,40 @@ static void service(const std::string &address, int port) {
                 std::vector<char> buffer(head.body_size);
                 comm_backend.read(buffer);
                 msg::MemCopy body(buffer);
-                if (util::exist(remote2local, body.src.base)) {
+                bh_base *local_base = find_local(body.src.base);
+                if (local_base != nullptr) {
+                    jobs->push([&]() { engine.child->getMemoryPointer(*local_base, true, false, false); });
+                }
+                drain();
+                if (local_base != nullptr and local_base->getDataPtr() != nullptr) {
                     bh_view src = body.src;
-                    src.base = &remote2local.at(body.src.base);
-                    child->getMemoryPointer(*src.base, true, false, false);
-                    if (src.base->getDataPtr() != nullptr) {
-                        auto t2 = chrono::steady_clock::now();
-                        auto data = compression.compress(src, body.param);
-                        time_mem_copy_zip += chrono::steady_clock::now() - t2;
-                        nbytes_send += data.size();
-                        comm_backend.send_data(data);
-                    } else {
-                        comm_backend.send_data({});
-                    }
+                    src.base = local_base;
+                    auto t2 = chrono::steady_clock::now();
+                    auto data = compression.compress(src, body.param);
+                    time_mem_copy_zip += chrono::steady_clock::now() - t2;
+                    nbytes_send += data.size();
+                    comm_backend.send_data(data);
                 } else {
                     comm_backend.send_data({});
                 }
                 time_mem_copy_total += chrono::steady_clock::now() - t1;
                 break;
             }
+            case msg::Type::DISCARD: {
+                std::vector<char> buffer(head.body_size);
+                comm_backend.read(buffer);
+                msg::Discard body(buffer);
+                // NB: there is no reply, but the frontend sends DISCARD after receiving the pushes, thus we rarely wait
+                jobs->wait();
+                for (bh_base *remote: body.bases) {
+                    bh_base *local_base = find_local(remote);
+                    if (local_base != nullptr) {
+                        drop_data(remote, local_base);
+                    }
+                    forget(remote);
+                }
+                break;
+            }
             case msg::Type::MSG: {
                 std::vector<char> buffer(head.body_size);
                 comm_backend.read(buffer);
@@ -157,7 +569,8 @@ static void service(const std::string &address, int port) {
                     ss << "    Hostname: " << comm_backend.hostname() << "\n";
                     ss << "    IP: "       << comm_backend.ip() << "\n";
                 }
-                ss << child->message(body.msg);
+                jobs->push([&]() { ss << engine.child->message(body.msg); });
+                drain();
                 comm_backend.write(ss.str());
                 break;
             }
@@ -168,22 +581,68 @@ static void service(const std::string &address, int port) {
     }
 }
 
+// Serve `max_sessions` frontends (0 means forever), which run concurrently in their own thread
+static void service(const std::string &address, int port, uint64_t max_sessions) {
+    CommListener listener(address, port);
+    Engine engine;
+
+    // The session threads and the IDs of the threads that have finished, which we join when accepting a new session
+    std::map<uint64_t, std::thread> sessions;
+    std::vector<uint64_t> finished;
+    std::mutex finished_mutex;
+    auto join_finished = [&]() {
+        std::vector<uint64_t> ids;
+        {
+            std::lock_guard<std::mutex> lock(finished_mutex);
+            ids.swap(finished);
+        }
+        for (uint64_t id: ids) {
+            sessions.at(id).join();
+            sessions.erase(id);
+        }
+    };
+
+    for (uint64_t id = 0; max_sessions == 0 or id < max_sessions; ++id) {
+        shared_ptr<CommBackend> comm_backend = make_shared<CommBackend>(listener);
+        join_finished();
+        sessions[id] = std::thread([&engine, &finished, &finished_mutex, comm_backend, id]() {
+            try {
+                session(engine, *comm_backend);
+            } catch (const std::exception &e) {
+                cerr << "[VEM-PROXY] session " << id << " ended: " << e.what() << endl;
+            }
+            std::lock_guard<std::mutex> lock(finished_mutex);
+            finished.push_back(id);
+        });
+    }
+    for (auto &s: sessions) {
+        s.second.join();
+    }
+}
+
 int main(int argc, char *argv[]) {
     char *address = nullptr;
     int port = 0;
+    uint64_t max_sessions = 1;
 
-    if (argc == 5 && \
+    if ((argc == 5 || argc == 7) && \
         (strncmp(argv[1], "-a\0", 3) == 0) && \
-        (strncmp(argv[3], "-p\0", 3) == 0)) {
+        (strncmp(argv[3], "-p\0", 3) == 0) && \
+        (argc == 5 || strncmp(argv[5], "-n\0", 3) == 0)) {
         address = argv[2];
         port = atoi(argv[4]);
+        if (argc == 7) {
+            max_sessions = strtoull(argv[6], nullptr, 10);
+        }
     } else {
-        printf("Usage: %s -a ipaddress -p port\n", argv[0]);
+        printf("Usage: %s -a ipaddress|unix:path -p port [-n sessions]\n", argv[0]);
+        printf("  -n  the number of frontend sessions to serve concurrently before exiting, 0 means forever "
+               "(default is 1)\n");
         return 0;
     }
     if (!address) {
         fprintf(stderr, "Please supply address.\n");
         return 0;
     }
-    service(address, port);
+    service(address, port, max_sessions);
 }
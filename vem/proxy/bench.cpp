@@ -0,0 +1,348 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <boost/algorithm/string.hpp>
+#include <bh_component.hpp>
+#include <bh_main_memory.hpp>
+
+#include "compression.hpp"
+#include "lz4.hpp"
+#include "zstd.hpp"
+
+using namespace std;
+using namespace bohrium;
+using namespace component;
+
+// Benchmark of the proxy VEM, which runs synthetic BhIRs through a frontend and a backend on this machine. Each
+// iteration sends arrays to the backend, which adds one to them, and gets the results back. The link between the two
+// can be emulated (see `LinkEmulator`), which makes it possible to tune the options of a remote deployment locally.
+
+namespace {
+
+struct Options {
+    vector<string> codecs;
+    uint64_t nbytes = 8 * 1024 * 1024; // Size of each array
+    uint64_t narrays = 1;               // Arrays per iteration
+    uint64_t iterations = 20;
+    string pattern = "ramp";
+    double bandwidth = 0;
+    double latency = 0;
+    double jitter = 0;
+    string pipeline_depth; // Empty means the configured depth
+    string address = "localhost";
+    int port = 4300;
+    string backend; // Path to `bh_proxy_backend`
+};
+
+struct Result {
+    double ratio;             // Compression ratio of the payload
+    double seconds;           // Total time of the iterations
+    uint64_t nbytes_moved;    // Array data sent and received
+    vector<double> latencies; // Seconds per iteration
+};
+
+void usage(const char *prog) {
+    cout << "Usage: " << prog << " [options]\n"
+         << "  --codecs list        comma separated list of `compress_param` values (default: all available)\n"
+         << "  --size bytes         size of each array, accepts K, M, and G suffixes (default: 8M)\n"
+         << "  --arrays n           number of arrays per iteration (default: 1)\n"
+         << "  --iterations n       number of iterations (default: 20)\n"
+         << "  --pattern name       array data: zeros, ramp, sparse, or random (default: ramp)\n"
+         << "  --bandwidth bytes/s  emulated link bandwidth, accepts K, M, and G suffixes (default: unlimited)\n"
+         << "  --latency seconds    emulated one-way latency (default: 0)\n"
+         << "  --jitter seconds     emulated maximum jitter of a round trip (default: 0)\n"
+         << "  --pipeline-depth n   number of EXEC messages in flight (default: as configured)\n"
+         << "  --address address    address of the backend, e.g. unix:/tmp/bh.sock (default: localhost)\n"
+         << "  --port port          port of the backend (default: 4300)\n"
+         << "  --backend path       the backend executable (default: bh_proxy_backend next to this executable)\n"
+         << "The stack (BH_STACK) must contain the proxy VEM." << endl;
+}
+
+// Parse a number with an optional K, M, or G suffix
+double parse_size(const string &str) {
+    size_t pos = 0;
+    double ret = stod(str, &pos);
+    const string suffix = boost::to_upper_copy(str.substr(pos));
+    if (suffix == "K") {
+        ret *= 1024;
+    } else if (suffix == "M") {
+        ret *= 1024 * 1024;
+    } else if (suffix == "G") {
+        ret *= 1024 * 1024 * 1024;
+    } else if (not suffix.empty()) {
+        throw invalid_argument("unknown size suffix: " + str);
+    }
+    return ret;
+}
+
+// Fill the data of `base` (FLOAT64) with the data of `pattern`
+void fill(bh_base &base, const string &pattern, uint64_t seed) {
+    double *data = static_cast<double *>(base.getDataPtr());
+    const auto nelem = static_cast<uint64_t>(base.nelem());
+    mt19937_64 random(seed);
+    if (pattern == "zeros") {
+        memset(data, 0, static_cast<size_t>(base.nbytes()));
+    } else if (pattern == "ramp") {
+        for (uint64_t i = 0; i < nelem; ++i) {
+            data[i] = static_cast<double>(i % 4096) + seed;
+        }
+    } else if (pattern == "sparse") {
+        uniform_int_distribution<int> percent(0, 99);
+        for (uint64_t i = 0; i < nelem; ++i) {
+            data[i] = percent(random) == 0 ? static_cast<double>(random()) : 0;
+        }
+    } else if (pattern == "random") {
+        for (uint64_t i = 0; i < nelem; ++i) {
+            const uint64_t bits = random();
+            memcpy(&data[i], &bits, sizeof(double));
+        }
+    } else {
+        throw invalid_argument("unknown pattern: " + pattern);
+    }
+}
+
+// Returns the `p` percentile of `values` (which gets sorted)
+double percentile(vector<double> &values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    sort(values.begin(), values.end());
+    const auto i = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+    return values[min(i, values.size() - 1)];
+}
+
+// The compression ratio of the data of `pattern` when compressed with `codec`
+double compression_ratio(const Options &opt, const string &codec) {
+    bh_base base(static_cast<int64_t>(opt.nbytes / sizeof(double)), bh_type::FLOAT64);
+    bh_data_malloc(&base);
+    fill(base, opt.pattern, 0);
+    Compression compression;
+    vector<unsigned char> data;
+    for (int i = 0; i < 4; ++i) { // The `auto` codec needs a few rounds to measure the codecs
+        data = compression.compress(base, codec);
+    }
+    bh_data_free(&base);
+    return data.empty() ? 1 : base.nbytes() / static_cast<double>(data.size());
+}
+
+// Start the backend, which serves one session
+pid_t spawn_backend(const Options &opt) {
+    const string port = to_string(opt.port);
+    const pid_t pid = fork();
+    if (pid < 0) {
+        throw runtime_error("bh_proxy_bench: fork() failed");
+    }
+    if (pid == 0) {
+        execl(opt.backend.c_str(), opt.backend.c_str(), "-a", opt.address.c_str(), "-p", port.c_str(), "-n", "1",
+              static_cast<char *>(nullptr));
+        cerr << "bh_proxy_bench: cannot execute " << opt.backend << ": " << strerror(errno) << endl;
+        _exit(1);
+    }
+    usleep(200 * 1000); // Let the backend start listening
+    return pid;
+}
+
+Result run(const Options &opt, const string &codec, const string &proxy_path, int proxy_level) {
+    // The frontend and the backend read the options of the proxy VEM from the environment
+    setenv("BH_PROXY_COMPRESS_PARAM", codec.c_str(), 1);
+    setenv("BH_PROXY_ADDRESS", opt.address.c_str(), 1);
+    setenv("BH_PROXY_PORT", to_string(opt.port).c_str(), 1);
+    setenv("BH_PROXY_EMULATE_BANDWIDTH", to_string(opt.bandwidth).c_str(), 1);
+    setenv("BH_PROXY_EMULATE_LATENCY", to_string(opt.latency).c_str(), 1);
+    setenv("BH_PROXY_EMULATE_JITTER", to_string(opt.jitter).c_str(), 1);
+    if (not opt.pipeline_depth.empty()) {
+        setenv("BH_PROXY_PIPELINE_DEPTH", opt.pipeline_depth.c_str(), 1);
+    }
+
+    Result ret;
+    ret.ratio = compression_ratio(opt, codec);
+    ret.nbytes_moved = 0;
+    const pid_t backend = spawn_backend(opt);
+    {
+        ComponentFace proxy(proxy_path, proxy_level);
+        const auto nelem = static_cast<int64_t>(opt.nbytes / sizeof(double));
+        const auto start = chrono::steady_clock::now();
+        for (uint64_t iter = 0; iter < opt.iterations; ++iter) {
+            vector<unique_ptr<bh_base> > inputs, outputs;
+            vector<bh_instruction> instr_list;
+            set<bh_base *> syncs;
+            for (uint64_t i = 0; i < opt.narrays; ++i) {
+                inputs.emplace_back(new bh_base(nelem, bh_type::FLOAT64));
+                outputs.emplace_back(new bh_base(nelem, bh_type::FLOAT64));
+                bh_data_malloc(inputs.back().get());
+                fill(*inputs.back(), opt.pattern, iter * opt.narrays + i);
+                bh_instruction add(BH_ADD, {bh_view(outputs.back().get()), bh_view(inputs.back().get()), bh_view()});
+                add.constant = bh_constant(1.0);
+                instr_list.push_back(add);
+                instr_list.push_back(bh_instruction(BH_FREE, {bh_view(inputs.back().get())}));
+                syncs.insert(outputs.back().get());
+            }
+            const double expect = *static_cast<double *>(inputs[0]->getDataPtr()) + 1;
+            BhIR bhir(std::move(instr_list), syncs);
+
+            const auto t = chrono::steady_clock::now();
+            proxy.execute(&bhir);
+            for (unique_ptr<bh_base> &out: outputs) {
+                void *data = proxy.getMemoryPointer(*out, true, false, true);
+                out->resetDataPtr(data);
+            }
+            ret.latencies.push_back(chrono::duration<double>(chrono::steady_clock::now() - t).count());
+
+            if (outputs[0]->getDataPtr() == nullptr or *static_cast<double *>(outputs[0]->getDataPtr()) != expect) {
+                throw runtime_error("bh_proxy_bench: the backend returned a wrong result");
+            }
+            for (unique_ptr<bh_base> &out: outputs) {
+                bh_data_free(out.get());
+            }
+            ret.nbytes_moved += 2 * opt.narrays * nelem * sizeof(double);
+        }
+        ret.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } // Shuts down the backend
+    int status;
+    waitpid(backend, &status, 0);
+    return ret;
+}
+
+// Returns the path of `bh_proxy_backend` next to this executable
+string default_backend() {
+    char path[4096];
+    const ssize_t n = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (n <= 0) {
+        return "bh_proxy_backend";
+    }
+    path[n] = '\0';
+    string ret(path);
+    return ret.substr(0, ret.find_last_of('/') + 1) + "bh_proxy_backend";
+}
+}
+
+int main(int argc, char *argv[]) {
+    Options opt;
+    opt.backend = default_backend();
+    opt.codecs = {"none", "zlib"};
+    if (lz4_available()) {
+        opt.codecs.push_back("lz4");
+    }
+    if (zstd_available()) {
+        opt.codecs.push_back("zstd");
+    }
+    opt.codecs.push_back("auto");
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const string arg = argv[i];
+            if (arg == "-h" or arg == "--help") {
+                usage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                throw invalid_argument("missing value of " + arg);
+            }
+            const string value = argv[++i];
+            if (arg == "--codecs") {
+                opt.codecs.clear();
+                boost::split(opt.codecs, value, boost::is_any_of(","));
+            } else if (arg == "--size") {
+                opt.nbytes = static_cast<uint64_t>(parse_size(value));
+            } else if (arg == "--arrays") {
+                opt.narrays = stoull(value);
+            } else if (arg == "--iterations") {
+                opt.iterations = stoull(value);
+            } else if (arg == "--pattern") {
+                opt.pattern = value;
+            } else if (arg == "--bandwidth") {
+                opt.bandwidth = parse_size(value);
+            } else if (arg == "--latency") {
+                opt.latency = stod(value);
+            } else if (arg == "--jitter") {
+                opt.jitter = stod(value);
+            } else if (arg == "--pipeline-depth") {
+                opt.pipeline_depth = value;
+            } else if (arg == "--address") {
+                opt.address = value;
+            } else if (arg == "--port") {
+                opt.port = stoi(value);
+            } else if (arg == "--backend") {
+                opt.backend = value;
+            } else {
+                throw invalid_argument("unknown option " + arg);
+            }
+        }
+        if (opt.nbytes < sizeof(double) or opt.narrays == 0 or opt.iterations == 0) {
+            throw invalid_argument("the size, arrays, and iterations must be positive");
+        }
+    } catch (const exception &e) {
+        cerr << "bh_proxy_bench: " << e.what() << endl;
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Find the proxy VEM in the stack
+    string proxy_path;
+    int proxy_level = -1;
+    try {
+        for (int level = 0; proxy_path.empty(); ++level) {
+            if (ConfigParser(level).getName() == "proxy") {
+                proxy_path = ConfigParser(level - 1).getChildLibraryPath();
+                proxy_level = level;
+            }
+        }
+    } catch (const ConfigError &) {
+        cerr << "bh_proxy_bench: the stack (BH_STACK) has no proxy VEM" << endl;
+        return 1;
+    }
+
+    cout << "Proxy benchmark: " << opt.iterations << " iterations of " << opt.narrays << " x "
+         << opt.nbytes / 1024.0 / 1024.0 << " MiB arrays (" << opt.pattern << ")\n"
+         << "Emulated link: ";
+    if (opt.bandwidth > 0) {
+        cout << opt.bandwidth / 1e6 << " MB/s, ";
+    } else {
+        cout << "unlimited bandwidth, ";
+    }
+    cout << opt.latency * 1e3 << " ms latency, " << opt.jitter * 1e3 << " ms jitter\n\n";
+    cout << left << setw(12) << "codec" << right << setw(8) << "ratio" << setw(14) << "MB/s"
+         << setw(11) << "p50 ms" << setw(11) << "p90 ms" << setw(11) << "p99 ms" << setw(11) << "max ms" << endl;
+    cout << fixed;
+    for (const string &codec: opt.codecs) {
+        try {
+            Result r = run(opt, codec, proxy_path, proxy_level);
+            cout << left << setw(12) << codec << right << setprecision(2) << setw(8) << r.ratio
+                 << setprecision(1) << setw(14) << r.nbytes_moved / r.seconds / 1e6 << setprecision(2)
+                 << setw(11) << percentile(r.latencies, 50) * 1e3
+                 << setw(11) << percentile(r.latencies, 90) * 1e3
+                 << setw(11) << percentile(r.latencies, 99) * 1e3
+                 << setw(11) << percentile(r.latencies, 100) * 1e3 << endl;
+        } catch (const exception &e) {
+            cout << left << setw(12) << codec << " failed: " << e.what() << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "buffer_pool.hpp"
+
+using namespace std;
+
+BufferPool::State::~State() {
+    for (auto &buffer: free) {
+        delete[] buffer.first;
+    }
+}
+
+BufferPool::BufferPool(size_t max_buffers) : _state(make_shared<State>(max_buffers)) {}
+
+shared_ptr<unsigned char> BufferPool::get(size_t nbytes) {
+    unsigned char *mem = nullptr;
+    size_t capacity = 0;
+    {
+        // Let's find the smallest free buffer that fits
+        lock_guard<mutex> lock(_state->mutex);
+        auto best = _state->free.end();
+        for (auto it = _state->free.begin(); it != _state->free.end(); ++it) {
+            if (it->second >= nbytes and (best == _state->free.end() or it->second < best->second)) {
+                best = it;
+            }
+        }
+        if (best != _state->free.end()) {
+            mem = best->first;
+            capacity = best->second;
+            _state->free.erase(best);
+        }
+    }
+    if (mem == nullptr) {
+        capacity = std::max<size_t>(nbytes, 1);
+        mem = new unsigned char[capacity];
+    }
+    weak_ptr<State> state = _state;
+    return shared_ptr<unsigned char>(mem, [state, capacity](unsigned char *p) {
+        shared_ptr<State> s = state.lock();
+        if (s) {
+            lock_guard<mutex> lock(s->mutex);
+            if (s->free.size() < s->max_buffers) {
+                s->free.push_back(make_pair(p, capacity));
+                return;
+            }
+        }
+        delete[] p;
+    });
+}
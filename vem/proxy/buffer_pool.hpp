@@ -0,0 +1,52 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** A pool of receive buffers, which are reused instead of allocating (and page faulting) new memory for every
+ * received chunk of data. A buffer returns to the pool when its last reference goes away, even when the pool is gone.
+ */
+class BufferPool {
+private:
+    struct State {
+        std::mutex mutex;
+        std::vector<std::pair<unsigned char *, size_t> > free; // The free buffers and their capacity
+        size_t max_buffers;
+
+        explicit State(size_t max_buffers) : max_buffers(max_buffers) {}
+
+        ~State();
+    };
+
+    std::shared_ptr<State> _state;
+
+public:
+    /** Create a new pool
+     *
+     * @param max_buffers The maximum number of free buffers to keep, the rest are deallocated
+     */
+    explicit BufferPool(size_t max_buffers = 16);
+
+    /// Returns a buffer of at least `nbytes` bytes. NB: the buffer isn't initiated
+    std::shared_ptr<unsigned char> get(size_t nbytes);
+};
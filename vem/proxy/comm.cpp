@@ -19,49 +19,223 @@ If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <iostream>
+#include <array>
+#include <cstring>
 #include <boost/asio.hpp>
 #include <thread>         // std::this_thread::sleep_for
 #include <chrono>         // std::chrono::seconds
 #include <zlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
 #include <bh_main_memory.hpp>
 
 #include "serialize.hpp"
 #include "comm.hpp"
 
+// Array data is passed through memory files (memfd) when the platform supports it. This is a single-copy transport:
+// the sender copies the data into a new memory file, which the receiver maps without copying.
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+#define BH_PROXY_SINGLE_COPY
+#endif
 
 using boost::asio::ip::tcp;
+using boost::asio::local::stream_protocol;
 using namespace std;
 
 namespace {
-void comm_send_data(boost::asio::ip::tcp::socket &socket, const std::vector<unsigned char> &data) {
-    if (data.empty()) {
-        const size_t size[] = {0};
-        boost::asio::write(socket, boost::asio::buffer(size));
-    } else {
-        const size_t size[] = {data.size()};
-        boost::asio::write(socket, boost::asio::buffer(size));
-        boost::asio::write(socket, boost::asio::buffer(data, data.size()));
-    }
+// Write the size of `nbytes` of `data` followed by the data in one system call
+void comm_write_frame(CommSocket &socket, const void *data, size_t nbytes) {
+    const size_t size[] = {nbytes};
+    const std::array<boost::asio::const_buffer, 2> buffers = {{boost::asio::buffer(size),
+                                                               boost::asio::buffer(data, nbytes)}};
+    boost::asio::write(socket, buffers);
 }
 
-std::vector<unsigned char> comm_recv_data(boost::asio::ip::tcp::socket &socket) {
-    size_t size[1];
-    boost::asio::read(socket, boost::asio::buffer(size));
-    std::vector<unsigned char> ret(size[0]);
+void comm_send_data(CommSocket &socket, const std::vector<unsigned char> &data) {
+    comm_write_frame(socket, data.data(), data.size());
+}
+
+std::vector<unsigned char> comm_recv_data(CommReader &reader) {
+    size_t size;
+    reader.read(&size, sizeof(size));
+    std::vector<unsigned char> ret(size);
     if (not ret.empty()) {
-        boost::asio::read(socket, boost::asio::buffer(ret));
+        reader.read(&ret[0], ret.size());
     }
     return ret;
 }
+
+void throw_errno(const std::string &func) {
+    stringstream ss;
+    ss << "[PROXY-VEM] " << func << " failed: " << strerror(errno);
+    throw runtime_error(ss.str());
+}
+
+// Closes the file descriptor when going out of scope
+struct FileDescriptor {
+    int fd;
+    explicit FileDescriptor(int fd) : fd(fd) {}
+    ~FileDescriptor() { if (fd >= 0) { ::close(fd); }}
+};
+
+// Send the file descriptor `fd` over the Unix domain socket `sock`
+void send_fd(int sock, int fd) {
+    char byte = 0;
+    struct iovec iov = {&byte, 1};
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(int))];
+    } control;
+    memset(&control, 0, sizeof(control));
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    while (sendmsg(sock, &msg, MSG_NOSIGNAL) < 0) {
+        if (errno != EINTR) {
+            throw_errno("sendmsg()");
+        }
+    }
+}
+
+// Receive a file descriptor from the Unix domain socket `sock`
+int recv_fd(int sock) {
+    char byte;
+    struct iovec iov = {&byte, 1};
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(int))];
+    } control;
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    ssize_t ret;
+    while ((ret = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC)) < 0) {
+        if (errno != EINTR) {
+            throw_errno("recvmsg()");
+        }
+    }
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (ret == 0 or cmsg == nullptr or cmsg->cmsg_level != SOL_SOCKET or cmsg->cmsg_type != SCM_RIGHTS) {
+        throw runtime_error("[PROXY-VEM] expected a file descriptor from the other end");
+    }
+    int fd;
+    memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    return fd;
+}
+
+// Send the data of `base` as a memory file: the data is copied once into the memory file, which the receiver maps
+// directly as the data of its base array. The sender keeps using its own data, thus the two processes never share
+// the pages of a live base array. A base array without data is sent as empty data like `comm_send_data()`.
+void comm_send_memfd(CommSocket &socket, const bh_base &base) {
+    const size_t nbytes = static_cast<size_t>(base.nbytes());
+    if (base.getDataPtr() == nullptr or nbytes == 0) {
+        comm_send_data(socket, {});
+        return;
+    }
+#ifdef BH_PROXY_SINGLE_COPY
+    FileDescriptor file(memfd_create("bohrium", MFD_CLOEXEC));
+    if (file.fd < 0) {
+        throw_errno("memfd_create()");
+    }
+    const char *data = static_cast<const char *>(base.getDataPtr());
+    size_t written = 0;
+    while (written < nbytes) {
+        const ssize_t n = ::write(file.fd, data + written, nbytes - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("write()");
+        }
+        written += static_cast<size_t>(n);
+    }
+    const size_t size[] = {nbytes};
+    boost::asio::write(socket, boost::asio::buffer(size));
+    send_fd(socket.native_handle(), file.fd);
+#else
+    throw runtime_error("[PROXY-VEM] memory files aren't supported on this platform");
+#endif
+}
+
+// Receive data sent by `comm_send_memfd()` into `base`. When `base` has no data, the memory file becomes its data.
+// NB: `reader` must not read ahead since the file descriptor follows the size
+bool comm_recv_memfd(CommSocket &socket, CommReader &reader, bh_base &base) {
+    size_t size[1];
+    reader.read(size, sizeof(size));
+    if (size[0] == 0) {
+        return false;
+    }
+    if (size[0] != static_cast<size_t>(base.nbytes())) {
+        throw runtime_error("[PROXY-VEM] the received memory file doesn't match the size of the base array");
+    }
+    FileDescriptor file(recv_fd(socket.native_handle()));
+    void *mem = mmap(nullptr, size[0], PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+    if (mem == MAP_FAILED) {
+        throw_errno("mmap()");
+    }
+    if (base.getDataPtr() == nullptr) {
+        bh_data_adopt(&base, mem);
+    } else {
+        memcpy(base.getDataPtr(), mem, size[0]);
+        munmap(mem, size[0]);
+    }
+    return true;
+}
+
+// Returns the path of a Unix domain socket address
+std::string unix_path(const std::string &address) {
+    return address.substr(std::string("unix:").size());
+}
+
+// Returns a printable address of `endpoint`
+std::string endpoint_address(const CommSocket::endpoint_type &endpoint) {
+    stringstream ss;
+    if (endpoint.protocol().family() == AF_UNIX) {
+        stream_protocol::endpoint ep;
+        ep.resize(endpoint.size());
+        memcpy(ep.data(), endpoint.data(), endpoint.size());
+        ss << "unix:" << ep.path();
+    } else {
+        tcp::endpoint ep;
+        ep.resize(endpoint.size());
+        memcpy(ep.data(), endpoint.data(), endpoint.size());
+        ss << ep.address();
+    }
+    return ss.str();
+}
+}
+
+bool comm_is_unix_address(const std::string &address) {
+    return address.compare(0, 5, "unix:") == 0;
 }
 
 CommFrontend::CommFrontend(int stack_level,
                            const std::string &address,
                            int port,
-                           uint64_t sim_bandwidth) : sim_bandwidth(sim_bandwidth), socket(io_service) {
+                           const LinkEmulator &link,
+                           bool push_syncs) : _link(link), socket(io_service), reader(socket) {
     constexpr unsigned int retries = 100;
     for (unsigned int i = 1; i <= retries; ++i) {
         try {
+            if (comm_is_unix_address(address)) {
+                cout << "[PROXY-VEM] Connecting to " << address << endl;
+                socket.close();
+                socket.connect(stream_protocol::endpoint(unix_path(address)));
+#ifdef BH_PROXY_SINGLE_COPY
+                _single_copy = true;
+#endif
+                goto connected;
+            }
             cout << "[PROXY-VEM] Connecting to " << address << ":" << port << endl;
             // Get a list of endpoints corresponding to the server name.
             tcp::resolver resolver(io_service);
@@ -72,8 +246,9 @@ CommFrontend::CommFrontend(int stack_level,
             // Try each endpoint until we successfully establish a connection.
             boost::system::error_code error = boost::asio::error::host_not_found;
             while (error && endpoint_iterator != end) {
+                const tcp::endpoint endpoint = *endpoint_iterator++;
                 socket.close();
-                socket.connect(*endpoint_iterator++, error);
+                socket.connect(endpoint, error);
             }
             if (error)
                 throw boost::system::system_error(error);
@@ -89,9 +264,11 @@ CommFrontend::CommFrontend(int stack_level,
     throw runtime_error("[PROXY-VEM] No connection!");
 
     connected:
+    reader.read_ahead(not _single_copy);
+
     // Serialize message body
     vector<char> buf_body;
-    msg::Init body(stack_level);
+    msg::Init body(stack_level, push_syncs);
     body.serialize(buf_body);
 
     //Serialize message head
@@ -112,60 +289,171 @@ CommFrontend::~CommFrontend() {
 
     //Send serialized message
     boost::asio::write(socket, boost::asio::buffer(buf_head));
-    socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both);
+    socket.shutdown(CommSocket::shutdown_both);
     socket.close();
 }
 
+void LinkEmulator::waitUntil(chrono::steady_clock::time_point start, double seconds) {
+    const auto end = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(seconds));
+    if (end > chrono::steady_clock::now()) {
+        this_thread::sleep_until(end);
+    }
+}
+
+void LinkEmulator::transfer(uint64_t nbytes, chrono::steady_clock::time_point start) {
+    if (_bandwidth > 0) {
+        waitUntil(start, nbytes / _bandwidth);
+    }
+}
+
+void LinkEmulator::roundTrip(chrono::steady_clock::time_point start) {
+    if (_latency > 0 or _jitter > 0) {
+        std::uniform_real_distribution<double> jitter(0, _jitter);
+        waitUntil(start, 2 * _latency + jitter(_random));
+    }
+}
+
+void CommFrontend::sent(uint64_t nbytes, chrono::steady_clock::time_point start) {
+    _awaiting_reply = true;
+    _link.transfer(nbytes, start);
+}
+
+void CommFrontend::received(uint64_t nbytes, chrono::steady_clock::time_point start) {
+    if (_awaiting_reply) {
+        _awaiting_reply = false;
+        _link.roundTrip(start);
+        start = chrono::steady_clock::now();
+    }
+    _link.transfer(nbytes, start);
+}
+
+void CommFrontend::write(const std::vector<char> &buf) {
+    auto t = chrono::steady_clock::now();
+    boost::asio::write(socket, boost::asio::buffer(buf));
+    sent(buf.size(), t);
+}
+
+std::string CommFrontend::read() {
+    auto t = chrono::steady_clock::now();
+    std::string ret = reader.read_frame();
+    received(ret.size(), t);
+    return ret;
+}
+
 void CommFrontend::send_data(const std::vector<unsigned char> &data) {
     auto t = chrono::steady_clock::now();
     comm_send_data(socket, data);
-    std::chrono::duration<double> comm_time = chrono::steady_clock::now() - t;
-    std::chrono::duration<double> sim_time = std::chrono::duration<double>{data.size() / (double) sim_bandwidth};
-    if (comm_time < sim_time) {
-        sim_time -= comm_time;
-    }
-    if (sim_time.count() > 0) {
-        std::this_thread::sleep_for(sim_time);
-    }
+    sent(data.size(), t);
 }
 
 std::vector<unsigned char> CommFrontend::recv_data() {
     auto t = chrono::steady_clock::now();
-    std::vector<unsigned char> ret = comm_recv_data(socket);
-    std::chrono::duration<double> comm_time = chrono::steady_clock::now() - t;
-    std::chrono::duration<double> sim_time = std::chrono::duration<double>{ret.size() / (double) sim_bandwidth};
-    if (comm_time < sim_time) {
-        sim_time -= comm_time;
+    std::vector<unsigned char> ret = comm_recv_data(reader);
+    received(ret.size(), t);
+    return ret;
+}
+
+uint64_t CommFrontend::recv_data_size() {
+    auto t = chrono::steady_clock::now();
+    size_t size;
+    reader.read(&size, sizeof(size));
+    received(0, t);
+    return size;
+}
+
+void CommFrontend::recv_data_bytes(void *dest, uint64_t nbytes) {
+    auto t = chrono::steady_clock::now();
+    reader.read(dest, nbytes);
+    received(nbytes, t);
+}
+
+void CommReader::read_ahead(bool enable) {
+    if (_begin != _end) {
+        throw runtime_error("[PROXY-VEM] cannot change the read-ahead of a reader with buffered data");
+    }
+    _buffer.resize(enable ? 64 * 1024 : 0);
+}
+
+void CommReader::read(void *dest, size_t nbytes) {
+    char *out = static_cast<char *>(dest);
+    const size_t nbuffered = std::min(nbytes, _end - _begin);
+    if (nbuffered > 0) {
+        memcpy(out, &_buffer[_begin], nbuffered);
+        _begin += nbuffered;
+        out += nbuffered;
+        nbytes -= nbuffered;
+    }
+    if (nbytes == 0) {
+        return;
     }
-    if (sim_time.count() > 0) {
-        std::this_thread::sleep_for(sim_time);
+    // Large reads go directly into `dest`
+    if (nbytes >= _buffer.size() / 2) {
+        boost::asio::read(_socket, boost::asio::buffer(out, nbytes));
+        return;
+    }
+    // Let's read ahead as much as is available
+    _begin = 0;
+    _end = boost::asio::read(_socket, boost::asio::buffer(_buffer), boost::asio::transfer_at_least(nbytes));
+    memcpy(out, &_buffer[0], nbytes);
+    _begin = nbytes;
+}
+
+std::string CommReader::read_frame() {
+    size_t size;
+    read(&size, sizeof(size));
+    std::string ret(size, '\0');
+    if (size > 0) {
+        read(&ret[0], size);
     }
     return ret;
 }
 
-std::string CommFrontend::read() {
-    vector<char> str_vec;
-    while(1) {
-        char buf;
-        size_t bytes = boost::asio::read(socket, boost::asio::buffer(&buf, 1));
-        if (bytes != 1 or buf == '\0') {
-            break;
-        }
-        str_vec.push_back(buf);
+CommListener::CommListener(const std::string &address, int port) : acceptor(io_service) {
+    if (comm_is_unix_address(address)) {
+        _unix_path = unix_path(address);
+        cout << "[PROXY-VEM] Server listen on " << address << endl;
+        ::unlink(_unix_path.c_str()); // Remove the socket file of a previous run
+        const CommSocket::endpoint_type endpoint{stream_protocol::endpoint(_unix_path)};
+        acceptor.open(endpoint.protocol());
+        acceptor.bind(endpoint);
+    } else {
+        cout << "[PROXY-VEM] Server listen on port " << port << endl;
+        const CommSocket::endpoint_type endpoint{tcp::endpoint(tcp::v4(), port)};
+        acceptor.open(endpoint.protocol());
+        acceptor.set_option(CommAcceptor::reuse_address(true));
+        acceptor.bind(endpoint);
+    }
+    acceptor.listen();
+}
+
+CommListener::~CommListener() {
+    if (not _unix_path.empty()) {
+        ::unlink(_unix_path.c_str());
     }
-    return std::string(str_vec.begin(), str_vec.end());
 }
 
-CommBackend::CommBackend(const std::string &address, int port) : socket(io_service) {
-    cout << "[PROXY-VEM] Server listen on port " << port << endl;
-    tcp::acceptor acceptor(io_service, tcp::endpoint(tcp::v4(), port));
-    acceptor.accept(socket);
-    socket.set_option(boost::asio::ip::tcp::no_delay(true));
+CommBackend::CommBackend(CommListener &listener) : socket(listener.io_service), reader(socket) {
+    listener.acceptor.accept(socket);
+    if (listener._unix_path.empty()) {
+        socket.set_option(boost::asio::ip::tcp::no_delay(true));
+    } else {
+#ifdef BH_PROXY_SINGLE_COPY
+        _single_copy = true;
+#endif
+    }
+    reader.read_ahead(not _single_copy);
 }
 
 CommBackend::~CommBackend() {
-    socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both);
-    socket.close();
+    // The frontend might have disconnected already
+    shutdown();
+    boost::system::error_code ec;
+    socket.close(ec);
+}
+
+void CommBackend::shutdown() {
+    boost::system::error_code ec;
+    socket.shutdown(CommSocket::shutdown_both, ec);
 }
 
 void CommBackend::send_data(const std::vector<unsigned char> &data) {
@@ -173,5 +461,52 @@ void CommBackend::send_data(const std::vector<unsigned char> &data) {
 }
 
 std::vector<unsigned char> CommBackend::recv_data() {
-    return comm_recv_data(socket);
+    return comm_recv_data(reader);
+}
+
+uint64_t CommBackend::recv_data_size() {
+    size_t size;
+    reader.read(&size, sizeof(size));
+    return size;
+}
+
+void CommBackend::recv_data_bytes(void *dest, uint64_t nbytes) {
+    reader.read(dest, nbytes);
+}
+
+void CommBackend::write(const std::string &str) {
+    comm_write_frame(socket, str.data(), str.size());
+}
+
+void CommFrontend::send_memfd(const bh_base &base) {
+    auto t = chrono::steady_clock::now();
+    comm_send_memfd(socket, base);
+    sent(sizeof(size_t), t); // The data itself doesn't cross the link
+}
+
+bool CommFrontend::recv_memfd(bh_base &base) {
+    auto t = chrono::steady_clock::now();
+    const bool ret = comm_recv_memfd(socket, reader, base);
+    received(sizeof(size_t), t);
+    return ret;
+}
+
+std::string CommFrontend::ip() const {
+    // The frontend end of a Unix domain socket is unnamed
+    if (socket.local_endpoint().protocol().family() == AF_UNIX) {
+        return endpoint_address(socket.remote_endpoint()) + "\n";
+    }
+    return endpoint_address(socket.local_endpoint()) + "\n";
+}
+
+void CommBackend::send_memfd(const bh_base &base) {
+    comm_send_memfd(socket, base);
+}
+
+bool CommBackend::recv_memfd(bh_base &base) {
+    return comm_recv_memfd(socket, reader, base);
+}
+
+std::string CommBackend::ip() const {
+    return endpoint_address(socket.local_endpoint()) + "\n";
 }
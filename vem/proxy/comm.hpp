@@ -20,24 +20,98 @@ If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <string>
+#include <chrono>
+#include <random>
 #include <boost/asio.hpp>
 
+#include <bh_base.hpp>
+
 #include "serialize.hpp"
 
+/// The socket type of the communication, which is either a TCP or a Unix domain socket
+typedef boost::asio::generic::stream_protocol::socket CommSocket;
+typedef boost::asio::basic_socket_acceptor<boost::asio::generic::stream_protocol> CommAcceptor;
+
+/// Returns true when `address` names a Unix domain socket, which is written as "unix:<path>"
+bool comm_is_unix_address(const std::string &address);
+
+/** Buffered reading of a socket. Small reads, such as message heads and data sizes, are served from a read-ahead
+ * buffer, which saves a system call per read, whereas large reads go directly into their destination.
+ */
+class CommReader {
+private:
+    CommSocket &_socket;
+    std::vector<char> _buffer;
+    size_t _begin = 0; // The buffered bytes are `_buffer[_begin:_end]`
+    size_t _end = 0;
+public:
+    explicit CommReader(CommSocket &socket) : _socket(socket), _buffer(64 * 1024) {}
+
+    /// Enable or disable read-ahead. NB: we must not read ahead when the other end sends file descriptors
+    void read_ahead(bool enable);
+
+    /// Read exactly `nbytes` into `dest`
+    void read(void *dest, size_t nbytes);
+
+    /// Read a frame, which is its size (a `size_t`) followed by its bytes
+    std::string read_frame();
+};
+
+/** Emulation of a slower link on top of the actual link, which makes it possible to evaluate the communication
+ * options of a remote deployment on a single machine. A transfer of `nbytes` takes at least `nbytes / bandwidth`
+ * seconds and a round trip (receiving a reply after a request) takes at least `2 * latency` seconds plus a uniformly
+ * distributed jitter of up to `jitter` seconds.
+ */
+class LinkEmulator {
+private:
+    double _bandwidth; // Bytes per second (zero means unlimited)
+    double _latency;   // One-way latency in seconds
+    double _jitter;    // Maximum jitter of a round trip in seconds
+    std::mt19937_64 _random;
+
+    /// Wait until `seconds` have passed since `start`
+    static void waitUntil(std::chrono::steady_clock::time_point start, double seconds);
+
+public:
+    explicit LinkEmulator(double bandwidth = 0, double latency = 0, double jitter = 0) :
+            _bandwidth(bandwidth), _latency(latency), _jitter(jitter) {}
+
+    /// Returns true when the emulation slows down the link
+    bool enabled() const {
+        return _bandwidth > 0 or _latency > 0 or _jitter > 0;
+    }
+
+    /// Wait for the emulated transfer time of `nbytes`, which started at `start`
+    void transfer(uint64_t nbytes, std::chrono::steady_clock::time_point start);
+
+    /// Wait for the emulated round trip, which started at `start` when we began waiting for the reply
+    void roundTrip(std::chrono::steady_clock::time_point start);
+};
+
 class CommFrontend {
-    uint64_t sim_bandwidth = 1000; // bytes per second
+    LinkEmulator _link;
+    bool _awaiting_reply = false; // We have sent a request thus the next read waits for the round trip
+    bool _single_copy = false; // Array data is copied once through memory files instead of the socket
+
+    /// Account for the emulated link of sending `nbytes`, which started at `start`
+    void sent(uint64_t nbytes, std::chrono::steady_clock::time_point start);
+
+    /// Account for the emulated link of receiving `nbytes`, which started at `start`
+    void received(uint64_t nbytes, std::chrono::steady_clock::time_point start);
+
 public:
     boost::asio::io_service io_service;
-    boost::asio::ip::tcp::socket socket;
+    CommSocket socket;
+    CommReader reader;
 
-    CommFrontend(int stack_level, const std::string &address, int port, uint64_t sim_bandwidth);
+    /// Connect to the `CommBackend` at `address` and `port` through the emulated `link`. When `push_syncs` is true,
+    /// the backend pushes the synced arrays after each EXEC message (see `msg::Init`).
+    CommFrontend(int stack_level, const std::string &address, int port, const LinkEmulator &link, bool push_syncs);
 
     ~CommFrontend();
 
     /// Write to the `CommBackend`
-    void write(const std::vector<char> &buf) {
-        boost::asio::write(socket, boost::asio::buffer(buf));
-    }
+    void write(const std::vector<char> &buf);
 
     /// Read string from the `CommBackend`
     std::string read();
@@ -48,36 +122,67 @@ public:
     /// Receive data from the `CommBackend`
     std::vector<unsigned char> recv_data();
 
+    /// Receive the size of data from the `CommBackend`, which must be followed by `recv_data_bytes()` calls that
+    /// reads exactly that many bytes. Thus, the data of `send_data()` can be consumed while it is being received.
+    uint64_t recv_data_size();
+
+    /// Receive `nbytes` of the data announced by `recv_data_size()` into `dest`
+    void recv_data_bytes(void *dest, uint64_t nbytes);
+
+    /// Returns true when array data is passed through memory files (see `send_memfd()` and `recv_memfd()`)
+    bool single_copy() const {
+        return _single_copy;
+    }
+
+    /// Send the data of `base` to the `CommBackend` as a memory file, which costs a single copy
+    void send_memfd(const bh_base &base);
+
+    /// Receive the data of `base` from the `CommBackend` as a memory file. Returns false when no data was sent
+    bool recv_memfd(bh_base &base);
+
     std::string hostname() const {
         return boost::asio::ip::host_name();
     }
 
-    std::string ip() const {
-        std::stringstream ss;
-        ss << socket.local_endpoint().address() << "\n";
-        return ss.str();
-    }
+    std::string ip() const;
 };
 
-class CommBackend {
+/// Listens for `CommFrontend` connections, each of which is accepted as a `CommBackend`
+class CommListener {
 private:
     boost::asio::io_service io_service;
-    boost::asio::ip::tcp::socket socket;
+    CommAcceptor acceptor;
+    std::string _unix_path; // The socket file of a Unix domain socket or empty
+public:
+    CommListener(const std::string &address, int port = 4200);
+
+    /// Removes the socket file of a Unix domain socket
+    ~CommListener();
+
+    friend class CommBackend;
+};
+
+class CommBackend {
+private:
+    CommSocket socket;
+    CommReader reader;
+    bool _single_copy = false; // Array data is copied once through memory files instead of the socket
 public:
     ~CommBackend();
 
-    CommBackend(const std::string &address, int port = 4200);
+    /// Wait for and accept the next `CommFrontend` of `listener`
+    explicit CommBackend(CommListener &listener);
+
+    /// Shut down the connection, which makes blocked and following reads and writes fail
+    void shutdown();
 
     /// Read from the `CommFrontend`
     void read(std::vector<char> &buf) {
-        boost::asio::read(socket, boost::asio::buffer(buf));
+        reader.read(buf.data(), buf.size());
     }
 
-    /// Write string to the `CommFrontend`
-    void write(const std::string &str) {
-        // Write the whole string including the `\0` terminator
-        boost::asio::write(socket, boost::asio::buffer(str.c_str(), str.size() + 1));
-    }
+    /// Write string to the `CommFrontend` as a length-prefixed frame
+    void write(const std::string &str);
 
     /// Send data to the `CommFrontend`
     void send_data(const std::vector<unsigned char> &data);
@@ -85,13 +190,27 @@ public:
     /// Receive data from the `CommFrontend`
     std::vector<unsigned char> recv_data();
 
+    /// Receive the size of data from the `CommFrontend`, which must be followed by `recv_data_bytes()` calls that
+    /// reads exactly that many bytes. Thus, the data of `send_data()` can be consumed while it is being received.
+    uint64_t recv_data_size();
+
+    /// Receive `nbytes` of the data announced by `recv_data_size()` into `dest`
+    void recv_data_bytes(void *dest, uint64_t nbytes);
+
+    /// Returns true when array data is passed through memory files (see `send_memfd()` and `recv_memfd()`)
+    bool single_copy() const {
+        return _single_copy;
+    }
+
+    /// Send the data of `base` to the `CommFrontend` as a memory file, which costs a single copy
+    void send_memfd(const bh_base &base);
+
+    /// Receive the data of `base` from the `CommFrontend` as a memory file. Returns false when no data was sent
+    bool recv_memfd(bh_base &base);
+
     std::string hostname() const {
         return boost::asio::ip::host_name();
     }
 
-    std::string ip() const {
-        std::stringstream ss;
-        ss << socket.local_endpoint().address() << "\n";
-        return ss.str();
-    }
+    std::string ip() const;
 };
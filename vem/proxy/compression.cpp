@@ -23,8 +23,15 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <boost/algorithm/string.hpp>
 #include <opencv2/opencv.hpp>
 #include <colors.hpp>
+#include <thread>
+#include <future>
+#include <atomic>
+#include <deque>
+#include <chrono>
 #include "compression.hpp"
 #include "zlib.hpp"
+#include "lz4.hpp"
+#include "zstd.hpp"
 
 using namespace std;
 
@@ -52,6 +59,180 @@ int bh2cv_dtype(bh_type type) {
             throw std::runtime_error("bh2cv_dtype: unsupported type UINT64");
     }
 }
+
+/* The chunked format consists of the header {codec, raw size, chunk size, number of chunks} followed by the
+ * compressed size of each chunk and the compressed chunks. All integers are uint64_t. A chunk that doesn't
+ * compress is stored as is, which the reader recognizes by its compressed size being equal to its raw size. */
+const std::vector<std::string> chunked_codecs = {"none", "zlib", "lz4", "zstd"};
+constexpr uint64_t chunked_header_nbytes = 4 * sizeof(uint64_t);
+
+/// Returns true when `codec` uses the chunked format
+bool is_chunked(const std::string &codec) {
+    return codec == "zlib" or codec == "lz4" or codec == "zstd" or codec == "auto";
+}
+
+/// Returns the default compression level of `codec`
+int default_level(const std::string &codec) {
+    return codec == "zlib" ? -1 : 1;
+}
+
+std::vector<unsigned char> codec_compress(uint64_t codec, const void *data, uint64_t nbytes, int level) {
+    switch (codec) {
+        case 1:
+            return zlib_compress(data, nbytes, level);
+        case 2:
+            return lz4_compress(data, nbytes, level);
+        case 3:
+            return zstd_compress(data, nbytes, level);
+        default:
+            throw std::runtime_error("compress(): unknown chunked codec");
+    }
+}
+
+void codec_uncompress(uint64_t codec, const void *data, uint64_t nbytes, void *dest, uint64_t dest_nbytes) {
+    switch (codec) {
+        case 1:
+            zlib_uncompress(data, nbytes, dest, dest_nbytes);
+            break;
+        case 2:
+            lz4_uncompress(data, nbytes, dest, dest_nbytes);
+            break;
+        case 3:
+            zstd_uncompress(data, nbytes, dest, dest_nbytes);
+            break;
+        default:
+            throw std::runtime_error("uncompress(): unknown chunked codec");
+    }
+}
+
+/// Call `func(i)` for all `i` in [0:n) using up to `num_threads` threads
+void parallel_for(uint64_t n, unsigned int num_threads, const std::function<void(uint64_t)> &func) {
+    const unsigned int nthreads = static_cast<unsigned int>(std::min<uint64_t>(num_threads, n));
+    if (nthreads <= 1) {
+        for (uint64_t i = 0; i < n; ++i) {
+            func(i);
+        }
+        return;
+    }
+    std::atomic<uint64_t> next{0};
+    std::vector<std::exception_ptr> errors(nthreads);
+    auto worker = [&](unsigned int tid) {
+        try {
+            for (uint64_t i = next++; i < n; i = next++) {
+                func(i);
+            }
+        } catch (...) {
+            errors[tid] = std::current_exception();
+            next = n;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned int tid = 1; tid < nthreads; ++tid) {
+        threads.emplace_back(worker, tid);
+    }
+    worker(0);
+    for (std::thread &t: threads) {
+        t.join();
+    }
+    for (const std::exception_ptr &e: errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+}
+
+Compression::Compression(uint64_t chunk_nbytes, unsigned int num_threads, double link_bandwidth) :
+        chunk_nbytes(chunk_nbytes == 0 ? 1024 * 1024 : chunk_nbytes),
+        num_threads(num_threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : num_threads),
+        link_bandwidth(link_bandwidth) {}
+
+std::vector<unsigned char> Compression::compressChunked(const void *data, uint64_t nbytes,
+                                                        const std::string &param) {
+    vector<string> param_list;
+    boost::split(param_list, param, boost::is_any_of(","));
+    const std::string codec = param_list[0] == "auto" ? autoCodec(nbytes) : param_list[0];
+    const int level = param_list.size() > 1 ? std::stoi(param_list[1]) : default_level(codec);
+    auto t = std::chrono::steady_clock::now();
+    std::vector<unsigned char> ret = writeChunked(data, nbytes, codec, level);
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - t;
+    // The `auto` codec picks codecs from the statistics of the codecs
+    const std::string &stat_key = param_list[0] == "auto" ? codec : param;
+    const Stat stat{nbytes, ret.size(), std::max(time.count(), 1e-9)};
+    stat_per_codex[stat_key].push_back(stat);
+    Stat &total = compress_totals.insert(std::make_pair(stat_key, Stat{0, 0})).first->second;
+    total.total_raw += stat.total_raw;
+    total.total_compressed += stat.total_compressed;
+    total.compress_time += stat.compress_time;
+    return ret;
+}
+
+std::vector<unsigned char> Compression::writeChunked(const void *data, uint64_t nbytes, const std::string &codec,
+                                                     int level) {
+    const auto codec_it = std::find(chunked_codecs.begin(), chunked_codecs.end(), codec);
+    assert(codec_it != chunked_codecs.end());
+    const uint64_t codec_id = static_cast<uint64_t>(codec_it - chunked_codecs.begin());
+    const uint64_t nchunks = (nbytes + chunk_nbytes - 1) / chunk_nbytes;
+    const char *src = static_cast<const char *>(data);
+
+    // Compress the chunks in parallel. An empty chunk means that it is stored uncompressed.
+    std::vector<std::vector<unsigned char> > chunks(nchunks);
+    if (codec_id != 0) {
+        parallel_for(nchunks, num_threads, [&](uint64_t i) {
+            const uint64_t offset = i * chunk_nbytes;
+            const uint64_t size = std::min(chunk_nbytes, nbytes - offset);
+            std::vector<unsigned char> chunk = codec_compress(codec_id, src + offset, size, level);
+            if (chunk.size() < size) {
+                chunks[i] = std::move(chunk);
+            }
+        });
+    }
+
+    // Write the header, the chunk sizes, and the chunks
+    std::vector<uint64_t> offsets(nchunks + 1);
+    offsets[0] = chunked_header_nbytes + nchunks * sizeof(uint64_t);
+    for (uint64_t i = 0; i < nchunks; ++i) {
+        const uint64_t raw_size = std::min(chunk_nbytes, nbytes - i * chunk_nbytes);
+        offsets[i + 1] = offsets[i] + (chunks[i].empty() ? raw_size : chunks[i].size());
+    }
+    std::vector<unsigned char> ret(offsets[nchunks]);
+    const uint64_t header[] = {codec_id, nbytes, chunk_nbytes, nchunks};
+    memcpy(&ret[0], header, chunked_header_nbytes);
+    for (uint64_t i = 0; i < nchunks; ++i) {
+        const uint64_t size = offsets[i + 1] - offsets[i];
+        memcpy(&ret[chunked_header_nbytes + i * sizeof(uint64_t)], &size, sizeof(uint64_t));
+    }
+    parallel_for(nchunks, num_threads, [&](uint64_t i) {
+        if (chunks[i].empty()) {
+            memcpy(&ret[offsets[i]], src + i * chunk_nbytes, offsets[i + 1] - offsets[i]);
+        } else {
+            memcpy(&ret[offsets[i]], &chunks[i][0], chunks[i].size());
+        }
+    });
+    return ret;
+}
+
+std::string Compression::autoCodec(uint64_t nbytes) const {
+    std::string ret = "none";
+    double best_time = nbytes / link_bandwidth;
+    for (const std::string codec: {"lz4", "zstd", "zlib"}) {
+        if ((codec == "lz4" and not lz4_available()) or (codec == "zstd" and not zstd_available())) {
+            continue;
+        }
+        auto it = compress_totals.find(codec);
+        if (it == compress_totals.end() or it->second.total_raw == 0) {
+            return codec; // The codec hasn't been measured yet, let's try it
+        }
+        const Stat &total = it->second;
+        // Time to compress plus time to transfer the compressed data (uncompression overlaps with the transfer)
+        const double time = nbytes * total.compress_time / total.total_raw +
+                            nbytes * total.total_compressed / (double) total.total_raw / link_bandwidth;
+        if (time < best_time) {
+            best_time = time;
+            ret = codec;
+        }
+    }
+    return ret;
 }
 
 std::vector<unsigned char> Compression::compress(const bh_view &ary, const std::string &param) {
@@ -67,8 +248,8 @@ std::vector<unsigned char> Compression::compress(const bh_view &ary, const std::
     if (param.empty() or param_list.empty() or param_list[0] == "none") {
         ret.resize(ary.base->nbytes());
         memcpy(&ret[0], ary.base->getDataPtr(), ary.base->nbytes());
-    } else if (param_list[0] == "zlib") {
-        ret = zlib_compress(ary.base->getDataPtr(), ary.base->nbytes());
+    } else if (is_chunked(param_list[0])) {
+        return compressChunked(ary.base->getDataPtr(), static_cast<uint64_t>(ary.base->nbytes()), param);
     } else if (param_list[0] == "jpg" or param_list[0] == "png" or param_list[0] == "jp2") {
         const int cv_type = bh2cv_dtype(ary.base->dtype());
         if (ary.base->dtype() != bh_type::UINT8) {
@@ -113,15 +294,25 @@ void Compression::uncompress(const std::vector<unsigned char> &data, bh_view &ar
     if (data.empty()) {
         throw std::runtime_error("uncompress(): `data` is empty!");
     }
-    bh_data_malloc(ary.base);
-
     vector<string> param_list;
     boost::split(param_list, param, boost::is_any_of(","));
+    if (not param_list.empty() and is_chunked(param_list[0])) {
+        uint64_t offset = 0;
+        auto read = [&](void *dest, uint64_t nbytes) {
+            if (offset + nbytes > data.size()) {
+                throw std::runtime_error("uncompress(): `data` is truncated");
+            }
+            memcpy(dest, &data[offset], nbytes);
+            offset += nbytes;
+        };
+        uncompress(data.size(), read, *ary.base, param);
+        return;
+    }
+    bh_data_malloc(ary.base);
+
     if (param.empty() or param_list.empty() or param_list[0] == "none") {
         assert(static_cast<int64_t>(data.size()) == ary.base->nbytes());
         memcpy(ary.base->getDataPtr(), &data[0], ary.base->nbytes());
-    } else if (param_list[0] == "zlib") {
-        zlib_uncompress(data, ary.base->getDataPtr(), ary.base->nbytes());
     } else if (param_list[0] == "jpg" or param_list[0] == "png" or param_list[0] == "jp2") {
         if (ary.base->dtype() != bh_type::UINT8) {
             throw std::runtime_error("uncompress(): jpg and png only support uint8 arrays");
@@ -143,20 +334,141 @@ void Compression::uncompress(const std::vector<unsigned char> &data, bh_base &ar
     uncompress(data, view, param);
 }
 
+void Compression::uncompress(uint64_t nbytes, const ReadFunc &read, bh_base &ary, const std::string &param) {
+    vector<string> param_list;
+    boost::split(param_list, param, boost::is_any_of(","));
+    if (param.empty() or param_list.empty() or param_list[0] == "none") {
+        if (nbytes != static_cast<uint64_t>(ary.nbytes())) {
+            throw std::runtime_error("uncompress(): the size of the data doesn't match `ary`");
+        }
+        bh_data_malloc(&ary);
+        read(ary.getDataPtr(), nbytes);
+        stat_per_codex[param].push_back(Stat{nbytes, nbytes});
+        return;
+    }
+    if (not is_chunked(param_list[0])) {
+        std::vector<unsigned char> data(nbytes);
+        read(&data[0], nbytes);
+        uncompress(data, ary, param);
+        return;
+    }
+    auto dest = [&](uint64_t raw_nbytes) -> void * {
+        if (raw_nbytes != static_cast<uint64_t>(ary.nbytes())) {
+            throw std::runtime_error("uncompress(): the size of the data doesn't match `ary`");
+        }
+        bh_data_malloc(&ary);
+        return ary.getDataPtr();
+    };
+    uncompressChunked(nbytes, read, dest, param);
+}
+
+void Compression::uncompressChunked(uint64_t nbytes, const ReadFunc &read,
+                                    const std::function<void *(uint64_t)> &destination, const std::string &param) {
+    if (nbytes < chunked_header_nbytes) {
+        throw std::runtime_error("uncompress(): `data` is truncated");
+    }
+    uint64_t header[4];
+    read(header, chunked_header_nbytes);
+    const uint64_t codec_id = header[0];
+    const uint64_t raw_nbytes = header[1];
+    const uint64_t chunk_size = header[2];
+    const uint64_t nchunks = header[3];
+    if (codec_id >= chunked_codecs.size() or chunk_size == 0 or
+        nchunks != (raw_nbytes + chunk_size - 1) / chunk_size) {
+        throw std::runtime_error("uncompress(): malformed chunked data");
+    }
+    std::vector<uint64_t> sizes(nchunks);
+    if (nchunks > 0) {
+        read(&sizes[0], nchunks * sizeof(uint64_t));
+    }
+    char *dest = static_cast<char *>(destination(raw_nbytes));
+
+    // Uncompress each chunk in its own task while reading the following chunks
+    std::deque<std::future<void> > in_flight;
+    for (uint64_t i = 0; i < nchunks; ++i) {
+        const uint64_t offset = i * chunk_size;
+        const uint64_t size = std::min(chunk_size, raw_nbytes - offset);
+        if (sizes[i] == size) { // A stored chunk, which we read directly into `ary`
+            read(dest + offset, size);
+            continue;
+        }
+        const uint64_t compressed_nbytes = sizes[i];
+        std::shared_ptr<unsigned char> chunk = chunk_pool.get(compressed_nbytes);
+        read(chunk.get(), compressed_nbytes);
+        if (num_threads <= 1) {
+            codec_uncompress(codec_id, chunk.get(), compressed_nbytes, dest + offset, size);
+            continue;
+        }
+        if (in_flight.size() >= num_threads) {
+            in_flight.front().get();
+            in_flight.pop_front();
+        }
+        in_flight.push_back(std::async(std::launch::async, [chunk, compressed_nbytes, codec_id, dest, offset, size]() {
+            codec_uncompress(codec_id, chunk.get(), compressed_nbytes, dest + offset, size);
+        }));
+    }
+    for (std::future<void> &f: in_flight) {
+        f.get();
+    }
+    const std::string &stat_key = param.compare(0, 4, "auto") == 0 ? chunked_codecs[codec_id] : param;
+    stat_per_codex[stat_key].push_back(Stat{raw_nbytes, nbytes});
+}
+
+std::vector<unsigned char> Compression::compress(const std::vector<unsigned char> &data, const std::string &param) {
+    vector<string> param_list;
+    boost::split(param_list, param, boost::is_any_of(","));
+    if (data.empty() or param_list.empty() or not is_chunked(param_list[0])) {
+        return data;
+    }
+    return compressChunked(&data[0], data.size(), param);
+}
+
+std::vector<unsigned char> Compression::uncompress(const std::vector<unsigned char> &data, const std::string &param) {
+    vector<string> param_list;
+    boost::split(param_list, param, boost::is_any_of(","));
+    if (data.empty() or param_list.empty() or not is_chunked(param_list[0])) {
+        return data;
+    }
+    std::vector<unsigned char> ret;
+    uint64_t offset = 0;
+    auto read = [&](void *dest, uint64_t nbytes) {
+        if (offset + nbytes > data.size()) {
+            throw std::runtime_error("uncompress(): `data` is truncated");
+        }
+        memcpy(dest, &data[offset], nbytes);
+        offset += nbytes;
+    };
+    auto dest = [&](uint64_t raw_nbytes) -> void * {
+        ret.resize(raw_nbytes);
+        return ret.empty() ? nullptr : &ret[0];
+    };
+    uncompressChunked(data.size(), read, dest, param);
+    return ret;
+}
+
 std::string Compression::pprintStats() const {
     stringstream ss;
     ss << BLU << "[PROXY-VEM] Profiling: \n" << RST;
     for (auto &param: stat_per_codex) {
         uint64_t total_raw = 0;
         uint64_t total_compressed = 0;
+        uint64_t compress_raw = 0;
+        double compress_time = 0;
         for (const Stat &stat: param.second) {
             total_raw += stat.total_raw;
             total_compressed += stat.total_compressed;
+            if (stat.compress_time > 0) {
+                compress_raw += stat.total_raw;
+                compress_time += stat.compress_time;
+            }
         }
         ss << "Codex \"" << param.first << "\":\n";
         ss << "  Raw data: " << total_raw << "\n";
         ss << "  Zip data: " << total_compressed << "\n";
         ss << "  Ratio: " << total_raw / (double) total_compressed << "\n";
+        if (compress_time > 0) {
+            ss << "  Zip throughput: " << compress_raw / compress_time / 1024.0 / 1024.0 << "MB/s\n";
+        }
     }
     return ss.str();
 }
@@ -20,24 +20,62 @@ If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <functional>
 #include <bh_view.hpp>
 
+#include "buffer_pool.hpp"
+
 namespace bohrium {
 class Compression {
     struct Stat {
         uint64_t total_raw;
         uint64_t total_compressed;
+        double compress_time; // Seconds spent compressing (zero when uncompressing)
 
-        Stat(uint64_t total_raw, uint64_t total_compressed) : total_raw(total_raw),
-                                                              total_compressed(total_compressed) {}
+        Stat(uint64_t total_raw, uint64_t total_compressed, double compress_time = 0) :
+                total_raw(total_raw), total_compressed(total_compressed), compress_time(compress_time) {}
     };
 
     std::map<std::string, std::vector<Stat> > stat_per_codex;
+    // The sum of the compressions (the stats with a compress time) of each codec in `stat_per_codex`
+    std::map<std::string, Stat> compress_totals;
+
+    uint64_t chunk_nbytes;   // Size of the uncompressed chunks
+    unsigned int num_threads; // Number of threads (de)compressing chunks
+    double link_bandwidth;   // The expected bandwidth of the link in bytes per second (used by the `auto` codec)
+    BufferPool chunk_pool;   // The receive buffers of compressed chunks
+
+    /// Compress `nbytes` of `data` into the chunked format using `codec` ("none", "zlib", "lz4", or "zstd")
+    std::vector<unsigned char> writeChunked(const void *data, uint64_t nbytes, const std::string &codec, int level);
+
+    /// Compress `nbytes` of `data` into the chunked format using the codec of `param` and record the statistics
+    std::vector<unsigned char> compressChunked(const void *data, uint64_t nbytes, const std::string &param);
+
+    /// Uncompress the chunked format of `nbytes`, which is read through `read`, into the memory that
+    /// `destination` returns when called with the uncompressed size
+    void uncompressChunked(uint64_t nbytes, const std::function<void(void *, uint64_t)> &read,
+                           const std::function<void *(uint64_t)> &destination, const std::string &param);
+
+    /// Returns the codec of the chunked format that minimizes the estimated time to compress and transfer `nbytes`
+    std::string autoCodec(uint64_t nbytes) const;
 
 public:
-    Compression() = default;
+    /// Function that reads exactly `nbytes` bytes into `dest`
+    typedef std::function<void(void *dest, uint64_t nbytes)> ReadFunc;
+
+    /** Constructor
+     *
+     * @param chunk_nbytes   The size of the uncompressed chunks, which are (de)compressed in parallel
+     * @param num_threads    Number of (de)compression threads (0 means one per hardware thread)
+     * @param link_bandwidth The expected link bandwidth in bytes per second, which the `auto` codec uses
+     */
+    explicit Compression(uint64_t chunk_nbytes = 1024 * 1024, unsigned int num_threads = 0,
+                         double link_bandwidth = 1.25e9);
 
     /** Compress `ary`
+     *
+     * The codecs `zlib`, `lz4`, `zstd`, and `auto` (which picks one of them per array from the statistics
+     * of previous compressions and `link_bandwidth`) use a chunked format, which (de)compress in parallel.
      *
      * @param ary    The array view to compress, the view MUST represent the whole base array and be contiguous
      * @param param  A string of parameters to parsed through to the compress library
@@ -69,6 +107,33 @@ public:
      */
     void uncompress(const std::vector<unsigned char> &data, bh_base &ary, const std::string &param);
 
+    /** Uncompress `nbytes` of compressed data, which is read through `read`, into `ary`.
+     * The chunks of the chunked format are uncompressed while the following chunks are read, and uncompressed data
+     * (the `none` codec and stored chunks) is read directly into `ary`.
+     *
+     * @param nbytes The number of bytes of compressed data
+     * @param read   Function that reads the compressed data
+     * @param ary    The output array
+     * @param param  A string of parameters to parsed through to the compress library
+     */
+    void uncompress(uint64_t nbytes, const ReadFunc &read, bh_base &ary, const std::string &param);
+
+    /** Compress the bytes `data`, which is only compressed by the codecs of the chunked format
+     *
+     * @param data   The bytes to compress
+     * @param param  A string of parameters to parsed through to the compress library
+     * @return       The compressed bytes
+     */
+    std::vector<unsigned char> compress(const std::vector<unsigned char> &data, const std::string &param);
+
+    /** Uncompress bytes compressed by `compress(const std::vector<unsigned char> &data, param)`
+     *
+     * @param data   The byte of compressed data
+     * @param param  A string of parameters to parsed through to the compress library
+     * @return       The uncompressed bytes
+     */
+    std::vector<unsigned char> uncompress(const std::vector<unsigned char> &data, const std::string &param);
+
     /** Pretty print statistics
      *
      * @return The printed string
@@ -81,4 +146,4 @@ public:
      */
     std::string pprintStatsDetail() const;
 };
-}
\ No newline at end of file
+}
@@ -0,0 +1,123 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <stdexcept>
+#include "delta.hpp"
+
+using namespace std;
+
+namespace {
+// A 64-bit hash of `nbytes` of `data` (multiply-xorshift over 8-byte words)
+uint64_t hash_page(const unsigned char *data, uint64_t nbytes) {
+    constexpr uint64_t prime = 0x9E3779B97F4A7C15ULL;
+    uint64_t h = nbytes * prime;
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= nbytes; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(uint64_t));
+        h = (h ^ (word * prime)) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+    }
+    for (; i < nbytes; ++i) {
+        h = (h ^ data[i]) * prime;
+    }
+    return h ^ (h >> 29);
+}
+
+// Append the integer `value` to `out`
+void write_uint64(std::vector<unsigned char> &out, uint64_t value) {
+    const auto *p = reinterpret_cast<const unsigned char *>(&value);
+    out.insert(out.end(), p, p + sizeof(uint64_t));
+}
+}
+
+std::vector<uint64_t> delta_page_hashes(const void *data, uint64_t nbytes) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    const uint64_t npages = (nbytes + delta_page_nbytes - 1) / delta_page_nbytes;
+    std::vector<uint64_t> ret(npages);
+    for (uint64_t i = 0; i < npages; ++i) {
+        const uint64_t offset = i * delta_page_nbytes;
+        ret[i] = hash_page(bytes + offset, std::min(delta_page_nbytes, nbytes - offset));
+    }
+    return ret;
+}
+
+/* The patch consists of the number of runs followed by the offset and size of each run and the bytes of the runs.
+ * A run is a range of consecutive differing pages. All integers are uint64_t. */
+bool delta_make_patch(const void *data, uint64_t nbytes, const std::vector<uint64_t> &hashes, double max_fraction,
+                      std::vector<unsigned char> &patch) {
+    const std::vector<uint64_t> current = delta_page_hashes(data, nbytes);
+    if (current.size() != hashes.size()) {
+        return false;
+    }
+    std::vector<std::pair<uint64_t, uint64_t> > runs; // Offset and size of the runs
+    uint64_t dirty_pages = 0;
+    for (uint64_t i = 0; i < current.size(); ++i) {
+        if (current[i] == hashes[i]) {
+            continue;
+        }
+        ++dirty_pages;
+        const uint64_t offset = i * delta_page_nbytes;
+        const uint64_t size = std::min(delta_page_nbytes, nbytes - offset);
+        if (not runs.empty() and runs.back().first + runs.back().second == offset) {
+            runs.back().second += size;
+        } else {
+            runs.emplace_back(offset, size);
+        }
+    }
+    if (dirty_pages > max_fraction * current.size()) {
+        return false;
+    }
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    patch.clear();
+    write_uint64(patch, runs.size());
+    for (const auto &run: runs) {
+        write_uint64(patch, run.first);
+        write_uint64(patch, run.second);
+    }
+    for (const auto &run: runs) {
+        patch.insert(patch.end(), bytes + run.first, bytes + run.first + run.second);
+    }
+    return true;
+}
+
+void delta_apply_patch(const std::vector<unsigned char> &patch, void *data, uint64_t nbytes) {
+    auto read_uint64 = [&](uint64_t offset) -> uint64_t {
+        if (offset + sizeof(uint64_t) > patch.size()) {
+            throw runtime_error("delta_apply_patch(): the patch is truncated");
+        }
+        uint64_t ret;
+        memcpy(&ret, &patch[offset], sizeof(uint64_t));
+        return ret;
+    };
+    const uint64_t nruns = read_uint64(0);
+    uint64_t pos = sizeof(uint64_t) * (1 + 2 * nruns); // Position of the bytes of the first run
+    auto *bytes = static_cast<unsigned char *>(data);
+    for (uint64_t i = 0; i < nruns; ++i) {
+        const uint64_t offset = read_uint64(sizeof(uint64_t) * (1 + 2 * i));
+        const uint64_t size = read_uint64(sizeof(uint64_t) * (2 + 2 * i));
+        if (offset + size > nbytes or pos + size > patch.size()) {
+            throw runtime_error("delta_apply_patch(): the patch doesn't fit the data");
+        }
+        memcpy(bytes + offset, &patch[pos], size);
+        pos += size;
+    }
+}
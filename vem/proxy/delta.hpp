@@ -0,0 +1,59 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+/* Delta transfer: the two ends compare the hashes of the pages of an array and only the differing pages are
+ * transferred as a patch, which is applied to the copy that the other end already holds. */
+
+/// Size of the pages that are compared
+constexpr uint64_t delta_page_nbytes = 4096;
+
+/** Returns the hash of each page of `data`
+ *
+ * @param data    The data to hash
+ * @param nbytes  The number of bytes in data
+ * @return        A hash per page (the last page might be partial)
+ */
+std::vector<uint64_t> delta_page_hashes(const void *data, uint64_t nbytes);
+
+/** Write the patch of the pages of `data` that differ from the pages of `hashes`
+ *
+ * @param data          The current data
+ * @param nbytes        The number of bytes in data
+ * @param hashes        The page hashes of the copy to patch, which must be of size `nbytes`
+ * @param max_fraction  The maximum fraction of differing pages, above which no patch is written
+ * @param patch         The output patch
+ * @return              False when more than `max_fraction` of the pages differ, in which case the whole
+ *                      data should be transferred instead
+ */
+bool delta_make_patch(const void *data, uint64_t nbytes, const std::vector<uint64_t> &hashes, double max_fraction,
+                      std::vector<unsigned char> &patch);
+
+/** Apply `patch` to `data`
+ *
+ * @param patch   The patch written by `delta_make_patch()`
+ * @param data    The data to patch
+ * @param nbytes  The number of bytes in data
+ */
+void delta_apply_patch(const std::vector<unsigned char> &patch, void *data, uint64_t nbytes);
@@ -0,0 +1,72 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#ifdef BH_PROXY_WITH_LZ4
+#include <lz4.h>
+#endif
+#include "lz4.hpp"
+
+#ifdef BH_PROXY_WITH_LZ4
+
+bool lz4_available() {
+    return true;
+}
+
+std::vector<unsigned char> lz4_compress(const void *data, uint64_t nbytes, int level) {
+    const int bound = LZ4_compressBound(static_cast<int>(nbytes));
+    if (bound <= 0) {
+        throw std::runtime_error("lz4 compress(): input too large");
+    }
+    std::vector<unsigned char> ret(static_cast<size_t>(bound));
+    const int size = LZ4_compress_fast((const char *) data, (char *) &ret[0], static_cast<int>(nbytes), bound,
+                                       level < 1 ? 1 : level);
+    if (size <= 0) {
+        throw std::runtime_error("lz4 compress(): failed");
+    }
+    ret.resize(static_cast<size_t>(size));
+    return ret;
+}
+
+void lz4_uncompress(const void *data, uint64_t nbytes, void *dest, uint64_t dest_nbytes) {
+    const int size = LZ4_decompress_safe((const char *) data, (char *) dest, static_cast<int>(nbytes),
+                                         static_cast<int>(dest_nbytes));
+    if (size < 0 or static_cast<uint64_t>(size) != dest_nbytes) {
+        throw std::runtime_error("lz4 uncompress(): failed");
+    }
+}
+
+#else
+
+bool lz4_available() {
+    return false;
+}
+
+std::vector<unsigned char> lz4_compress(const void *data, uint64_t nbytes, int level) {
+    throw std::runtime_error("lz4 compress(): Bohrium was built without LZ4 support");
+}
+
+void lz4_uncompress(const void *data, uint64_t nbytes, void *dest, uint64_t dest_nbytes) {
+    throw std::runtime_error("lz4 uncompress(): Bohrium was built without LZ4 support");
+}
+
+#endif
@@ -19,6 +19,9 @@ If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <iostream>
+#include <memory>
+#include <deque>
+#include <cstring>
 #include <bh_component.hpp>
 #include <bh_main_memory.hpp>
 #include <bh_util.hpp>
@@ -26,12 +29,30 @@ If not, see <http://www.gnu.org/licenses/>.
 #include "serialize.hpp"
 #include "comm.hpp"
 #include "compression.hpp"
+#include "pipeline.hpp"
+#include "delta.hpp"
 
 using namespace bohrium;
 using namespace component;
 using namespace std;
 
 namespace {
+
+// An EXEC message and the base arrays it sends and frees
+struct ExecJob {
+    vector<char> head;
+    vector<char> body;
+    vector<bh_base> data_send;
+    vector<bh_base> data_free;
+    map<size_t, vector<uint64_t> > shadows; // Index in `data_send` to the page hashes of the backend's copy
+};
+
+// The synced arrays that the backend pushes after an EXEC message
+struct PendingPush {
+    map<bh_base *, bh_base> expected; // The pushed base arrays and a copy without data, which receives the data
+    set<bh_base *> wanted; // The pushed base arrays that are still up-to-date and alive when received
+};
+
 class Impl : public ComponentVE {
 private:
     Compression compressor;
@@ -39,31 +60,111 @@ private:
     std::set<bh_base *> known_base_arrays;
     string compress_param;
 
+    // Delta transfer: when the host gets the data of a base array (nullify), the backend keeps its copy and we keep
+    // the page hashes of the copy (the shadow). When the base array is sent again, only the changed pages are sent.
+    bool delta_transfer;
+    double delta_max_dirty;
+    std::map<bh_base *, vector<uint64_t> > shadows;
+
+    // The backend pushes the synced arrays after each EXEC message, which we receive before reading any other reply.
+    // Arrays that are pushed after the latest EXEC message are up-to-date, thus `getMemoryPointer()` returns them
+    // without asking the backend.
+    bool push_syncs;
+    std::deque<PendingPush> pending_pushes;
+    std::set<bh_base *> pushed;
+
     bool stat_print_on_exit;
     std::chrono::duration<double> time_mem_copy_total{0};
     std::chrono::duration<double> time_mem_copy_unzip{0};
     uint64_t nbytes_recv{0};
+    uint64_t num_pushed{0};
+
+    // The EXEC messages in flight, which are sent by the pipeline's worker thread.
+    // NB: declared last since it must be destroyed (i.e. drained) before the other members
+    Pipeline pipeline;
 
 public:
     Impl(int stack_level) : ComponentVE(stack_level, false),
+                            compressor(config.defaultGet<uint64_t>("compress_chunk_size", 1024 * 1024),
+                                       config.defaultGet<unsigned int>("compress_threads", 0),
+                                       config.defaultGet<double>("link_bandwidth", 1.25e9)),
                             comm_front(stack_level,
                                        config.defaultGet<string>("address", "127.0.0.1"),
                                        config.defaultGet<int>("port", 4200),
-                                       config.defaultGet<uint64_t>("delay", 0)),
+                                       LinkEmulator(config.defaultGet<double>("emulate_bandwidth", 0),
+                                                    config.defaultGet<double>("emulate_latency", 0),
+                                                    config.defaultGet<double>("emulate_jitter", 0)),
+                                       config.defaultGet("push_syncs", true)),
                             compress_param(config.defaultGet<string>("compress_param", "zlib")),
-                            stat_print_on_exit(config.defaultGet("prof", false)) {}
+                            delta_transfer(config.defaultGet("delta_transfer", false) and
+                                           not comm_front.single_copy()),
+                            delta_max_dirty(config.defaultGet<double>("delta_max_dirty", 0.5)),
+                            push_syncs(config.defaultGet("push_syncs", true)),
+                            stat_print_on_exit(config.defaultGet("prof", false)),
+                            pipeline(config.defaultGet<uint64_t>("pipeline_depth", 4)) {}
     ~Impl() override {
+        try {
+            pipeline.wait();
+            recvPushes();
+        } catch (const std::exception &e) {
+            cerr << "[PROXY-VEM] " << e.what() << endl;
+        }
         if (stat_print_on_exit) {
             cout << compressor.pprintStats();
             cout << "Frontend:\n";
             cout << "  MemCopy: " << time_mem_copy_total.count() << "s" << endl;
             cout << "    UnZip: " << time_mem_copy_unzip.count() << "s" << endl;
             cout << "    Recv:  " << nbytes_recv / 1024.0 / 1024.0 << "MB" << endl;
+            cout << "  Pushed:  " << num_pushed << " arrays" << endl;
         }
     }
 
     void execute(BhIR *bhir) override;
 
+    // Receive the synced arrays that the backend has pushed. NB: the pipeline must be drained
+    void recvPushes() {
+        while (not pending_pushes.empty()) {
+            const PendingPush push = std::move(pending_pushes.front());
+            pending_pushes.pop_front();
+            const vector<unsigned char> ids = comm_front.recv_data();
+            for (size_t i = 0; i < ids.size() / sizeof(uint64_t); ++i) {
+                uint64_t id;
+                memcpy(&id, &ids[i * sizeof(uint64_t)], sizeof(uint64_t));
+                bh_base *base = reinterpret_cast<bh_base *>(id);
+                auto expected = push.expected.find(base);
+                if (expected == push.expected.end()) {
+                    throw runtime_error("[PROXY-VEM] the backend pushed an unexpected array");
+                }
+                // We receive into a copy since the bridge might have deleted the base array already
+                bh_base data = expected->second;
+                bool received;
+                if (comm_front.single_copy()) {
+                    received = comm_front.recv_memfd(data);
+                } else {
+                    const uint64_t nbytes = comm_front.recv_data_size();
+                    if (nbytes > 0) {
+                        auto read = [this](void *dest, uint64_t n) { comm_front.recv_data_bytes(dest, n); };
+                        compressor.uncompress(nbytes, read, data, compress_param);
+                        nbytes_recv += nbytes;
+                    }
+                    received = nbytes > 0;
+                }
+                if (received and util::exist(push.wanted, base)) {
+                    if (base->getDataPtr() == nullptr) {
+                        base->resetDataPtr(data.getDataPtr());
+                    } else { // The host might hold on to the current data pointer
+                        memcpy(base->getDataPtr(), data.getDataPtr(), static_cast<size_t>(base->nbytes()));
+                        bh_data_free(&data);
+                    }
+                    pushed.insert(base);
+                    ++num_pushed;
+                } else if (received) {
+                    bh_data_free(&data);
+                }
+            }
+        }
+    }
+
     void extmethod(const string &name, bh_opcode opcode) override {
         // ExtmethodFace does not have a default or copy constructor thus
         // we have to use its move constructor.
@@ -72,6 +173,9 @@ public:
 
     // Handle messages from parent
     string message(const string &msg) override {
+        pipeline.wait();
+        recvPushes();
+
         // Serialize message body
         vector<char> buf_body;
         msg::Message body(msg);
@@ -107,10 +211,44 @@ public:
         if (not copy2host) {
             throw runtime_error("PROXY - getMemoryPointer(): `copy2host` is not True");
         }
+        pipeline.wait();
+        recvPushes();
+
+        // The backend pushed the data already, thus we only have to tell it to forget the base array on nullify
+        if (pushed.erase(&base) > 0) {
+            if (nullify) {
+                vector<char> buf_body;
+                msg::Discard body({&base});
+                body.serialize(buf_body);
+                vector<char> buf_head;
+                msg::Header head(msg::Type::DISCARD, buf_body.size());
+                head.serialize(buf_head);
+                comm_front.write(buf_head);
+                comm_front.write(buf_body);
+                if (delta_transfer) { // The backend keeps its copy of the data
+                    shadows[&base] = delta_page_hashes(base.getDataPtr(), static_cast<uint64_t>(base.nbytes()));
+                }
+            }
+            if (force_alloc) {
+                bh_data_malloc(&base);
+            }
+            void *ret = base.getDataPtr();
+            if (nullify) {
+                base.resetDataPtr();
+                known_base_arrays.erase(&base);
+            }
+            return ret;
+        }
+
+        // When we already hold a copy of the data, the backend only sends the pages that differ
+        vector<uint64_t> page_hashes;
+        if (delta_transfer and base.getDataPtr() != nullptr) {
+            page_hashes = delta_page_hashes(base.getDataPtr(), static_cast<uint64_t>(base.nbytes()));
+        }
 
         // Serialize message body
         vector<char> buf_body;
-        msg::GetData body(&base, nullify);
+        msg::GetData body(&base, nullify, page_hashes);
         body.serialize(buf_body);
 
         // Serialize message head
@@ -123,10 +261,26 @@ public:
         comm_front.write(buf_body);
 
         // Receive the array data
-        vector<unsigned char> data = comm_front.recv_data();
-        if (not data.empty()) {
-            bh_data_malloc(&base);
-            compressor.uncompress(data, base, compress_param);
+        bool received;
+        if (comm_front.single_copy()) {
+            received = comm_front.recv_memfd(base);
+        } else if (not page_hashes.empty() and comm_front.recv_data().at(0) != 0) {
+            const vector<unsigned char> patch = compressor.uncompress(comm_front.recv_data(), compress_param);
+            delta_apply_patch(patch, base.getDataPtr(), static_cast<uint64_t>(base.nbytes()));
+            received = true;
+        } else {
+            // Uncompress the data while receiving it
+            const uint64_t nbytes = comm_front.recv_data_size();
+            if (nbytes > 0) {
+                auto read = [this](void *dest, uint64_t n) { comm_front.recv_data_bytes(dest, n); };
+                compressor.uncompress(nbytes, read, base, compress_param);
+            }
+            received = nbytes > 0;
+        }
+
+        // The backend keeps its copy of the data that the host gets
+        if (delta_transfer and nullify and received) {
+            shadows[&base] = delta_page_hashes(base.getDataPtr(), static_cast<uint64_t>(base.nbytes()));
         }
 
         if (force_alloc) {
@@ -161,6 +315,8 @@ public:
         if (util::exist(known_base_arrays, dst.base) or dst.base->getDataPtr() != nullptr) {
             throw runtime_error("PROXY - memCopy(): `dst` must be un-initiated");
         }
+        pipeline.wait();
+        recvPushes();
 
         auto t1 = chrono::steady_clock::now();
 
@@ -178,14 +334,15 @@ public:
         comm_front.write(buf_head);
         comm_front.write(buf_body);
 
-        // Receive the array data
-        vector<unsigned char> data = comm_front.recv_data();
-        if (not data.empty()) {
+        // Receive the array data, which is uncompressed while receiving it
+        const uint64_t nbytes = comm_front.recv_data_size();
+        if (nbytes > 0) {
             bh_data_malloc(dst.base);
             auto t2 = chrono::steady_clock::now();
-            compressor.uncompress(data, dst, param);
+            auto read = [this](void *dest, uint64_t n) { comm_front.recv_data_bytes(dest, n); };
+            compressor.uncompress(nbytes, read, *dst.base, param);
             time_mem_copy_unzip += chrono::steady_clock::now() - t2;
-            nbytes_recv += data.size();
+            nbytes_recv += nbytes;
         }
         time_mem_copy_total += chrono::steady_clock::now() - t1;
     }
@@ -236,29 +393,94 @@ void Impl::execute(BhIR *bhir) {
 
     // Serialize the BhIR, which becomes the message body
     vector<bh_base *> new_data; // New data in the order they appear in the instruction list
-    vector<char> buf_body = bhir->writeSerializedArchive(known_base_arrays, new_data);
+    auto job = make_shared<ExecJob>();
+    job->body = bhir->writeSerializedArchive(known_base_arrays, new_data);
 
     // Serialize message head
-    vector<char> buf_head;
-    msg::Header head(msg::Type::EXEC, buf_body.size());
-    head.serialize(buf_head);
-
-    // Send serialized message (head and body)
-    comm_front.write(buf_head);
-    comm_front.write(buf_body);
+    msg::Header head(msg::Type::EXEC, job->body.size());
+    head.serialize(job->head);
 
-    // Send array data
+    // The bridge might delete the base arrays as soon as we return, thus the job gets copies of the bases
     for (bh_base *base: new_data) {
         assert(base->getDataPtr() != nullptr);
-        auto data = compressor.compress(*base, compress_param);
-        comm_front.send_data(data);
+        auto shadow = shadows.find(base);
+        if (shadow != shadows.end()) {
+            job->shadows[job->data_send.size()] = std::move(shadow->second);
+        }
+        job->data_send.push_back(*base);
+    }
+
+    // The backend drops its copy of base arrays that becomes known again (as we do with the shadows)
+    for (auto it = shadows.begin(); it != shadows.end();) {
+        if (util::exist(known_base_arrays, it->first)) {
+            it = shadows.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // This EXEC message might change the arrays that the backend has pushed, thus only its own pushes are wanted
+    pushed.clear();
+    for (PendingPush &p: pending_pushes) {
+        p.wanted.clear();
+    }
+    if (push_syncs) {
+        PendingPush push;
+        for (bh_base *base: bhir->getSyncs()) {
+            if (util::exist(known_base_arrays, base)) { // The backend ignores unknown syncs
+                bh_base copy(*base);
+                copy.resetDataPtr();
+                push.expected.insert(make_pair(base, copy));
+                push.wanted.insert(base);
+            }
+        }
+        if (not push.expected.empty()) {
+            pending_pushes.push_back(std::move(push));
+        }
     }
 
-    // Cleanup freed base array and make them unknown.
+    // Make freed base arrays unknown. Their data is freed by the job after it has been sent.
     for (const bh_instruction &instr: bhir->instr_list) {
         if (instr.opcode == BH_FREE) {
-            bh_data_free(instr.operand[0].base);
-            known_base_arrays.erase(instr.operand[0].base);
+            bh_base *base = instr.operand[0].base;
+            if (not pending_pushes.empty()) {
+                pending_pushes.back().wanted.erase(base);
+            }
+            if (base->getDataPtr() != nullptr) {
+                job->data_free.push_back(*base);
+                base->resetDataPtr();
+            }
+            known_base_arrays.erase(base);
         }
     }
+
+    // Send serialized message (head and body) followed by the array data, which returns as soon as the job is queued
+    pipeline.push([this, job]() {
+        comm_front.write(job->head);
+        comm_front.write(job->body);
+        for (size_t i = 0; i < job->data_send.size(); ++i) {
+            const bh_base &base = job->data_send[i];
+            if (comm_front.single_copy()) {
+                comm_front.send_memfd(base);
+                continue;
+            }
+            // Base arrays with a shadow are sent as a patch of the changed pages when few pages changed
+            auto shadow = job->shadows.find(i);
+            if (shadow != job->shadows.end()) {
+                vector<unsigned char> patch;
+                const bool use_patch = delta_make_patch(base.getDataPtr(), static_cast<uint64_t>(base.nbytes()),
+                                                        shadow->second, delta_max_dirty, patch);
+                comm_front.send_data({static_cast<unsigned char>(use_patch)});
+                if (use_patch) {
+                    comm_front.send_data(compressor.compress(patch, compress_param));
+                    continue;
+                }
+            }
+            auto data = compressor.compress(base, compress_param);
+            comm_front.send_data(data);
+        }
+        for (bh_base &base: job->data_free) {
+            bh_data_free(&base);
+        }
+    });
 }
@@ -0,0 +1,100 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pipeline.hpp"
+
+using namespace std;
+
+Pipeline::Pipeline(size_t max_jobs) : _max_jobs(max_jobs) {
+    if (_max_jobs > 0) {
+        _worker = thread(&Pipeline::work, this);
+    }
+}
+
+Pipeline::~Pipeline() {
+    if (_worker.joinable()) {
+        {
+            unique_lock<mutex> lock(_mutex);
+            _cond.wait(lock, [this] { return _jobs.empty() and not _busy; });
+            _stop = true;
+        }
+        _cond.notify_all();
+        _worker.join();
+    }
+}
+
+void Pipeline::work() {
+    unique_lock<mutex> lock(_mutex);
+    while (true) {
+        _cond.wait(lock, [this] { return _stop or not _jobs.empty(); });
+        if (_jobs.empty()) {
+            return; // `_stop` is set and all jobs are done
+        }
+        function<void()> job = std::move(_jobs.front());
+        _jobs.pop_front();
+        _busy = true;
+        const bool failed = static_cast<bool>(_error);
+        lock.unlock();
+        _cond.notify_all(); // Wake up a `push()` waiting for room in the queue
+        try {
+            if (not failed) { // After a failure, we skip the remaining jobs
+                job();
+            }
+        } catch (...) {
+            lock.lock();
+            _error = current_exception();
+            lock.unlock();
+        }
+        lock.lock();
+        _busy = false;
+        _cond.notify_all();
+    }
+}
+
+void Pipeline::rethrow() {
+    if (_error) {
+        exception_ptr e = _error;
+        _error = nullptr;
+        rethrow_exception(e);
+    }
+}
+
+void Pipeline::push(function<void()> job) {
+    if (_max_jobs == 0) {
+        job();
+        return;
+    }
+    {
+        unique_lock<mutex> lock(_mutex);
+        _cond.wait(lock, [this] { return _jobs.size() < _max_jobs or _error; });
+        rethrow();
+        _jobs.push_back(std::move(job));
+    }
+    _cond.notify_all();
+}
+
+void Pipeline::wait() {
+    if (_max_jobs == 0) {
+        return;
+    }
+    unique_lock<mutex> lock(_mutex);
+    _cond.wait(lock, [this] { return _jobs.empty() and not _busy; });
+    rethrow();
+}
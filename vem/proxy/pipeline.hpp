@@ -0,0 +1,69 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+/** A bounded queue of jobs that a worker thread runs in order.
+ * `push()` returns as soon as the job is queued, thus the caller and the worker overlap.
+ * An exception thrown by a job is re-thrown by the next call to `push()` or `wait()`.
+ */
+class Pipeline {
+private:
+    std::deque<std::function<void()> > _jobs;
+    const size_t _max_jobs;
+    bool _busy = false; // True while the worker runs a job
+    bool _stop = false;
+    std::exception_ptr _error;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::thread _worker;
+
+    /// The loop of the worker thread
+    void work();
+
+    /// Re-throw the exception of a failed job (if any). NB: the caller must hold the lock of `_mutex`
+    void rethrow();
+
+public:
+    /** Create a new pipeline
+     *
+     * @param max_jobs The maximum number of jobs in the queue before `push()` blocks. When zero, `push()` runs
+     *                 the job directly thus there are no worker thread
+     */
+    explicit Pipeline(size_t max_jobs);
+
+    /// Waits for the queued jobs to finish
+    ~Pipeline();
+
+    Pipeline(const Pipeline &) = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    /// Queue `job`, which blocks while the queue is full
+    void push(std::function<void()> job);
+
+    /// Wait for all queued jobs to finish
+    void wait();
+};
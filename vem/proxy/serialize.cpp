@@ -23,6 +23,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <set>
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/set.hpp>
+#include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/iostreams/stream_buffer.hpp>
@@ -69,6 +70,7 @@ Init::Init(const std::vector<char> &buffer) {
 
     // Deserialize the component name
     ia >> this->stack_level;
+    ia >> this->push_syncs;
 }
 
 void Init::serialize(std::vector<char> &buffer) {
@@ -78,6 +80,7 @@ void Init::serialize(std::vector<char> &buffer) {
 
     //Serialize the component name
     oa << this->stack_level;
+    oa << this->push_syncs;
 }
 
 GetData::GetData(const std::vector<char> &buffer) {
@@ -90,6 +93,7 @@ GetData::GetData(const std::vector<char> &buffer) {
     ia >> b;
     this->base = reinterpret_cast<bh_base *>(b);
     ia >> this->nullify;
+    ia >> this->page_hashes;
 }
 
 void GetData::serialize(std::vector<char> &buffer) {
@@ -100,6 +104,32 @@ void GetData::serialize(std::vector<char> &buffer) {
     size_t b = reinterpret_cast<size_t>(this->base);
     oa << b;
     oa << this->nullify;
+    oa << this->page_hashes;
+}
+
+Discard::Discard(const std::vector<char> &buffer) {
+    // Wrap 'buffer' in an input stream
+    iostreams::basic_array_source<char> source(&buffer[0], buffer.size());
+    iostreams::stream<iostreams::basic_array_source<char> > input_stream(source);
+    archive::binary_iarchive ia(input_stream);
+
+    vector<size_t> bases;
+    ia >> bases;
+    for (size_t b: bases) {
+        this->bases.push_back(reinterpret_cast<bh_base *>(b));
+    }
+}
+
+void Discard::serialize(std::vector<char> &buffer) {
+    // Wrap 'buffer' in an output stream
+    iostreams::stream<iostreams::back_insert_device<vector<char> > > output_stream(buffer);
+    archive::binary_oarchive oa(output_stream);
+
+    vector<size_t> bases;
+    for (bh_base *b: this->bases) {
+        bases.push_back(reinterpret_cast<size_t>(b));
+    }
+    oa << bases;
 }
 
 MemCopy::MemCopy(const std::vector<char> &buffer) {
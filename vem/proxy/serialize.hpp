@@ -39,7 +39,8 @@ enum class Type {
     EXEC,
     GET_DATA,
     MEM_COPY,
-    MSG
+    MSG,
+    DISCARD
 };
 
 /** Message Header */
@@ -62,9 +63,10 @@ constexpr size_t HeaderSize = sizeof(Type) + sizeof(size_t);
 /** RPC: the constructor (the first message send to initiate the backend) */
 struct Init {
     int stack_level;// Stack level of the component
+    bool push_syncs;// The backend pushes the synced arrays after each EXEC message
 
     /** The regular constructor */
-    Init(int stack_level) : stack_level(stack_level) {}
+    Init(int stack_level, bool push_syncs) : stack_level(stack_level), push_syncs(push_syncs) {}
 
     /** The de-serializing constructor */
     explicit Init(const std::vector<char> &buffer);
@@ -77,9 +79,13 @@ struct Init {
 struct GetData {
     bh_base *base;
     bool nullify;
+    // The page hashes of the data that the frontend already holds, which makes the backend reply with a delta
+    // (see delta.hpp). Empty when the frontend wants all of the data.
+    std::vector<uint64_t> page_hashes;
 
     /** The regular constructor */
-    GetData(bh_base *base, bool nullify) : base(base), nullify(nullify) {}
+    GetData(bh_base *base, bool nullify, std::vector<uint64_t> page_hashes = {}) :
+            base(base), nullify(nullify), page_hashes(std::move(page_hashes)) {}
 
     /** The de-serializing constructor */
     explicit GetData(const std::vector<char> &buffer);
@@ -88,6 +94,21 @@ struct GetData {
     void serialize(std::vector<char> &buffer);
 };
 
+/** The frontend's host got the data of `bases`, which the backend pushed, thus the backend must forget them just
+ *  like `GetData` with `nullify`. There is no reply. */
+struct Discard {
+    std::vector<bh_base *> bases;
+
+    /** The regular constructor */
+    explicit Discard(std::vector<bh_base *> bases) : bases(std::move(bases)) {}
+
+    /** The de-serializing constructor */
+    explicit Discard(const std::vector<char> &buffer);
+
+    /** Serialize to `buffer` */
+    void serialize(std::vector<char> &buffer);
+};
+
 /** RPC: `memCopy()` */
 struct MemCopy {
     bh_view src;
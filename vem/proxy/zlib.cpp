@@ -24,10 +24,10 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <cassert>
 #include "zlib.hpp"
 
-std::vector<unsigned char> zlib_compress(void *data, uint64_t nbytes) {
+std::vector<unsigned char> zlib_compress(const void *data, uint64_t nbytes, int level) {
     uLongf compressed_size = compressBound(nbytes);
     std::vector<unsigned char> ret(compressed_size);
-    int err = compress(&ret[0], &compressed_size, (Bytef *) data, nbytes);
+    int err = compress2(&ret[0], &compressed_size, (const Bytef *) data, nbytes, level);
     if (err != Z_OK) {
         throw std::runtime_error("zlib compress(): failed");
     }
@@ -35,11 +35,11 @@ std::vector<unsigned char> zlib_compress(void *data, uint64_t nbytes) {
     return ret;
 }
 
-void zlib_uncompress(const std::vector<unsigned char> &data, void *dest, uint64_t dest_nbytes) {
+void zlib_uncompress(const void *data, uint64_t nbytes, void *dest, uint64_t dest_nbytes) {
     uLongf uncompressed_size = dest_nbytes;
-    int err = uncompress((Bytef *) dest, &uncompressed_size, (Bytef *) (&data[0]), data.size());
+    int err = uncompress((Bytef *) dest, &uncompressed_size, (const Bytef *) data, nbytes);
     if (err != Z_OK) {
         throw std::runtime_error("zlib uncompress(): failed");
     }
     assert(dest_nbytes == uncompressed_size);
-}
\ No newline at end of file
+}
@@ -26,14 +26,16 @@ If not, see <http://www.gnu.org/licenses/>.
  *
  * @param data    The data to compress
  * @param nbytes  The number of bytes in data
+ * @param level   The compression level (-1 is the zlib default)
  * @return        The compressed data
  */
-std::vector<unsigned char> zlib_compress(void *data, uint64_t nbytes);
+std::vector<unsigned char> zlib_compress(const void *data, uint64_t nbytes, int level = -1);
 
 /** zlib wrapper - uncompress `data`
   *
   * @param data         The compressed data
+  * @param nbytes       The number of bytes in the compressed data
   * @param dest         The destination, which must be large enough for the uncompressed data
   * @param dest_nbytes  The size of the destination buffer
   */
-void zlib_uncompress(const std::vector<unsigned char> &data, void *dest, uint64_t dest_nbytes);
\ No newline at end of file
+void zlib_uncompress(const void *data, uint64_t nbytes, void *dest, uint64_t dest_nbytes);
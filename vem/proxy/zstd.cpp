@@ -0,0 +1,66 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#ifdef BH_PROXY_WITH_ZSTD
+#include <zstd.h>
+#endif
+#include "zstd.hpp"
+
+#ifdef BH_PROXY_WITH_ZSTD
+
+bool zstd_available() {
+    return true;
+}
+
+std::vector<unsigned char> zstd_compress(const void *data, uint64_t nbytes, int level) {
+    std::vector<unsigned char> ret(ZSTD_compressBound(nbytes));
+    const size_t size = ZSTD_compress(&ret[0], ret.size(), data, nbytes, level);
+    if (ZSTD_isError(size)) {
+        throw std::runtime_error(std::string("zstd compress(): ") + ZSTD_getErrorName(size));
+    }
+    ret.resize(size);
+    return ret;
+}
+
+void zstd_uncompress(const void *data, uint64_t nbytes, void *dest, uint64_t dest_nbytes) {
+    const size_t size = ZSTD_decompress(dest, dest_nbytes, data, nbytes);
+    if (ZSTD_isError(size) or size != dest_nbytes) {
+        throw std::runtime_error("zstd uncompress(): failed");
+    }
+}
+
+#else
+
+bool zstd_available() {
+    return false;
+}
+
+std::vector<unsigned char> zstd_compress(const void *data, uint64_t nbytes, int level) {
+    throw std::runtime_error("zstd compress(): Bohrium was built without Zstandard support");
+}
+
+void zstd_uncompress(const void *data, uint64_t nbytes, void *dest, uint64_t dest_nbytes) {
+    throw std::runtime_error("zstd uncompress(): Bohrium was built without Zstandard support");
+}
+
+#endif